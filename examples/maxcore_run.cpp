@@ -0,0 +1,674 @@
+// ==============================
+// File: examples/maxcore_run.cpp
+// ==============================
+// Streaming driver: steps a population of cores over a raw binary delta stream
+// and writes the non-NORMAL events (and optionally the full trajectory) in binary.
+//
+// Usage:
+//   maxcore_run [--events PATH|-] [--trajectory PATH] [--block-rows N] [INPUT|-]
+//   maxcore_run --demo-input PATH [ticks=1000] [entities=64]
+//
+// INPUT is a delta stream file (mapped into memory), a named pipe, or "-" /
+// omitted for stdin. Pipes and stdin are read by a second thread into two
+// alternating buffers, so reading the next block overlaps stepping the current one.
+//
+// Delta stream (little-endian, 8-byte fields):
+//   header (160 bytes): magic "MAXCDLTA" | endian tag 0x0102030405060708 |
+//     version | params (8 doubles) | dt | delta_dim | entities |
+//     genesis phi, memory, kappa | delta_max (NaN = no norm guard) | reserved (2 words, 0)
+//   body: one row per tick, entities * delta_dim doubles, entity-major
+//     (entity i reads its delta_dim values at offset i * delta_dim).
+//
+// Events file (little-endian): header (32 bytes): magic "MAXCEVNT" | endian tag |
+//   version | record bytes (56); then one record per COLLAPSE / ERROR:
+//   entity | tick | step_counter | event (1 byte, 7 bytes 0) | phi | memory | kappa
+//
+// The trajectory file is the columnar TrajectoryFileWriter format, one row per
+// entity per tick, with lifecycle id = entity index.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+  #include <fcntl.h>
+  #include <io.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "maxcore/batch.h"
+#include "maxcore/trajectory_file.h"
+
+namespace {
+
+using namespace maxcore;
+
+constexpr char kStreamMagic[8] = {'M', 'A', 'X', 'C', 'D', 'L', 'T', 'A'};
+constexpr char kEventMagic[8] = {'M', 'A', 'X', 'C', 'E', 'V', 'N', 'T'};
+constexpr uint64_t kEndianTag = 0x0102030405060708ull;
+constexpr uint64_t kStreamVersion = 1;
+constexpr uint64_t kEventVersion = 1;
+constexpr size_t kEventRecordBytes = 56;
+
+enum HeaderWord : size_t {
+    H_MAGIC = 0,
+    H_ENDIAN = 1,
+    H_VERSION = 2,
+    H_PARAMS = 3,  // 8 words
+    H_DT = 11,
+    H_DELTA_DIM = 12,
+    H_ENTITIES = 13,
+    H_GENESIS = 14,  // 3 words
+    H_DELTA_MAX = 17,
+    H_WORDS = 20
+};
+
+constexpr size_t kHeaderBytes = H_WORDS * 8u;
+
+struct FileCloser {
+    void operator()(std::FILE* f) const noexcept {
+        if (f != nullptr) std::fclose(f);
+    }
+};
+
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+#if !defined(_WIN32)
+// Closes the descriptor on every exit path.
+struct FdGuard {
+    int fd = -1;
+
+    ~FdGuard() { Close(); }
+
+    void Close() noexcept {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+};
+#endif
+
+struct StreamHeader {
+    ParameterSet params;
+    double dt;
+    size_t delta_dim;
+    size_t entities;
+    StructuralState genesis;
+    std::optional<double> delta_max;
+};
+
+void encode_header(const StreamHeader& h, uint8_t* out) {
+    uint64_t words[H_WORDS] = {};
+    std::memcpy(&words[H_MAGIC], kStreamMagic, sizeof(kStreamMagic));
+    words[H_ENDIAN] = kEndianTag;
+    words[H_VERSION] = kStreamVersion;
+
+    const double p[8] = {
+        h.params.alpha, h.params.eta, h.params.beta, h.params.gamma,
+        h.params.rho, h.params.lambda_phi, h.params.lambda_m, h.params.kappa_max
+    };
+    std::memcpy(&words[H_PARAMS], p, sizeof(p));
+    std::memcpy(&words[H_DT], &h.dt, sizeof(double));
+    words[H_DELTA_DIM] = static_cast<uint64_t>(h.delta_dim);
+    words[H_ENTITIES] = static_cast<uint64_t>(h.entities);
+
+    const double g[3] = {h.genesis.phi, h.genesis.memory, h.genesis.kappa};
+    std::memcpy(&words[H_GENESIS], g, sizeof(g));
+    const double dm = h.delta_max ? *h.delta_max : std::numeric_limits<double>::quiet_NaN();
+    std::memcpy(&words[H_DELTA_MAX], &dm, sizeof(double));
+
+    std::memcpy(out, words, sizeof(words));
+}
+
+// Structural checks only; parameter and state validation is left to MaxCoreBatch::Create.
+bool decode_header(const uint8_t* in, StreamHeader& h, std::string& err) {
+    uint64_t words[H_WORDS];
+    std::memcpy(words, in, sizeof(words));
+
+    if (std::memcmp(&words[H_MAGIC], kStreamMagic, sizeof(kStreamMagic)) != 0) {
+        err = "not a delta stream (bad magic)";
+        return false;
+    }
+    if (words[H_ENDIAN] != kEndianTag) {
+        err = "foreign byte order (stream must be little-endian)";
+        return false;
+    }
+    if (words[H_VERSION] != kStreamVersion) {
+        err = "unsupported stream version";
+        return false;
+    }
+
+    double p[8];
+    std::memcpy(p, &words[H_PARAMS], sizeof(p));
+    h.params = ParameterSet{p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]};
+    std::memcpy(&h.dt, &words[H_DT], sizeof(double));
+
+    const uint64_t dim = words[H_DELTA_DIM];
+    const uint64_t n = words[H_ENTITIES];
+    if (dim == 0 || n == 0 || dim > (uint64_t{1} << 20) || n > (uint64_t{1} << 32) ||
+        dim * n > (uint64_t{1} << 32)) {
+        err = "delta_dim / entities out of range";
+        return false;
+    }
+    h.delta_dim = static_cast<size_t>(dim);
+    h.entities = static_cast<size_t>(n);
+
+    double g[3];
+    std::memcpy(g, &words[H_GENESIS], sizeof(g));
+    h.genesis = StructuralState{g[0], g[1], g[2]};
+
+    double dm = 0.0;
+    std::memcpy(&dm, &words[H_DELTA_MAX], sizeof(double));
+    h.delta_max = std::isnan(dm) ? std::nullopt : std::optional<double>(dm);
+    return true;
+}
+
+// Source of tick rows, handed out in blocks. Next() returns false at the end of
+// the stream; Failed() then tells a clean end from a read error / truncated row.
+class RowSource {
+public:
+    virtual ~RowSource() = default;
+    virtual bool Next(const double*& rows, size_t& count) = 0;
+    virtual bool Failed() const noexcept = 0;
+};
+
+#if !defined(_WIN32)
+// Regular file: the body is read in place from the mapping; the pages of the
+// following block are requested ahead while the current one is stepped.
+class MappedSource final : public RowSource {
+public:
+    static std::unique_ptr<MappedSource> Open(int fd, size_t file_size, size_t row_doubles, size_t block_rows) {
+        void* view = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) return nullptr;
+        ::madvise(view, file_size, MADV_SEQUENTIAL);
+        return std::unique_ptr<MappedSource>(
+            new MappedSource(static_cast<const uint8_t*>(view), file_size, row_doubles, block_rows));
+    }
+
+    ~MappedSource() override { ::munmap(const_cast<uint8_t*>(data_), size_); }
+
+    bool Next(const double*& rows, size_t& count) override {
+        if (next_ >= rows_) return false;
+        count = std::min(block_rows_, rows_ - next_);
+        rows = body_ + next_ * row_doubles_;
+        next_ += count;
+
+        if (next_ < rows_) {
+            const size_t ahead = std::min(block_rows_, rows_ - next_);
+            const uintptr_t page = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+            const uintptr_t from = reinterpret_cast<uintptr_t>(body_ + next_ * row_doubles_) & ~(page - 1u);
+            const uintptr_t to = reinterpret_cast<uintptr_t>(body_ + (next_ + ahead) * row_doubles_);
+            ::madvise(reinterpret_cast<void*>(from), static_cast<size_t>(to - from), MADV_WILLNEED);
+        }
+        return true;
+    }
+
+    bool Failed() const noexcept override { return truncated_; }
+
+private:
+    MappedSource(const uint8_t* data, size_t size, size_t row_doubles, size_t block_rows)
+        : data_(data),
+          size_(size),
+          body_(reinterpret_cast<const double*>(data + kHeaderBytes)),
+          row_doubles_(row_doubles),
+          block_rows_(block_rows) {
+        const size_t row_bytes = row_doubles * sizeof(double);
+        const size_t body_bytes = size - kHeaderBytes;
+        rows_ = body_bytes / row_bytes;
+        truncated_ = (body_bytes % row_bytes) != 0;
+    }
+
+    const uint8_t* data_;
+    size_t size_;
+    const double* body_;
+    size_t row_doubles_;
+    size_t block_rows_;
+    size_t rows_ = 0;
+    size_t next_ = 0;
+    bool truncated_ = false;
+};
+#endif
+
+// Pipe / stdin (or any file on Windows): a reader thread fills one buffer while
+// the caller steps the other. The thread shares ownership of the state (and of
+// the input file), so the source can be dropped while it is blocked in fread.
+class StreamSource final : public RowSource {
+public:
+    // `owned` is the input to close when done (null for stdin); `in` is read.
+    StreamSource(std::FILE* in, FilePtr owned, size_t row_doubles, size_t block_rows)
+        : state_(std::make_shared<State>()) {
+        state_->in = in;
+        state_->owned = std::move(owned);
+        state_->row_doubles = row_doubles;
+        state_->block_rows = block_rows;
+        for (Buffer& b : state_->buffers) b.data.resize(row_doubles * block_rows);
+
+        std::shared_ptr<State> s = state_;
+        reader_ = std::thread([s]() { ReadLoop(*s); });
+    }
+
+    ~StreamSource() override {
+        bool reading = false;
+        {
+            std::lock_guard<std::mutex> lock(state_->m);
+            state_->stop = true;
+            reading = state_->reading;
+        }
+        state_->cv.notify_all();
+        // An early exit must not wait on a stalled pipe: a reader inside fread
+        // is left to finish on its own and sees `stop` afterwards.
+        if (reading) {
+            reader_.detach();
+        } else {
+            reader_.join();
+        }
+    }
+
+    bool Next(const double*& rows, size_t& count) override {
+        State& s = *state_;
+        std::unique_lock<std::mutex> lock(s.m);
+        if (s.held) {
+            // The caller is done with the block handed out last time.
+            s.buffers[s.cur].full = false;
+            s.cur ^= 1u;
+            s.held = false;
+            s.cv.notify_all();
+        }
+        s.cv.wait(lock, [&s]() { return s.buffers[s.cur].full || s.done; });
+        if (!s.buffers[s.cur].full) return false;
+
+        rows = s.buffers[s.cur].data.data();
+        count = s.buffers[s.cur].rows;
+        s.held = true;
+        return true;
+    }
+
+    bool Failed() const noexcept override {
+        std::lock_guard<std::mutex> lock(state_->m);
+        return state_->failed;
+    }
+
+private:
+    struct Buffer {
+        std::vector<double> data;
+        size_t rows = 0;
+        bool full = false;
+    };
+
+    struct State {
+        std::FILE* in = nullptr;
+        FilePtr owned;
+        size_t row_doubles = 0;
+        size_t block_rows = 0;
+
+        std::mutex m;
+        std::condition_variable cv;
+        Buffer buffers[2];
+        size_t cur = 0;        // buffer the caller reads next / holds
+        bool held = false;     // caller holds buffers[cur]
+        bool reading = false;  // reader is inside fread
+        bool done = false;
+        bool failed = false;
+        bool stop = false;
+    };
+
+    static void ReadLoop(State& s) {
+        const size_t row_bytes = s.row_doubles * sizeof(double);
+        size_t b = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(s.m);
+                s.cv.wait(lock, [&s, b]() { return !s.buffers[b].full || s.stop; });
+                if (s.stop) return;
+                s.reading = true;
+            }
+
+            // Only this thread touches a buffer that is not full.
+            uint8_t* dst = reinterpret_cast<uint8_t*>(s.buffers[b].data.data());
+            const size_t want = s.block_rows * row_bytes;
+            size_t got = 0;
+            while (got < want) {
+                const size_t n = std::fread(dst + got, 1, want - got, s.in);
+                if (n == 0) break;
+                got += n;
+            }
+            const bool end = got < want;
+
+            std::lock_guard<std::mutex> lock(s.m);
+            s.reading = false;
+            if (s.stop) return;
+            s.buffers[b].rows = got / row_bytes;
+            s.buffers[b].full = s.buffers[b].rows > 0;
+            if (end) {
+                s.failed = std::ferror(s.in) != 0 || (got % row_bytes) != 0;
+                s.done = true;
+                s.cv.notify_all();
+                return;
+            }
+            s.cv.notify_all();
+            b ^= 1u;
+        }
+    }
+
+    std::shared_ptr<State> state_;
+    std::thread reader_;
+};
+
+bool read_exact(std::FILE* in, uint8_t* dst, size_t bytes) {
+    size_t got = 0;
+    while (got < bytes) {
+        const size_t n = std::fread(dst + got, 1, bytes - got, in);
+        if (n == 0) return false;
+        got += n;
+    }
+    return true;
+}
+
+void put_u64(uint8_t* out, uint64_t v) {
+    std::memcpy(out, &v, sizeof(v));
+}
+
+void put_f64(uint8_t* out, double v) {
+    std::memcpy(out, &v, sizeof(v));
+}
+
+bool write_event_header(std::FILE* f) {
+    uint8_t h[32];
+    std::memcpy(h, kEventMagic, sizeof(kEventMagic));
+    put_u64(h + 8, kEndianTag);
+    put_u64(h + 16, kEventVersion);
+    put_u64(h + 24, kEventRecordBytes);
+    return std::fwrite(h, 1, sizeof(h), f) == sizeof(h);
+}
+
+bool write_event(std::FILE* f, uint64_t entity, uint64_t tick, const MaxCoreBatch& batch, EventFlag ev) {
+    const StructuralState s = batch.Current(static_cast<size_t>(entity));
+    uint8_t r[kEventRecordBytes] = {};
+    put_u64(r, entity);
+    put_u64(r + 8, tick);
+    put_u64(r + 16, batch.Lifecycle(static_cast<size_t>(entity)).step_counter);
+    r[24] = static_cast<uint8_t>(ev);
+    put_f64(r + 32, s.phi);
+    put_f64(r + 40, s.memory);
+    put_f64(r + 48, s.kappa);
+    return std::fwrite(r, 1, sizeof(r), f) == sizeof(r);
+}
+
+void set_binary(std::FILE* f) {
+#if defined(_WIN32)
+    _setmode(_fileno(f), _O_BINARY);
+#else
+    (void)f;
+#endif
+}
+
+// Writes a deterministic demo stream (64-bit LCG inputs, the pipeline's parameters).
+int write_demo(const std::string& path, size_t ticks, size_t entities) {
+    StreamHeader h{};
+    h.params = ParameterSet{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    h.dt = 0.01;
+    h.delta_dim = 4;
+    h.entities = entities;
+    h.genesis = StructuralState{0.0, 0.0, h.params.kappa_max};
+    h.delta_max = std::nullopt;
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        std::cerr << "cannot open " << path << "\n";
+        return 1;
+    }
+
+    uint8_t header[kHeaderBytes];
+    encode_header(h, header);
+    bool ok = std::fwrite(header, 1, sizeof(header), f) == sizeof(header);
+
+    uint64_t s = 0x2545F4914F6CDD1Dull;
+    std::vector<double> row(entities * h.delta_dim);
+    for (size_t t = 0; t < ticks && ok; ++t) {
+        for (double& v : row) {
+            s = s * 6364136223846793005ull + 1442695040888963407ull;
+            v = static_cast<double>(s >> 11) * (1.0 / 9007199254740992.0);
+        }
+        ok = std::fwrite(row.data(), sizeof(double), row.size(), f) == row.size();
+    }
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) {
+        std::cerr << "write failed: " << path << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+void usage() {
+    std::cerr << "usage: maxcore_run [--events PATH|-] [--trajectory PATH] [--block-rows N] [INPUT|-]\n"
+                 "       maxcore_run --demo-input PATH [ticks=1000] [entities=64]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string input = "-";
+    std::string events_path;
+    std::string traj_path;
+    size_t block_rows = 0;  // 0: about 1 MiB per block
+
+    if (argc >= 2 && std::string(argv[1]) == "--demo-input") {
+        if (argc < 3) {
+            usage();
+            return 1;
+        }
+        const size_t ticks = (argc >= 4) ? static_cast<size_t>(std::strtoull(argv[3], nullptr, 10)) : 1000u;
+        const size_t entities = (argc >= 5) ? static_cast<size_t>(std::strtoull(argv[4], nullptr, 10)) : 64u;
+        if (entities == 0) {
+            std::cerr << "entities must be > 0\n";
+            return 1;
+        }
+        return write_demo(argv[2], ticks, entities);
+    }
+
+    for (int a = 1; a < argc; ++a) {
+        const std::string arg = argv[a];
+        if ((arg == "--events" || arg == "--trajectory" || arg == "--block-rows") && a + 1 < argc) {
+            const std::string value = argv[++a];
+            if (arg == "--events") events_path = value;
+            if (arg == "--trajectory") traj_path = value;
+            if (arg == "--block-rows") block_rows = static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+        } else if (arg.size() > 1 && arg[0] == '-' && arg[1] == '-') {
+            usage();
+            return 1;
+        } else {
+            input = arg;
+        }
+    }
+
+    // ---- Open the input and read the header. The input is only consumed
+    // (and the reader thread started) once every output is open.
+    uint8_t header_bytes[kHeaderBytes];
+    std::FILE* stream = nullptr;
+    FilePtr owned_stream;
+#if !defined(_WIN32)
+    FdGuard fd;
+    size_t file_size = 0;
+#endif
+
+    if (input == "-") {
+        stream = stdin;
+        set_binary(stdin);
+    } else {
+#if !defined(_WIN32)
+        fd.fd = ::open(input.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd.fd >= 0 && ::fstat(fd.fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            file_size = static_cast<size_t>(st.st_size);
+        } else if (fd.fd >= 0) {
+            // Named pipe or device: stream it.
+            stream = ::fdopen(fd.fd, "rb");
+            if (stream != nullptr) {
+                fd.fd = -1;
+            } else {
+                fd.Close();
+            }
+            owned_stream.reset(stream);
+        }
+#else
+        stream = std::fopen(input.c_str(), "rb");
+        owned_stream.reset(stream);
+#endif
+    }
+
+#if !defined(_WIN32)
+    if (fd.fd < 0 && stream == nullptr) {
+#else
+    if (stream == nullptr) {
+#endif
+        std::cerr << "cannot open " << input << "\n";
+        return 1;
+    }
+
+    StreamHeader h{};
+    std::string err;
+    bool header_ok = false;
+#if !defined(_WIN32)
+    if (fd.fd >= 0) {
+        if (file_size < kHeaderBytes) err = "shorter than the stream header";
+        header_ok = err.empty() &&
+                    ::pread(fd.fd, header_bytes, kHeaderBytes, 0) == static_cast<ssize_t>(kHeaderBytes) &&
+                    decode_header(header_bytes, h, err);
+    }
+#endif
+    if (stream != nullptr) {
+        header_ok = read_exact(stream, header_bytes, kHeaderBytes) && decode_header(header_bytes, h, err);
+    }
+    if (!header_ok) {
+        std::cerr << input << ": " << (err.empty() ? "cannot read header" : err) << "\n";
+        return 1;
+    }
+
+    // decode_header bounds entities * delta_dim; a block must also fit in memory.
+    const size_t row_doubles = h.entities * h.delta_dim;
+    const size_t max_block_rows = std::numeric_limits<size_t>::max() / sizeof(double) / row_doubles;
+    if (block_rows == 0) block_rows = std::max<size_t>(1u, (size_t{1} << 20) / sizeof(double) / row_doubles);
+    if (block_rows > max_block_rows) {
+        std::cerr << "--block-rows " << block_rows << " overflows a block of " << row_doubles << "-double rows\n";
+        return 1;
+    }
+
+    // ---- Cores
+    const std::vector<StructuralState> init(h.entities, h.genesis);
+    std::optional<MaxCoreBatch> batch = MaxCoreBatch::Create(h.params, h.delta_dim, init.data(), h.entities, h.delta_max);
+    if (!batch) {
+        std::cerr << input << ": invalid params, genesis state or delta_max\n";
+        return 1;
+    }
+
+    // ---- Outputs
+    std::FILE* events = nullptr;
+    FilePtr owned_events;
+    if (!events_path.empty()) {
+        if (events_path == "-") {
+            events = stdout;
+            set_binary(stdout);
+        } else {
+            owned_events.reset(std::fopen(events_path.c_str(), "wb"));
+            events = owned_events.get();
+        }
+        if (events == nullptr || !write_event_header(events)) {
+            std::cerr << "cannot write events: " << events_path << "\n";
+            return 1;
+        }
+    }
+
+    std::optional<TrajectoryFileWriter> traj;
+    if (!traj_path.empty()) {
+        traj = TrajectoryFileWriter::Create(traj_path, h.params, h.dt, h.delta_dim);
+        if (!traj) {
+            std::cerr << "cannot write trajectory: " << traj_path << "\n";
+            return 1;
+        }
+    }
+
+    // ---- Body source
+    std::unique_ptr<RowSource> source;
+#if !defined(_WIN32)
+    if (fd.fd >= 0) {
+        source = MappedSource::Open(fd.fd, file_size, row_doubles, block_rows);
+        fd.Close();
+        if (!source) {
+            std::cerr << input << ": mmap failed\n";
+            return 1;
+        }
+    }
+#endif
+    if (!source) source = std::make_unique<StreamSource>(stream, std::move(owned_stream), row_doubles, block_rows);
+
+    // ---- Run
+    const auto t0 = std::chrono::steady_clock::now();
+    uint64_t ticks = 0;
+    uint64_t collapses = 0;
+    uint64_t errors = 0;
+    bool out_ok = true;
+
+    const double* rows = nullptr;
+    size_t count = 0;
+    while (out_ok && source->Next(rows, count)) {
+        for (size_t r = 0; r < count; ++r) {
+            const bool any_live = batch->Live() > 0;
+            const std::vector<EventFlag>& ev = batch->StepAll(rows + r * row_doubles, h.dt);
+
+            // With no live lane every event is the terminal NORMAL.
+            if (any_live || traj) {
+                for (size_t i = 0; i < h.entities; ++i) {
+                    if (ev[i] == EventFlag::COLLAPSE) collapses += 1u;
+                    if (ev[i] == EventFlag::ERROR) errors += 1u;
+                    if (events != nullptr && ev[i] != EventFlag::NORMAL) {
+                        out_ok = write_event(events, i, ticks, *batch, ev[i]) && out_ok;
+                    }
+                    if (traj) {
+                        const TrajectoryRow row{static_cast<uint64_t>(i), ev[i], batch->Current(i), batch->Previous(i), batch->Lifecycle(i)};
+                        out_ok = traj->Append(row) && out_ok;
+                    }
+                }
+            }
+            ticks += 1u;
+        }
+    }
+    const bool in_failed = source->Failed();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    source.reset();
+    if (events != nullptr) {
+        out_ok = (owned_events ? std::fclose(owned_events.release()) == 0 : std::fflush(events) == 0) && out_ok;
+    }
+    if (traj) out_ok = traj->Close() && out_ok;
+
+    const uint64_t steps = ticks * h.entities;
+    std::cerr << "maxcore_run: ticks=" << ticks << " entities=" << h.entities << " steps=" << steps
+              << " collapses=" << collapses << " errors=" << errors << " live=" << batch->Live()
+              << " seconds=" << seconds
+              << " steps_per_sec=" << (seconds > 0.0 ? static_cast<double>(steps) / seconds : 0.0) << "\n";
+
+    if (in_failed) {
+        std::cerr << input << ": read error or truncated last row\n";
+        return 1;
+    }
+    if (!out_ok) {
+        std::cerr << "output write failed\n";
+        return 1;
+    }
+    return 0;
+}
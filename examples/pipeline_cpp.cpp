@@ -2,14 +2,15 @@
 // File: examples/pipeline_cpp.cpp
 // ==============================
 #include <cstdint>
-#include <fstream>
-#include <iomanip>
 #include <iostream>
 #include <optional>
 #include <string>
 
 #include "maxcore/maxcore.h"
 #include "maxcore/derived.h"
+#include "maxcore/exporter.h"
+#include "maxcore/lifecycle.h"
+#include "maxcore/trajectory_file.h"
 
 static const char* EventToStr(maxcore::EventFlag ev) noexcept {
     switch (ev) {
@@ -20,34 +21,11 @@ static const char* EventToStr(maxcore::EventFlag ev) noexcept {
     }
 }
 
-static void WriteHeader(std::ofstream& out) {
-    out
-        << "t"
-        << ",lifecycle"
-        << ",step_counter"
-        << ",event"
-        << ",terminal"
-        << ",collapse_emitted"
-        << ",phi"
-        << ",memory"
-        << ",kappa"
-        << ",d_phi"
-        << ",d_memory"
-        << ",d_kappa"
-        << ",phi_rate"
-        << ",memory_rate"
-        << ",kappa_rate"
-        << ",kappa_ratio"
-        << ",kappa_distance"
-        << ",load_term"
-        << ",regen_term"
-        << "\n";
-}
-
 int main(int argc, char** argv) {
     using namespace maxcore;
 
     const std::string out_path = (argc >= 2) ? std::string(argv[1]) : std::string("out_pipeline_cpp.csv");
+    const std::string traj_path = (argc >= 3) ? std::string(argv[2]) : std::string("out_pipeline_cpp.mctraj");
 
     // ---- Pipeline config (deterministic)
     const size_t delta_dim = 2;
@@ -69,43 +47,44 @@ int main(int argc, char** argv) {
     // Deterministic constant delta input
     double delta[delta_dim] = {1.0, 2.0};
 
-    auto make_fresh = [&]() -> std::optional<MaxCore> {
-        // Fresh Genesis initial state (external orchestration):
-        // Phi = 0, Memory = 0, Kappa = kappa_max
-        StructuralState init{0.0, 0.0, p.kappa_max};
-        return MaxCore::Create(p, delta_dim, init);
-    };
+    // Fresh Genesis initial state (external orchestration):
+    // Phi = 0, Memory = 0, Kappa = kappa_max
+    const StructuralState genesis_state{0.0, 0.0, p.kappa_max};
 
-    std::optional<MaxCore> core_opt = make_fresh();
-    if (!core_opt) {
+    // The runner validates params and genesis state once; every Fresh Genesis
+    // afterwards is an in-place reset of the same core.
+    std::optional<LifecycleRunner> runner = LifecycleRunner::Create(p, delta_dim, genesis_state);
+    if (!runner) {
         std::cerr << "Create() failed\n";
         return 1;
     }
 
-    // IMPORTANT: keep the core inside std::optional and reset it on genesis.
-    // This avoids any accidental stale state and makes lifecycle resets explicit.
-    std::optional<MaxCore> core = std::move(core_opt);
-
-    uint64_t lifecycle_id = 0;
-
-    std::ofstream out(out_path, std::ios::out | std::ios::trunc);
+    // CSV rows are formatted with to_chars into large blocks (fixed, 10 decimals).
+    ExportOptions csv_options;
+    csv_options.format = ExportFormat::CSV;
+    csv_options.precision = 10;
+    std::optional<TextExporter> out = TextExporter::Create(out_path, csv_options);
     if (!out) {
         std::cerr << "Cannot open output file: " << out_path << "\n";
         return 2;
     }
-    out.setf(std::ios::fixed);
-    out << std::setprecision(10);
-    WriteHeader(out);
+
+    // Binary columnar copy of the same rows (see TrajectoryFileReader).
+    std::optional<TrajectoryFileWriter> traj = TrajectoryFileWriter::Create(traj_path, p, dt, delta_dim);
+    if (!traj) {
+        std::cerr << "Cannot open trajectory file: " << traj_path << "\n";
+        return 2;
+    }
 
     std::cout << "=== example_pipeline_cpp ===\n";
-    std::cout << "out=" << out_path << " steps=" << total_steps << " dt=" << dt << "\n";
+    std::cout << "out=" << out_path << " traj=" << traj_path << " steps=" << total_steps << " dt=" << dt << "\n";
 
     // Print initial state (t = -1 snapshot) to prove genesis resets core state.
     {
-        const auto& st = core->Current();
-        const auto& lc = core->Lifecycle();
+        const auto& st = runner->Core().Current();
+        const auto& lc = runner->Core().Lifecycle();
         std::cout
-            << "[init] lifecycle=" << lifecycle_id
+            << "[init] lifecycle=" << runner->LifecycleId()
             << " Phi=" << st.phi
             << " M=" << st.memory
             << " K=" << st.kappa
@@ -116,53 +95,30 @@ int main(int argc, char** argv) {
     }
 
     for (int t = 0; t < total_steps; ++t) {
-        // Defensive: should never be empty during loop.
-        if (!core) {
-            std::cerr << "Internal error: core is nullopt at t=" << t << "\n";
-            return 5;
-        }
-
-        const EventFlag ev = core->Step(delta, delta_dim, dt);
-
-        // Derived projection is read-only and must succeed for dt>0 and finite state.
-        auto d = ComputeDerived(core->Current(), core->Previous(), core->Lifecycle(), p, dt);
+        const MaxCore& core = runner->Core();
+        // Step and derived projection in one call; the frame equals
+        // ComputeDerived() of the committed state and must exist for dt>0.
+        std::optional<DerivedFrame> d;
+        const EventFlag ev = runner->StepWithDerived(delta, delta_dim, dt, d);
         if (!d) {
             std::cerr << "ComputeDerived failed at t=" << t << "\n";
             return 3;
         }
 
-        out
-            << t
-            << "," << lifecycle_id
-            << "," << core->Lifecycle().step_counter
-            << "," << EventToStr(ev)
-            << "," << (core->Lifecycle().terminal ? 1 : 0)
-            << "," << (core->Lifecycle().collapse_emitted ? 1 : 0)
-            << "," << core->Current().phi
-            << "," << core->Current().memory
-            << "," << core->Current().kappa
-            << "," << d->d_phi
-            << "," << d->d_memory
-            << "," << d->d_kappa
-            << "," << d->phi_rate
-            << "," << d->memory_rate
-            << "," << d->kappa_rate
-            << "," << d->kappa_ratio
-            << "," << d->kappa_distance
-            << "," << d->load_term
-            << "," << d->regen_term
-            << "\n";
+        out->Append(static_cast<uint64_t>(t), runner->LifecycleId(), ev, core, *d);
+
+        traj->Append(core, ev, runner->LifecycleId());
 
         if (t < 5 || ev == EventFlag::COLLAPSE) {
             std::cout
-                << "[t=" << t << "] lifecycle=" << lifecycle_id
+                << "[t=" << t << "] lifecycle=" << runner->LifecycleId()
                 << " ev=" << EventToStr(ev)
-                << " Phi=" << core->Current().phi
-                << " M=" << core->Current().memory
-                << " K=" << core->Current().kappa
-                << " sc=" << core->Lifecycle().step_counter
-                << " term=" << (core->Lifecycle().terminal ? 1 : 0)
-                << " collapse_emitted=" << (core->Lifecycle().collapse_emitted ? 1 : 0)
+                << " Phi=" << core.Current().phi
+                << " M=" << core.Current().memory
+                << " K=" << core.Current().kappa
+                << " sc=" << core.Lifecycle().step_counter
+                << " term=" << (core.Lifecycle().terminal ? 1 : 0)
+                << " collapse_emitted=" << (core.Lifecycle().collapse_emitted ? 1 : 0)
                 << "\n";
         }
 
@@ -172,26 +128,21 @@ int main(int argc, char** argv) {
         }
 
         if (ev == EventFlag::COLLAPSE) {
-            // External Fresh Genesis (new lifecycle instance).
-            lifecycle_id += 1;
-
-            std::optional<MaxCore> fresh = make_fresh();
-            if (!fresh) {
-                std::cerr << "Fresh Genesis Create() failed\n";
-                return 4;
-            }
-
-            // Replace instance explicitly.
-            core.reset();
-            core = std::move(fresh);
+            // External Fresh Genesis (in-place reset, new lifecycle id).
+            const LifecycleSummary closed = runner->Genesis();
+            std::cout
+                << "[summary] lifecycle=" << closed.lifecycle_id
+                << " length=" << closed.length
+                << " min_kappa=" << closed.min_kappa
+                << "\n";
 
             // Print reset proof immediately after genesis.
             {
-                const auto& st = core->Current();
-                const auto& lc = core->Lifecycle();
-                std::cout << "=== Fresh Genesis -> lifecycle=" << lifecycle_id << " ===\n";
+                const auto& st = runner->Core().Current();
+                const auto& lc = runner->Core().Lifecycle();
+                std::cout << "=== Fresh Genesis -> lifecycle=" << runner->LifecycleId() << " ===\n";
                 std::cout
-                    << "[genesis] lifecycle=" << lifecycle_id
+                    << "[genesis] lifecycle=" << runner->LifecycleId()
                     << " Phi=" << st.phi
                     << " M=" << st.memory
                     << " K=" << st.kappa
@@ -203,9 +154,17 @@ int main(int argc, char** argv) {
         }
     }
 
-    out.flush();
-    out.close();
+    if (!out->Close()) {
+        std::cerr << "CSV write failed: " << out_path << "\n";
+        return 4;
+    }
+
+    if (!traj->Close()) {
+        std::cerr << "Trajectory write failed: " << traj_path << "\n";
+        return 4;
+    }
 
     std::cout << "Wrote: " << out_path << "\n";
+    std::cout << "Wrote: " << traj_path << " rows=" << traj->Rows() << "\n";
     return 0;
 }
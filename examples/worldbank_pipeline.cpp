@@ -1,13 +1,15 @@
 #include <maxcore/maxcore.h>
+#include <maxcore/sweep.h>
 
 #include <curl/curl.h>
 
 #include <algorithm>
-#include <array>
 #include <cmath>
 #include <iostream>
 #include <map>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace maxcore;
@@ -120,8 +122,8 @@ static void normalize(std::map<int, double>& data)
 
 struct CountryData {
     std::string code;
-    std::vector<int> years;                         // ascending
-    std::vector<std::array<double, 3>> deltas_norm; // per year
+    std::vector<int> years;           // ascending
+    std::vector<double> deltas_norm;  // 3 values per year, row-major
 };
 
 static CountryData load_country(const std::string& country_code)
@@ -152,26 +154,30 @@ static CountryData load_country(const std::string& country_code)
 
     CountryData out;
     out.code = country_code;
-    out.years = years;
-    out.deltas_norm.reserve(years.size());
+    out.deltas_norm.reserve(years.size() * 3u);
 
     for (int y : years) {
-        out.deltas_norm.emplace_back(std::array<double, 3>{ gdp[y], inf[y], unemp[y] });
+        const double row[3] = { gdp[y], inf[y], unemp[y] };
+        // A year-by-year Step loop answers a non-finite row with ERROR and moves
+        // on; the sweep would stop every point there, so such years are dropped.
+        if (!std::isfinite(row[0]) || !std::isfinite(row[1]) || !std::isfinite(row[2]))
+            continue;
+        out.years.push_back(y);
+        out.deltas_norm.insert(out.deltas_norm.end(), row, row + 3);
     }
 
     return out;
 }
 
 // =====================================================
-// Run one scenario on preloaded data
+// Sweep the (rho, lambda_phi) grid on preloaded data
 // =====================================================
 
-static bool run_scenario(
+static SweepResult run_sweep(
     const CountryData& cd,
-    double rho,
-    double lambda_phi,
-    double lambda_m_fixed,
-    int& collapse_year_out
+    const std::vector<double>& rhos,
+    const std::vector<double>& lphis,
+    double lambda_m_fixed
 )
 {
     ParameterSet p;
@@ -179,32 +185,40 @@ static bool run_scenario(
     p.eta = 0.2;
     p.beta = 0.1;
     p.gamma = 0.1;
-    p.rho = rho;
-    p.lambda_phi = lambda_phi;
+    p.rho = rhos.front();
+    p.lambda_phi = lphis.front();
     p.lambda_m = lambda_m_fixed;
     p.kappa_max = 1.0;
 
     StructuralState init{0.0, 0.0, 1.0};
 
-    auto core_opt = MaxCore::Create(p, 3, init);
-    if (!core_opt)
-        throw std::runtime_error("MaxCore::Create failed");
+    auto sweep = ParameterSweep::Create(
+        p, {{&ParameterSet::rho, rhos}, {&ParameterSet::lambda_phi, lphis}}, 3, init);
+    if (!sweep)
+        throw std::runtime_error("ParameterSweep::Create failed");
 
-    MaxCore core = *core_opt;
+    // Only the collapse step matters: every grid point shares the same delta stream.
+    // A point stopped by ERROR (unstable dt for its parameters) prints NONE, as the
+    // per-year loop did.
+    auto result = sweep->Run(cd.deltas_norm.data(), cd.years.size(), 3, 1.0);
+    if (!result)
+        throw std::runtime_error("ParameterSweep::Run failed");
 
-    for (size_t i = 0; i < cd.years.size(); ++i) {
-        const auto& dv = cd.deltas_norm[i];
-        const double delta[3] = { dv[0], dv[1], dv[2] };
-
-        const EventFlag ev = core.Step(delta, 3, 1.0);
-        if (ev == EventFlag::COLLAPSE) {
-            collapse_year_out = cd.years[i];
-            return true;
-        }
-    }
+    return std::move(*result);
+}
 
-    collapse_year_out = -1;
-    return false;
+static void print_sweep(
+    const CountryData& cd,
+    const SweepResult& r,
+    size_t point,
+    double rho,
+    double lambda_phi,
+    double lambda_m_fixed
+)
+{
+    const int64_t step = r.collapse_step[point];
+    std::cout << cd.code << "," << rho << "," << lambda_phi << "," << lambda_m_fixed << ","
+              << (step >= 0 ? std::to_string(cd.years[static_cast<size_t>(step)]) : "NONE") << "\n";
 }
 
 // =====================================================
@@ -218,26 +232,23 @@ int main()
     try {
         const double lambda_m_fixed = 0.05;
 
-        const double rhos[]  = {0.05, 0.15, 0.30};
-        const double lphis[] = {0.02, 0.05, 0.10, 0.20};
+        const std::vector<double> rhos  = {0.05, 0.15, 0.30};
+        const std::vector<double> lphis = {0.02, 0.05, 0.10, 0.20};
 
         const CountryData usa = load_country("USA");
         const CountryData euu = load_country("EUU");
 
-        std::cout << "country,rho,lambda_phi,lambda_m,collapse_year\n";
-
-        for (double rho : rhos) {
-            for (double lp : lphis) {
+        const SweepResult usa_grid = run_sweep(usa, rhos, lphis, lambda_m_fixed);
+        const SweepResult euu_grid = run_sweep(euu, rhos, lphis, lambda_m_fixed);
 
-                int cy = -1;
-                const bool c1 = run_scenario(usa, rho, lp, lambda_m_fixed, cy);
-                std::cout << "USA," << rho << "," << lp << "," << lambda_m_fixed << ","
-                          << (c1 ? std::to_string(cy) : "NONE") << "\n";
+        std::cout << "country,rho,lambda_phi,lambda_m,collapse_year\n";
 
-                cy = -1;
-                const bool c2 = run_scenario(euu, rho, lp, lambda_m_fixed, cy);
-                std::cout << "EUU," << rho << "," << lp << "," << lambda_m_fixed << ","
-                          << (c2 ? std::to_string(cy) : "NONE") << "\n";
+        // Grid points are row-major: point = i_rho * lphis.size() + i_lphi
+        for (size_t i = 0; i < rhos.size(); ++i) {
+            for (size_t j = 0; j < lphis.size(); ++j) {
+                const size_t point = i * lphis.size() + j;
+                print_sweep(usa, usa_grid, point, rhos[i], lphis[j], lambda_m_fixed);
+                print_sweep(euu, euu_grid, point, rhos[i], lphis[j], lambda_m_fixed);
             }
         }
     }
@@ -0,0 +1,132 @@
+// ==============================
+// File: include/maxcore/batch.h
+// ==============================
+#ifndef MAXCORE_BATCH_H
+#define MAXCORE_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "maxcore/types.h"
+
+namespace maxcore {
+
+namespace detail {
+struct SnapshotAccess;
+}
+
+// Structure-of-arrays engine that advances many independent cores in lockstep.
+// All lanes share one parameter set, delta_dim and delta_max.
+// Every lane follows exactly the MaxCore::Step contract. MaxCoreBatch (double)
+// produces results bitwise identical to a scalar MaxCore fed with the same
+// inputs; MaxCoreBatchT<float> runs the same kernel in single precision (half
+// the state and input bandwidth) and matches MaxCoreT<float> bitwise.
+template <typename Scalar>
+class MaxCoreBatchT final {
+    static_assert(std::is_same_v<Scalar, double> || std::is_same_v<Scalar, float>,
+                  "MaxCoreBatchT supports double and float");
+
+public:
+    using State = BasicStructuralState<Scalar>;
+    using Parameters = BasicParameterSet<Scalar>;
+
+    // Create() is the only construction entry point.
+    // initial_states MUST point to `lanes` states; each is validated as in MaxCore::Create.
+    // Returns std::nullopt on any validation failure.
+    static std::optional<MaxCoreBatchT> Create(
+        const Parameters& params,
+        size_t delta_dim,
+        const State* initial_states,
+        size_t lanes,
+        std::optional<Scalar> delta_max = std::nullopt
+    );
+
+    // StepAll() is the only mutation authority.
+    // deltas holds Lanes() * DeltaDim() values, lane-major (lane i reads deltas + i * DeltaDim()).
+    // dt and the shared stability bound are validated once per call.
+    // Returns the per-lane EventFlag array (Lanes() entries); lane i receives exactly
+    // the flag MaxCore::Step would return for that lane (terminal lanes short-circuit
+    // to NORMAL, invalid input yields ERROR without mutating the lane).
+    // Only live (non-terminal) lanes are visited: a collapsing lane is compacted out
+    // of the active set at the end of the call, and a call with no live lane returns
+    // immediately. Rows of terminal lanes in `deltas` are never read.
+    const std::vector<EventFlag>& StepAll(const Scalar* deltas, Scalar dt);
+
+    size_t Lanes() const noexcept { return phi_.size(); }
+    size_t DeltaDim() const noexcept { return delta_dim_; }
+    const Parameters& Params() const noexcept { return params_; }
+    const std::vector<EventFlag>& Events() const noexcept { return events_; }
+
+    // Number of live (non-terminal) lanes; 0 once every lane has collapsed.
+    size_t Live() const noexcept { return live_.size(); }
+
+    // Per-lane snapshots (lane MUST be < Lanes())
+    State Current(size_t lane) const noexcept;
+    State Previous(size_t lane) const noexcept;
+    LifecycleContext Lifecycle(size_t lane) const noexcept;
+
+    // Read-only column views (Lanes() entries each)
+    const Scalar* Phi() const noexcept { return phi_.data(); }
+    const Scalar* Memory() const noexcept { return memory_.data(); }
+    const Scalar* Kappa() const noexcept { return kappa_.data(); }
+
+private:
+    friend struct detail::SnapshotAccess;
+
+    // Allocates zeroed columns for `lanes` lanes; callers fill them.
+    MaxCoreBatchT(
+        const Parameters& params,
+        size_t delta_dim,
+        size_t lanes,
+        std::optional<Scalar> delta_max
+    );
+
+    MaxCoreBatchT(
+        const Parameters& params,
+        size_t delta_dim,
+        const State* initial_states,
+        size_t lanes,
+        std::optional<Scalar> delta_max
+    );
+
+    // Persistent immutable configuration (shared by all lanes)
+    Parameters params_;
+    size_t delta_dim_;
+    std::optional<Scalar> delta_max_;
+
+    // Persistent structural state, one contiguous column per field
+    std::vector<Scalar> phi_;
+    std::vector<Scalar> memory_;
+    std::vector<Scalar> kappa_;
+
+    std::vector<Scalar> prev_phi_;
+    std::vector<Scalar> prev_memory_;
+    std::vector<Scalar> prev_kappa_;
+
+    std::vector<uint64_t> step_counter_;
+    std::vector<uint8_t> terminal_;
+    std::vector<uint8_t> collapse_emitted_;
+
+    // Output of the last StepAll()
+    std::vector<EventFlag> events_;
+
+    // Active set: indices of non-terminal lanes in ascending order, and the lanes
+    // that collapsed in the last call (their events_ entry still reads COLLAPSE).
+    std::vector<size_t> live_;
+    std::vector<size_t> retired_;
+
+    // Rebuilds live_ from the Kappa column (after the columns were filled).
+    void RebuildLive();
+};
+
+using MaxCoreBatch = MaxCoreBatchT<double>;
+
+extern template class MaxCoreBatchT<double>;
+extern template class MaxCoreBatchT<float>;
+
+} // namespace maxcore
+
+#endif // MAXCORE_BATCH_H
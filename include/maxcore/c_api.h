@@ -22,6 +22,7 @@ extern "C" {
 #endif
 
 typedef struct maxcore_handle maxcore_handle;
+typedef struct maxcore_pool maxcore_pool;
 
 typedef enum maxcore_event {
     MAXCORE_EVENT_NORMAL   = 0,
@@ -29,6 +30,21 @@ typedef enum maxcore_event {
     MAXCORE_EVENT_ERROR    = 2
 } maxcore_event;
 
+/* Reason of the last step on a handle (values match maxcore::StepStatus;
+   MAXCORE_STATUS_INVALID_ARGUMENT is C API only). */
+typedef enum maxcore_status {
+    MAXCORE_STATUS_OK               = 0,
+    MAXCORE_STATUS_TERMINAL         = 1,
+    MAXCORE_STATUS_NULL_INPUT       = 2,
+    MAXCORE_STATUS_DIM_MISMATCH     = 3,
+    MAXCORE_STATUS_DT_INVALID       = 4,
+    MAXCORE_STATUS_DT_UNSTABLE      = 5,
+    MAXCORE_STATUS_DELTA_NON_FINITE = 6,
+    MAXCORE_STATUS_NORM_GUARD       = 7,
+    MAXCORE_STATUS_NUMERIC_FAILURE  = 8,
+    MAXCORE_STATUS_INVALID_ARGUMENT = 9
+} maxcore_status;
+
 typedef struct maxcore_params {
     double alpha;
     double eta;
@@ -83,6 +99,26 @@ MAXCORE_CAPI maxcore_handle* maxcore_create(
 
 MAXCORE_CAPI void maxcore_destroy(maxcore_handle* h);
 
+/* Caller-owned storage: a handle needs maxcore_handle_size() bytes aligned to
+   maxcore_handle_align(). maxcore_init_in() constructs a handle in `mem` (same
+   arguments and validation as maxcore_create) and returns it, or NULL if `mem`
+   is NULL, too small or misaligned, or the arguments are invalid. Such a handle
+   is released with maxcore_fini_in(), never maxcore_destroy(); the memory stays
+   the caller's. */
+MAXCORE_CAPI size_t maxcore_handle_size(void);
+MAXCORE_CAPI size_t maxcore_handle_align(void);
+
+MAXCORE_CAPI maxcore_handle* maxcore_init_in(
+    void* mem,
+    size_t mem_size,
+    const maxcore_params* params,
+    size_t delta_dim,
+    const maxcore_state* initial_state,
+    const double* delta_max_opt
+);
+
+MAXCORE_CAPI void maxcore_fini_in(maxcore_handle* h);
+
 MAXCORE_CAPI maxcore_event maxcore_step(
     maxcore_handle* h,
     const double* delta_input,
@@ -90,6 +126,23 @@ MAXCORE_CAPI maxcore_event maxcore_step(
     double dt
 );
 
+/* Runs `steps` rows as one call; identical to a loop of maxcore_step() over
+   row i = deltas + i * stride (delta_dim values, stride >= delta_dim) with dt = dts[i].
+   events_out[i] receives the event of row i; states_out_opt (may be NULL) receives
+   the current state after row i. The loop does not stop at COLLAPSE or ERROR
+   (a terminal core reports NORMAL without committing). maxcore_last_status()
+   afterwards reflects the last row. Returns the number of committed steps.
+   Returns 0 without stepping if an argument is invalid. */
+MAXCORE_CAPI size_t maxcore_step_many(
+    maxcore_handle* h,
+    const double* deltas,
+    size_t steps,
+    size_t stride,
+    const double* dts,
+    maxcore_event* events_out,
+    maxcore_state* states_out_opt
+);
+
 MAXCORE_CAPI int maxcore_get_current(const maxcore_handle* h, maxcore_state* out);
 MAXCORE_CAPI int maxcore_get_previous(const maxcore_handle* h, maxcore_state* out);
 MAXCORE_CAPI int maxcore_get_lifecycle(const maxcore_handle* h, maxcore_lifecycle* out);
@@ -100,6 +153,60 @@ MAXCORE_CAPI int maxcore_compute_derived(
     maxcore_derived_frame* out
 );
 
+/* maxcore_step() followed by maxcore_compute_derived(h, dt, out), fused.
+   *derived_ok is set to 1 if *out was filled and 0 where maxcore_compute_derived
+   would return 0. out and derived_ok may be NULL (the step still runs). */
+MAXCORE_CAPI maxcore_event maxcore_step_with_derived(
+    maxcore_handle* h,
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    maxcore_derived_frame* out,
+    int* derived_ok
+);
+
+/* Pool: `count` handles sharing params, delta_dim and delta_max, stored
+   contiguously in one cache-line-aligned allocation. initial_states holds
+   `count` states. Returns NULL if count == 0 or any argument is invalid. */
+MAXCORE_CAPI maxcore_pool* maxcore_pool_create(
+    size_t count,
+    const maxcore_params* params,
+    size_t delta_dim,
+    const maxcore_state* initial_states,
+    const double* delta_max_opt
+);
+
+MAXCORE_CAPI void maxcore_pool_destroy(maxcore_pool* pool);
+MAXCORE_CAPI size_t maxcore_pool_size(const maxcore_pool* pool);
+
+/* Handle `index` of the pool (NULL if out of range). It works with every
+   per-handle function, is owned by the pool and MUST NOT be destroyed. */
+MAXCORE_CAPI maxcore_handle* maxcore_pool_handle(maxcore_pool* pool, size_t index);
+
+/* One maxcore_step() per handle, in index order: handle i consumes
+   row deltas + i * stride (delta_dim values, stride >= delta_dim) with dt = dts[i].
+   events_out[i] / states_out_opt[i] (may be NULL) receive its event and state,
+   and its maxcore_last_status() is updated. Returns the number of committed steps.
+   Returns 0 without stepping if an argument is invalid (every handle then reports
+   MAXCORE_STATUS_INVALID_ARGUMENT). */
+MAXCORE_CAPI size_t maxcore_pool_step(
+    maxcore_pool* pool,
+    const double* deltas,
+    size_t stride,
+    const double* dts,
+    maxcore_event* events_out,
+    maxcore_state* states_out_opt
+);
+
+/* Status of the last maxcore_step / maxcore_step_with_derived / maxcore_step_many
+   call (for maxcore_step_many: of its last row). MAXCORE_STATUS_INVALID_ARGUMENT
+   for a NULL handle. */
+MAXCORE_CAPI maxcore_status maxcore_last_status(const maxcore_handle* h);
+
+/* Static description of a status code (never NULL, never freed). */
+MAXCORE_CAPI const char* maxcore_status_string(maxcore_status status);
+
+/* "" unless the last status is a failure; otherwise maxcore_status_string() of it. */
 MAXCORE_CAPI const char* maxcore_last_error(const maxcore_handle* h);
 
 #ifdef __cplusplus
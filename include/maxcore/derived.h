@@ -4,6 +4,8 @@
 #ifndef MAXCORE_DERIVED_H
 #define MAXCORE_DERIVED_H
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include "maxcore/types.h"
 
@@ -52,6 +54,48 @@ std::optional<DerivedFrame> ComputeDerived(
     double dt
 );
 
+// Read-only state columns (row i is (phi[i], memory[i], kappa[i])).
+struct StateColumns {
+    const double* phi;
+    const double* memory;
+    const double* kappa;
+};
+
+// SoA output of ComputeDerivedBatch, one column per DerivedFrame value.
+// Every pointer MUST hold `rows` elements. Lifecycle mirrors are not
+// produced: they are plain copies of the caller's own columns.
+struct DerivedColumns {
+    double* d_phi;
+    double* d_memory;
+    double* d_kappa;
+    double* phi_rate;
+    double* memory_rate;
+    double* kappa_rate;
+    double* kappa_ratio;
+    double* kappa_distance;
+    double* load_term;
+    double* regen_term;
+};
+
+// Column form of ComputeDerived for `rows` (current, previous) pairs.
+// For a contiguous recorded run, previous is the current view shifted by one
+// row: previous = {phi, memory, kappa}, current = {phi + 1, memory + 1, kappa + 1}.
+// Output columns and `valid` MUST NOT overlap the inputs or each other.
+//
+// valid[i] is set to 1 where ComputeDerived would return a frame and 0 where it
+// would return std::nullopt; values of invalid rows are unspecified. Values of
+// valid rows are bitwise identical to ComputeDerived. Returns the number of
+// valid rows (0 for invalid params or dt).
+size_t ComputeDerivedBatch(
+    const StateColumns& current,
+    const StateColumns& previous,
+    size_t rows,
+    const ParameterSet& params,
+    double dt,
+    const DerivedColumns& out,
+    uint8_t* valid
+) noexcept;
+
 } // namespace maxcore
 
 #endif // MAXCORE_DERIVED_H
@@ -0,0 +1,167 @@
+// ==============================
+// File: include/maxcore/ensemble.h
+// ==============================
+#ifndef MAXCORE_ENSEMBLE_H
+#define MAXCORE_ENSEMBLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "maxcore/event_queue.h"
+#include "maxcore/maxcore.h"
+
+namespace maxcore {
+
+namespace detail {
+class WorkStealingPool;
+}
+
+// Per-entity input buffer: `steps` delta rows, row i at deltas + i * stride.
+// The buffer is not copied and MUST stay valid while the runner reads it.
+struct EntityInput {
+    const double* deltas;
+    size_t steps;
+    size_t stride;
+    double dt;
+};
+
+// Totals of one Tick() / RunFree() call.
+struct EnsembleStats {
+    size_t rows;       // rows consumed
+    size_t collapsed;  // COLLAPSE events
+    size_t errors;     // ERROR events
+    size_t live;       // non-terminal entities after the call
+};
+
+// Owns N independent MaxCore instances and advances them on a work-stealing
+// thread pool. Each core is stored in its own cache-line-aligned slot and the
+// entities are handed out in contiguous blocks, one initial shard per worker;
+// workers whose shard finishes early (e.g. collapsed cores) steal half of a
+// busy worker's remaining blocks.
+//
+// Every entity receives exactly the Step() calls it would receive from a serial
+// loop over its input buffer, so results are bitwise identical to serial
+// stepping and independent of the worker count. Tick() and RunFree() MUST NOT
+// be called concurrently on the same runner.
+//
+// Only live (non-terminal) entities are dispatched. An entity that collapses is
+// compacted out of the active set at the end of the call; from then on its
+// short-circuited rows are accounted for in O(1) per call (Cursor, Remaining,
+// LastEvent and the row totals are exactly those of stepping it), and a call
+// with no live entity does not wake the pool.
+class EnsembleRunner final {
+public:
+    // Create() is the only construction entry point.
+    // workers == 0 uses the hardware concurrency.
+    // Returns std::nullopt if `cores` is empty.
+    static std::optional<EnsembleRunner> Create(std::vector<MaxCore> cores, size_t workers = 0);
+
+    EnsembleRunner(EnsembleRunner&&) noexcept;
+    EnsembleRunner& operator=(EnsembleRunner&&) noexcept;
+    ~EnsembleRunner();
+
+    // Binds an input buffer to `entity` and rewinds its cursor to row 0.
+    // Returns false (nothing changes) if entity is out of range, deltas is null
+    // with steps > 0, or stride < the core's DeltaDim().
+    bool SetInput(size_t entity, const EntityInput& input) noexcept;
+
+    // Workers push every COLLAPSE and ERROR of Tick() / RunFree() to `queue` as
+    // they happen (entity = index, state = Current() after the step), so the
+    // orchestrator learns of collapses without scanning the cores and can answer
+    // them with Genesis() between calls. Events of different workers interleave;
+    // a full queue drops (and counts) events. nullptr (the default) disables
+    // reporting. The queue MUST outlive its use.
+    void SetEventQueue(EventQueue* queue) noexcept { events_ = queue; }
+
+    // Fresh Genesis of one entity (MaxCore::Genesis), between Tick() / RunFree()
+    // calls. The entity keeps its input buffer and cursor; a non-terminal
+    // initial_state puts a retired entity back into the active set. Returns false
+    // (nothing changes) if entity is out of range or initial_state is invalid.
+    bool Genesis(size_t entity, const StructuralState& initial_state);
+
+    // Barrier-per-tick mode: every entity with a remaining row consumes exactly
+    // one row (one Step() call, whatever its EventFlag), then all workers meet
+    // at a barrier before Tick() returns.
+    EnsembleStats Tick();
+
+    // Free-running mode: each entity independently consumes up to `max_steps`
+    // rows through MaxCore::StepSequence, stopping after its first COLLAPSE or
+    // ERROR row. There is no barrier between rows; Run returns when every entity
+    // has stopped or exhausted its budget.
+    EnsembleStats RunFree(size_t max_steps = std::numeric_limits<size_t>::max());
+
+    size_t Size() const noexcept { return slots_.size(); }
+    size_t Workers() const noexcept;
+
+    // Number of live (non-terminal) entities; 0 once every entity has collapsed.
+    size_t Live() const noexcept { return live_.size(); }
+
+    // Per-entity views (entity MUST be < Size())
+    const MaxCore& Core(size_t entity) const noexcept { return slots_[entity].core; }
+    size_t Cursor(size_t entity) const noexcept;
+    size_t Remaining(size_t entity) const noexcept;
+    EventFlag LastEvent(size_t entity) const noexcept;
+
+private:
+    struct alignas(64) Slot {
+        explicit Slot(const MaxCore& c) noexcept : core(c) {}
+
+        MaxCore core;
+        EntityInput input{nullptr, 0, 0, 0.0};
+        size_t cursor = 0;  // retired and coasting: the cursor when coasting started
+        EventFlag last = EventFlag::NORMAL;
+        bool retired = false;   // terminal, out of the active set
+        bool coasting = false;  // retired with rows left, consumed by the coast clock
+        uint64_t coast_base = 0;
+        uint64_t epoch = 0;     // bumped by SetInput() / Genesis(); invalidates queued expiries
+    };
+
+    struct alignas(64) WorkerStats {
+        size_t rows = 0;
+        size_t collapsed = 0;
+        size_t errors = 0;
+        size_t retired = 0;
+    };
+
+    // A coasting entity runs out of rows when the coast clock reaches `expiry`.
+    struct CoastExpiry {
+        uint64_t expiry;
+        size_t entity;
+        uint64_t epoch;
+    };
+
+    EnsembleRunner(std::vector<MaxCore>&& cores, size_t workers);
+
+    template <class Fn>
+    EnsembleStats Dispatch(Fn&& per_entity);
+
+    // Pushes a COLLAPSE / ERROR of `entity` to the event queue, if any.
+    void Report(size_t entity, EventFlag ev) const noexcept;
+
+    // Terminal entities consume up to `rows` rows each (1 per Tick, the budget per
+    // RunFree) without being visited. Returns the rows consumed.
+    size_t AdvanceCoast(uint64_t rows);
+
+    // Starts coasting entity `entity` at the current coast clock.
+    void StartCoast(size_t entity);
+
+    std::vector<Slot> slots_;
+    std::vector<WorkerStats> stats_;
+    std::unique_ptr<detail::WorkStealingPool> pool_;
+
+    // Active set (ascending entity indices) and the coast clock of retired entities.
+    std::vector<size_t> live_;
+    std::vector<CoastExpiry> coast_heap_;  // min-heap on expiry
+    uint64_t coast_clock_ = 0;
+    size_t coasting_ = 0;
+
+    EventQueue* events_ = nullptr;
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_ENSEMBLE_H
@@ -0,0 +1,138 @@
+// ==============================
+// File: include/maxcore/entity_store.h
+// ==============================
+#ifndef MAXCORE_ENTITY_STORE_H
+#define MAXCORE_ENTITY_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "maxcore/profile.h"
+#include "maxcore/types.h"
+
+namespace maxcore {
+
+namespace detail {
+class WorkStealingPool;
+}
+
+// One keyed step: entity `id` receives `delta` (Profile().DeltaDim() values) with `dt`.
+// The delta buffer is not copied and MUST stay valid during Apply().
+struct KeyedUpdate {
+    uint64_t id;
+    const double* delta;
+    double dt;
+};
+
+// Totals of one Apply() call.
+struct EntityStoreStats {
+    size_t applied;    // updates processed (== count)
+    size_t inserted;   // entities created on first sight
+    size_t collapsed;  // COLLAPSE events
+    size_t errors;     // ERROR events
+};
+
+// Keyed population of cores sharing one ParameterProfile, replacing
+// std::unordered_map<id, MaxCore>. Entities are spread over shards by a hash of
+// their id; each shard owns an open-addressing table (linear probing, no node
+// allocation) and the structure-of-arrays columns of its entities.
+//
+// Apply() buckets a batch of updates by shard (stable counting sort, so the
+// updates of one id keep their batch order) and runs the shards in parallel on
+// a work-stealing pool. An id seen for the first time is created from the
+// genesis state. Every update runs the MaxCore::Step contract, so each entity
+// is bitwise identical to a MaxCore created from the profile and fed its
+// updates in batch order, for any worker or shard count.
+class EntityStore final {
+public:
+    // Create() is the only construction entry point.
+    // genesis is validated as in MaxCore::Create. shards is rounded up to a power
+    // of two (0 = four per worker); workers == 0 uses the hardware concurrency.
+    static std::optional<EntityStore> Create(
+        const ParameterProfile& profile,
+        const StructuralState& genesis,
+        size_t shards = 0,
+        size_t workers = 0
+    );
+
+    EntityStore(EntityStore&&) noexcept;
+    EntityStore& operator=(EntityStore&&) noexcept;
+    ~EntityStore();
+
+    // Applies `count` updates. events_out (optional, `count` entries) receives the
+    // EventFlag of each update at its batch position. An entity is created even if
+    // its first update is rejected with ERROR (as a MaxCore would be by Create()).
+    EntityStoreStats Apply(const KeyedUpdate* updates, size_t count, EventFlag* events_out = nullptr);
+
+    // Creates `id` with its own initial state. Returns false (nothing changes) if
+    // the id already exists or the state is invalid.
+    bool Insert(uint64_t id, const StructuralState& initial_state);
+
+    bool Contains(uint64_t id) const noexcept;
+    std::optional<StructuralState> Current(uint64_t id) const noexcept;
+    std::optional<StructuralState> Previous(uint64_t id) const noexcept;
+    std::optional<LifecycleContext> Lifecycle(uint64_t id) const noexcept;
+
+    size_t Size() const noexcept;
+    size_t Shards() const noexcept { return shards_.size(); }
+    size_t Workers() const noexcept;
+    const ParameterProfile& Profile() const noexcept { return profile_; }
+
+private:
+    // Open-addressing bucket: slot == 0 marks an empty bucket, else entity slot + 1.
+    struct Bucket {
+        uint64_t key;
+        uint64_t slot;
+    };
+
+    struct alignas(64) Shard {
+        std::vector<Bucket> table;  // power-of-two size, load factor <= 1/2
+
+        // Structure-of-arrays entity columns
+        std::vector<double> phi;
+        std::vector<double> memory;
+        std::vector<double> kappa;
+        std::vector<double> prev_phi;
+        std::vector<double> prev_memory;
+        std::vector<double> prev_kappa;
+        std::vector<uint64_t> step_counter;
+        std::vector<uint8_t> terminal;
+        std::vector<uint8_t> collapse_emitted;
+
+        EntityStoreStats stats;
+
+        // Slot of `key`, or SIZE_MAX.
+        size_t Find(uint64_t key, uint64_t hash) const noexcept;
+        // Slot of `key`, appending an entity from `init` if absent.
+        size_t FindOrInsert(uint64_t key, uint64_t hash, const StructuralState& init, bool& inserted);
+        void Grow();
+    };
+
+    EntityStore(const ParameterProfile& profile, const StructuralState& genesis, size_t shards, size_t workers);
+
+    size_t ShardOf(uint64_t hash) const noexcept;
+    const Shard* Locate(uint64_t id, size_t& slot) const noexcept;
+
+    // MaxCore::Step contract on one entity of a shard.
+    EventFlag StepSlot(Shard& s, size_t slot, const double* delta, double dt) const noexcept;
+
+    ParameterProfile profile_;
+    StructuralState genesis_;
+    unsigned shard_bits_;
+    std::vector<Shard> shards_;
+    std::unique_ptr<detail::WorkStealingPool> pool_;
+
+    // Apply() scratch, reused across calls: id hash of each update, bucket
+    // offsets, the update indices grouped by shard and the per-shard fill cursors.
+    std::vector<uint64_t> update_hash_;
+    std::vector<size_t> offsets_;
+    std::vector<size_t> order_;
+    std::vector<size_t> fill_;
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_ENTITY_STORE_H
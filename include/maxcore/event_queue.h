@@ -0,0 +1,72 @@
+// ==============================
+// File: include/maxcore/event_queue.h
+// ==============================
+#ifndef MAXCORE_EVENT_QUEUE_H
+#define MAXCORE_EVENT_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "maxcore/types.h"
+
+namespace maxcore {
+
+namespace detail {
+struct EventQueueState;
+}
+
+// One event reported by a stepping thread.
+struct CoreEvent {
+    uint64_t entity;        // caller-defined id
+    uint64_t step_counter;  // Lifecycle().step_counter after the step
+    EventFlag event;
+    StructuralState state;  // Current() after the step
+};
+
+// Bounded multi-producer / single-consumer event queue (lock-free ring of
+// sequenced cells). Any number of threads may TryPush() concurrently; exactly
+// one thread at a time may TryPop() / PopBatch(). Producers never block and
+// never allocate: when the ring is full the event is dropped and counted.
+//
+// Events of one producer are dequeued in the order it pushed them; events of
+// different producers interleave in push order.
+class EventQueue final {
+public:
+    // Create() is the only construction entry point.
+    // capacity is rounded up to a power of two. Returns std::nullopt if it is 0,
+    // too large, or the ring cannot be allocated (nothing is thrown).
+    static std::optional<EventQueue> Create(size_t capacity);
+
+    EventQueue(EventQueue&&) noexcept;
+    EventQueue& operator=(EventQueue&&) noexcept;
+    ~EventQueue();
+
+    // Producer side (any thread). Returns false if the queue is full; the event
+    // is then dropped and Dropped() incremented.
+    bool TryPush(const CoreEvent& ev) noexcept;
+
+    // Consumer side (one thread at a time).
+    bool TryPop(CoreEvent& out) noexcept;
+
+    // Moves up to max_count events to out, oldest first. Returns the count.
+    size_t PopBatch(CoreEvent* out, size_t max_count) noexcept;
+
+    size_t Capacity() const noexcept;
+
+    // Approximate number of queued events (exact when no push or pop runs).
+    size_t SizeApprox() const noexcept;
+
+    // Events rejected because the queue was full, since creation.
+    uint64_t Dropped() const noexcept;
+
+private:
+    explicit EventQueue(std::unique_ptr<detail::EventQueueState> state) noexcept;
+
+    std::unique_ptr<detail::EventQueueState> state_;
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_EVENT_QUEUE_H
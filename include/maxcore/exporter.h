@@ -0,0 +1,121 @@
+// ==============================
+// File: include/maxcore/exporter.h
+// ==============================
+#ifndef MAXCORE_EXPORTER_H
+#define MAXCORE_EXPORTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "maxcore/derived.h"
+#include "maxcore/maxcore.h"
+
+namespace maxcore {
+
+// Text export of pipeline rows (CSV or JSON Lines).
+//
+// Stable schema, in this order (CSV header / JSONL keys):
+//   t, lifecycle, step_counter, event, terminal, collapse_emitted,
+//   phi, memory, kappa,
+//   d_phi, d_memory, d_kappa, phi_rate, memory_rate, kappa_rate,
+//   kappa_ratio, kappa_distance, load_term, regen_term
+//
+// event is NORMAL / COLLAPSE / ERROR. CSV writes flags as 1/0, JSONL as
+// true/false. Non-finite doubles are written as nan / inf (CSV) or null (JSONL).
+
+enum class ExportFormat : uint8_t {
+    CSV = 0,
+    JSONL = 1
+};
+
+struct ExportOptions {
+    ExportFormat format = ExportFormat::CSV;
+
+    // < 0: shortest representation that round-trips to the same double.
+    // 0..kMaxExportPrecision: fixed notation with that many decimals
+    // (same text as printf("%.Nf")).
+    int precision = -1;
+
+    // Size of the output block. Rows are formatted into the block and the
+    // block is written with one call when the next row might not fit.
+    size_t block_bytes = size_t(1) << 20;
+};
+
+constexpr int kMaxExportPrecision = 17;
+
+// Upper bound of one formatted row (19 fields, fixed notation of DBL_MAX).
+constexpr size_t kMaxExportRowBytes = 8192;
+
+class TextExporter final {
+public:
+    // Create() is the only construction entry point. Opens (truncates) `path`
+    // and writes the CSV header line. Returns std::nullopt if precision is out
+    // of range, block_bytes < kMaxExportRowBytes, or the file cannot be opened.
+    static std::optional<TextExporter> Create(const std::string& path, const ExportOptions& options = {});
+
+    TextExporter(TextExporter&&) noexcept = default;
+    // Closes (flushes) the file this exporter still has open before taking over `other`.
+    TextExporter& operator=(TextExporter&& other) noexcept;
+    ~TextExporter();
+
+    // Formats one row into the block. Returns false once any write has failed
+    // (the failure is sticky).
+    bool Append(
+        uint64_t t,
+        uint64_t lifecycle_id,
+        EventFlag event,
+        const StructuralState& state,
+        const LifecycleContext& lifecycle,
+        const DerivedFrame& derived
+    ) noexcept;
+
+    bool Append(uint64_t t, uint64_t lifecycle_id, EventFlag event, const MaxCore& core, const DerivedFrame& derived) noexcept;
+
+    // Writes the pending block. Returns false if any write failed.
+    bool Flush() noexcept;
+
+    // Flush() and close the file. Also run by the destructor.
+    bool Close() noexcept;
+
+    uint64_t Rows() const noexcept { return rows_; }
+    const ExportOptions& Options() const noexcept { return options_; }
+
+    // Formats one row (including the trailing '\n') into `out`, which MUST hold
+    // at least kMaxExportRowBytes bytes. Returns the number of bytes written.
+    static size_t FormatRow(
+        char* out,
+        const ExportOptions& options,
+        uint64_t t,
+        uint64_t lifecycle_id,
+        EventFlag event,
+        const StructuralState& state,
+        const LifecycleContext& lifecycle,
+        const DerivedFrame& derived
+    ) noexcept;
+
+    // CSV header line (including '\n'); empty for JSONL.
+    static std::string Header(ExportFormat format);
+
+private:
+    struct FileCloser {
+        void operator()(std::FILE* f) const noexcept;
+    };
+
+    TextExporter(std::FILE* file, const ExportOptions& options);
+
+    std::unique_ptr<std::FILE, FileCloser> file_;
+    ExportOptions options_;
+    std::vector<char> block_;
+    size_t used_ = 0;
+    uint64_t rows_ = 0;
+    bool ok_ = true;
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_EXPORTER_H
@@ -0,0 +1,105 @@
+// ==============================
+// File: include/maxcore/fixed.h
+// ==============================
+#ifndef MAXCORE_FIXED_H
+#define MAXCORE_FIXED_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "maxcore/maxcore.h"
+
+namespace maxcore {
+
+namespace detail {
+
+// Fully unrolled sum of squares in the canonical left-to-right order:
+// norm2 = ((0 + v0*v0) + v1*v1) + ... , identical to the serial loop of MaxCore::Step.
+template <size_t... I>
+inline double fixed_norm2(const double* v, bool& finite, std::index_sequence<I...>) noexcept {
+    finite = ((std::isfinite(v[I]) != 0) && ...);
+
+    double norm2 = 0.0;
+    ((norm2 += v[I] * v[I]), ...);
+    return norm2;
+}
+
+} // namespace detail
+
+// Compile-time specialized engine for a fixed delta dimension.
+// The dimension check of MaxCore::Step is resolved at compile time and the
+// norm2 loop is fully unrolled; validation, update and commit are delegated to
+// the wrapped MaxCore, so trajectories are bitwise identical to MaxCore::Step.
+//
+// Dims 2, 3 and 8 are instantiated inside the library (strict FP flags apply).
+// Other dims are instantiated in the caller's translation unit and MUST be
+// compiled with the same strict FP flags to keep bitwise parity.
+template <size_t Dim>
+class MaxCoreFixed final {
+    static_assert(Dim > 0, "MaxCoreFixed requires Dim > 0");
+
+public:
+    // Create() is the only construction entry point (same validation as MaxCore::Create).
+    static std::optional<MaxCoreFixed> Create(
+        const ParameterSet& params,
+        const StructuralState& initial_state,
+        std::optional<double> delta_max = std::nullopt
+    );
+
+    // Step() follows the MaxCore::Step contract for a Dim-sized delta.
+    EventFlag Step(const std::array<double, Dim>& delta_input, double dt);
+    EventFlag Step(const double (&delta_input)[Dim], double dt);
+
+    const StructuralState& Current() const noexcept { return core_.Current(); }
+    const StructuralState& Previous() const noexcept { return core_.Previous(); }
+    const LifecycleContext& Lifecycle() const noexcept { return core_.Lifecycle(); }
+
+    // Underlying runtime-dimension core (shares state with this instance).
+    const MaxCore& Core() const noexcept { return core_; }
+
+private:
+    explicit MaxCoreFixed(const MaxCore& core) noexcept : core_(core) {}
+
+    EventFlag StepRow(const double* delta_input, double dt);
+
+    MaxCore core_;
+};
+
+template <size_t Dim>
+std::optional<MaxCoreFixed<Dim>> MaxCoreFixed<Dim>::Create(
+    const ParameterSet& params,
+    const StructuralState& initial_state,
+    std::optional<double> delta_max
+) {
+    auto core_opt = MaxCore::Create(params, Dim, initial_state, delta_max);
+    if (!core_opt) return std::nullopt;
+    return MaxCoreFixed(*core_opt);
+}
+
+template <size_t Dim>
+EventFlag MaxCoreFixed<Dim>::Step(const std::array<double, Dim>& delta_input, double dt) {
+    return StepRow(delta_input.data(), dt);
+}
+
+template <size_t Dim>
+EventFlag MaxCoreFixed<Dim>::Step(const double (&delta_input)[Dim], double dt) {
+    return StepRow(delta_input, dt);
+}
+
+template <size_t Dim>
+EventFlag MaxCoreFixed<Dim>::StepRow(const double* delta_input, double dt) {
+    bool finite = false;
+    const double norm2 = detail::fixed_norm2(delta_input, finite, std::make_index_sequence<Dim>{});
+    return core_.StepNorm2(delta_input, finite, norm2, dt);
+}
+
+extern template class MaxCoreFixed<2>;
+extern template class MaxCoreFixed<3>;
+extern template class MaxCoreFixed<8>;
+
+} // namespace maxcore
+
+#endif // MAXCORE_FIXED_H
@@ -0,0 +1,119 @@
+// ==============================
+// File: include/maxcore/lazy_store.h
+// ==============================
+#ifndef MAXCORE_LAZY_STORE_H
+#define MAXCORE_LAZY_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "maxcore/profile.h"
+#include "maxcore/types.h"
+
+namespace maxcore {
+
+// How an entity replays the ticks it skipped (all with a zero delta).
+enum class CatchUpMode : uint8_t {
+    CLOSED_FORM = 0, // opt-in: certified affine jumps, exact steps near a collapse (MaxCore::Advance)
+    EXACT = 1        // default: one canonical step per skipped tick (bitwise identical, O(gap))
+};
+
+// A COLLAPSE returned by the step of `tick` for `entity`.
+struct CollapseRecord {
+    size_t entity;
+    uint64_t tick;
+};
+
+// Entity store for populations where most entities are idle on most ticks.
+//
+// The eager model it reproduces: on every tick each entity is stepped once with
+// the store's dt, receiving its Input() delta if it got one during the tick and
+// a zero delta otherwise. Here Tick() is O(1): an entity remembers the first
+// tick it has not processed yet and replays the skipped zero-delta ticks only
+// when it is touched (Input) or read (Current / Previous / Lifecycle / Sync).
+// Per-tick cost therefore scales with the number of active entities.
+//
+// With EXACT (the default), states, events, step_counter, terminal /
+// collapse_emitted and the tick of every collapse are bitwise those of eager
+// stepping; a collapse inside a skipped gap is reported with the tick it would
+// have occurred on. CLOSED_FORM trades that for O(log gap) catch-up: states
+// agree with eager stepping only up to closed-form rounding, and since that
+// rounding carries over from one gap to the next, a collapse at a rounding-level
+// tie may be reported (and committed) one tick away from eager stepping.
+class LazyEntityStore final {
+public:
+    // Create() is the only construction entry point.
+    // dt is fixed for the store and validated here (dt * max_rate < 1).
+    static std::optional<LazyEntityStore> Create(
+        const ParameterProfile& profile,
+        double dt,
+        CatchUpMode mode = CatchUpMode::EXACT
+    );
+
+    // Adds an entity whose first step is the current tick. Returns its id
+    // (ids are dense, in insertion order) or std::nullopt if the state is invalid.
+    std::optional<size_t> Add(const StructuralState& initial_state);
+
+    // Input of `entity` for the current tick: catches up the skipped ticks, then
+    // runs the MaxCore::Step contract on delta. Returns that step's EventFlag.
+    // The step consumes the entity's tick whatever its outcome (an ERROR step is
+    // not replaced by a zero-delta step). A second Input() for the same entity
+    // in the same tick returns ERROR without mutation. `entity` MUST be < Size().
+    EventFlag Input(size_t entity, const double* delta_input, size_t delta_len);
+
+    // Ends the current tick; entities without input this tick implicitly stepped
+    // with a zero delta. O(1).
+    void Tick() noexcept { now_ += 1u; }
+
+    // Brings `entity` (or every entity) up to date with all completed ticks.
+    void Sync(size_t entity);
+    void SyncAll();
+
+    // Reads catch the entity up first, so they reflect every completed tick.
+    const StructuralState& Current(size_t entity);
+    const StructuralState& Previous(size_t entity);
+    LifecycleContext Lifecycle(size_t entity);
+
+    // Current tick (number of completed Tick() calls).
+    uint64_t Now() const noexcept { return now_; }
+    size_t Size() const noexcept { return entities_.size(); }
+    double Dt() const noexcept { return dt_; }
+    const ParameterProfile& Profile() const noexcept { return profile_; }
+
+    // Every COLLAPSE in order of detection (catch-up or Input). Entries of a
+    // skipped gap appear when the entity is next touched or read.
+    const std::vector<CollapseRecord>& Collapses() const noexcept { return collapses_; }
+    void ClearCollapses() noexcept { collapses_.clear(); }
+
+private:
+    // One record per entity: entities are touched in arbitrary order, so all of
+    // an entity's fields sit together.
+    struct Entity {
+        StructuralState current;
+        StructuralState previous;
+        LifecycleContext lifecycle;
+        uint64_t next_tick;  // first tick not processed yet
+    };
+
+    LazyEntityStore(const ParameterProfile& profile, double dt, CatchUpMode mode) noexcept;
+
+    // Replays the zero-delta ticks [next_tick, now_) of entity `id`.
+    void CatchUp(size_t id, Entity& e);
+
+    // 4-12) Canonical commit of tick `tick` for an admitted norm2; logs a collapse.
+    EventFlag Commit(size_t id, Entity& e, double norm2, uint64_t tick);
+
+    ParameterProfile profile_;
+    double dt_;
+    CatchUpMode mode_;
+    uint64_t now_;
+
+    std::vector<Entity> entities_;
+    std::vector<CollapseRecord> collapses_;
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_LAZY_STORE_H
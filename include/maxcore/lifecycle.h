@@ -0,0 +1,74 @@
+// ==============================
+// File: include/maxcore/lifecycle.h
+// ==============================
+#ifndef MAXCORE_LIFECYCLE_H
+#define MAXCORE_LIFECYCLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "maxcore/maxcore.h"
+
+namespace maxcore {
+
+// Summary of one lifecycle (from genesis to the next Genesis() call).
+struct LifecycleSummary {
+    uint64_t lifecycle_id;  // 0 for the lifecycle started by Create()
+    uint64_t length;        // committed steps (step_counter at the end of the lifecycle)
+    double min_kappa;       // minimum kappa over the genesis and all committed states
+    bool collapsed;         // the lifecycle ended in COLLAPSE
+};
+
+// External Fresh Genesis orchestration around one MaxCore.
+// The core never restarts by itself: Step() only records, Genesis() is the
+// explicit lifecycle boundary. Genesis reuses the already-validated params
+// and genesis state, so a restart costs a state reset instead of Create().
+class LifecycleRunner final {
+public:
+    // Create() is the only construction entry point.
+    // genesis_state is the initial state of every lifecycle.
+    // Returns std::nullopt on any validation failure (same rules as MaxCore::Create).
+    static std::optional<LifecycleRunner> Create(
+        const ParameterSet& params,
+        size_t delta_dim,
+        const StructuralState& genesis_state,
+        std::optional<double> delta_max = std::nullopt
+    );
+
+    // Forwards to MaxCore::Step() and updates the running summary.
+    EventFlag Step(const double* delta_input, size_t delta_len, double dt);
+
+    // Forwards to MaxCore::StepWithDerived() and updates the running summary.
+    EventFlag StepWithDerived(const double* delta_input, size_t delta_len, double dt, std::optional<DerivedFrame>& derived);
+
+    // Closes the current lifecycle (its summary is appended to History()),
+    // resets the core in place to the genesis state and increments LifecycleId().
+    // Returns the summary of the closed lifecycle.
+    LifecycleSummary Genesis();
+
+    const MaxCore& Core() const noexcept { return core_; }
+    uint64_t LifecycleId() const noexcept { return lifecycle_id_; }
+
+    // Summary of the lifecycle in progress.
+    LifecycleSummary Running() const noexcept;
+
+    // Summaries of all closed lifecycles, oldest first. ClearHistory() lets
+    // long-running callers drain it; lifecycle ids keep counting.
+    const std::vector<LifecycleSummary>& History() const noexcept { return history_; }
+    void ClearHistory() noexcept { history_.clear(); }
+
+private:
+    LifecycleRunner(const MaxCore& core, const StructuralState& genesis_state) noexcept;
+
+    MaxCore core_;
+    StructuralState genesis_;
+    uint64_t lifecycle_id_ = 0;
+    double min_kappa_;
+    std::vector<LifecycleSummary> history_;
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_LIFECYCLE_H
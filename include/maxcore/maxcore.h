@@ -6,19 +6,31 @@
 
 #include <cstddef>
 #include <optional>
+#include "derived.h"
+#include "reduction.h"
 #include "types.h"
 
 namespace maxcore {
 
+template <size_t Dim>
+class MaxCoreFixed;
+
+namespace detail {
+struct SnapshotAccess;
+struct PredictAccess;
+}
+
 class MaxCore final {
 public:
     // Create() is the only construction entry point.
     // Returns std::nullopt on any validation failure.
+    // reduction selects the norm2 order (SERIAL is the canonical specification order).
     static std::optional<MaxCore> Create(
         const ParameterSet& params,
         size_t delta_dim,
         const StructuralState& initial_state,
-        std::optional<double> delta_max = std::nullopt
+        std::optional<double> delta_max = std::nullopt,
+        ReductionMode reduction = ReductionMode::SERIAL
     );
 
     // Step() is the only mutation authority.
@@ -31,22 +43,145 @@ public:
         double dt
     );
 
+    // Same as above; `status` receives the reason (OK, TERMINAL or the failed check).
+    EventFlag Step(
+        const double* delta_input,
+        size_t delta_len,
+        double dt,
+        StepStatus& status
+    );
+
+    // StepWithDerived() is Step() followed by ComputeDerived(Current(), Previous(),
+    // Lifecycle(), params, dt), fused: on commit the frame is filled from the
+    // committed values (the load products are reused from the Kappa update) without
+    // revalidating state. `derived` holds exactly what the two-call sequence
+    // returns, including std::nullopt, for every event.
+    EventFlag StepWithDerived(
+        const double* delta_input,
+        size_t delta_len,
+        double dt,
+        std::optional<DerivedFrame>& derived
+    );
+
+    EventFlag StepWithDerived(
+        const double* delta_input,
+        size_t delta_len,
+        double dt,
+        std::optional<DerivedFrame>& derived,
+        StepStatus& status
+    );
+
+    // StepSequence() runs Step() over a block of `steps` delta rows.
+    // Row i starts at deltas + i * stride and holds delta_dim values (stride >= delta_dim).
+    // Pointer, stride, dt and the stability bound are validated once per call.
+    // Stops at the first COLLAPSE (committed) or ERROR (not committed).
+    // A terminal core short-circuits: nothing is committed and NORMAL is reported.
+    SequenceResult StepSequence(
+        const double* deltas,
+        size_t steps,
+        size_t stride,
+        double dt
+    );
+
+    // Same as above with one dt per row (dts[i] applies to row i).
+    // Each dt is still checked against the stability bound, max_rate is hoisted.
+    SequenceResult StepSequence(
+        const double* deltas,
+        size_t steps,
+        size_t stride,
+        const double* dts
+    );
+
+    // Advance() is equivalent to k calls of Step() with the same delta and dt.
+    // Validation runs once. Collapse-free stretches are jumped in closed form
+    // (affine map raised by exponentiation by squaring); steps near a possible
+    // collapse, and the final step, are executed exactly. Returns COLLAPSE if
+    // Kappa reaches 0 within the k steps (stops there), ERROR on invalid input
+    // (no mutation by the failing step), NORMAL otherwise. The EventFlag and
+    // step_counter (hence the collapse step) are those of k Step() calls; jumped
+    // states agree with stepped ones up to closed-form rounding.
+    //
+    // Cost: O(log k) while Kappa's certified lower bound stays above
+    // kappa_max * 1e-6. Once it does not (a collapse within the call, or Kappa
+    // settling that close to 0), steps run exactly, and if an exact step after a
+    // jump lands within that margin of the collapse threshold the call restarts
+    // with k exact steps from its initial state. Worst case O(k), at most 2k steps.
+    EventFlag Advance(
+        const double* delta_input,
+        size_t delta_len,
+        double dt,
+        uint64_t k
+    );
+
+    // Genesis() starts a fresh lifecycle in place (Fresh Genesis without Create()).
+    // Params, delta_dim, delta_max and reduction are kept as already validated;
+    // only initial_state is validated, exactly as in Create(). On success Current()
+    // and Previous() become initial_state and the lifecycle restarts at step 0, so the
+    // core is indistinguishable from a fresh Create(). Returns false (no mutation)
+    // if initial_state is invalid.
+    bool Genesis(const StructuralState& initial_state) noexcept;
+
     const StructuralState& Current() const noexcept { return current_; }
     const StructuralState& Previous() const noexcept { return previous_; }
     const LifecycleContext& Lifecycle() const noexcept { return lifecycle_; }
+    size_t DeltaDim() const noexcept { return delta_dim_; }
+    const ParameterSet& Params() const noexcept { return params_; }
+    const std::optional<double>& DeltaMax() const noexcept { return delta_max_; }
+    ReductionMode Reduction() const noexcept { return reduction_; }
 
 private:
     MaxCore(
         const ParameterSet& params,
         size_t delta_dim,
         const StructuralState& initial_state,
-        std::optional<double> delta_max
+        std::optional<double> delta_max,
+        ReductionMode reduction
     ) noexcept;
 
+    template <size_t Dim>
+    friend class MaxCoreFixed;
+    friend struct detail::SnapshotAccess;
+    friend struct detail::PredictAccess;
+
+    // Phase 5: norm2 in the configured reduction order (false on non-finite input).
+    bool AccumulateNorm2(const double* delta_input, double& norm2) const noexcept;
+
+    // Phases 1-12 of Step() with the outcome reason and the committed load products.
+    EventFlag StepChecked(
+        const double* delta_input,
+        size_t delta_len,
+        double dt,
+        StepStatus& status,
+        double& load_phi,
+        double& load_m
+    ) noexcept;
+
+    // Phases 5-12 of Step() for an input whose pointer, length and dt are already admitted.
+    EventFlag StepAdmitted(const double* delta_input, double dt) noexcept;
+
+    // Step() for a row of delta_dim values whose norm2 MaxCoreFixed<Dim> accumulated
+    // (detail::canonical_step_norm2: phases 1-3, then 5-12 from norm2).
+    EventFlag StepNorm2(const double* delta_input, bool delta_finite, double norm2, double dt) noexcept;
+
+    // Advance() without the exact restart: validation, then detail::affine_advance
+    // (`jumped` / `tie` as documented there). Chained calls keep `jumped` across segments.
+    EventFlag AdvanceChained(
+        const double* delta_input,
+        size_t delta_len,
+        double dt,
+        uint64_t k,
+        bool& jumped,
+        bool& tie
+    );
+
+    // Phases 5b-12: norm guard, canonical update, collapse detection and commit.
+    EventFlag CommitNorm2(double norm2, double dt) noexcept;
+
     // Persistent immutable configuration
     ParameterSet params_;
     size_t delta_dim_;
     std::optional<double> delta_max_;
+    ReductionMode reduction_;
 
     // Persistent structural state
     StructuralState current_;
@@ -0,0 +1,100 @@
+// ==============================
+// File: include/maxcore/predict.h
+// ==============================
+#ifndef MAXCORE_PREDICT_H
+#define MAXCORE_PREDICT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "maxcore/maxcore.h"
+
+namespace maxcore {
+
+// One piece of a piecewise-constant input: `steps` repetitions of one delta row.
+struct DeltaSegment {
+    const double* delta;
+    uint64_t steps;
+};
+
+// Non-owning description of the input a core would receive.
+// Pointers MUST stay valid for the duration of PredictCollapse().
+class DeltaSource final {
+public:
+    enum class Kind : uint8_t {
+        CONSTANT = 0,  // the same row forever
+        PIECEWISE = 1, // segments in order; the source ends after the last segment
+        STREAM = 2     // arbitrary rows (steps x stride); the source ends after the last row
+    };
+
+    static DeltaSource Constant(const double* delta, size_t delta_len) noexcept {
+        return DeltaSource(Kind::CONSTANT, delta, delta_len, nullptr, 0, 0, 0);
+    }
+
+    static DeltaSource Piecewise(const DeltaSegment* segments, size_t count, size_t delta_len) noexcept {
+        return DeltaSource(Kind::PIECEWISE, nullptr, delta_len, segments, count, 0, 0);
+    }
+
+    static DeltaSource Stream(const double* deltas, size_t steps, size_t stride, size_t delta_len) noexcept {
+        return DeltaSource(Kind::STREAM, deltas, delta_len, nullptr, 0, steps, stride);
+    }
+
+    Kind GetKind() const noexcept { return kind_; }
+    size_t DeltaLen() const noexcept { return delta_len_; }
+    const double* Rows() const noexcept { return rows_; }
+    const DeltaSegment* Segments() const noexcept { return segments_; }
+    size_t SegmentCount() const noexcept { return segment_count_; }
+    size_t Steps() const noexcept { return steps_; }
+    size_t Stride() const noexcept { return stride_; }
+
+private:
+    DeltaSource(
+        Kind kind,
+        const double* rows,
+        size_t delta_len,
+        const DeltaSegment* segments,
+        size_t segment_count,
+        size_t steps,
+        size_t stride
+    ) noexcept
+        : kind_(kind),
+          rows_(rows),
+          delta_len_(delta_len),
+          segments_(segments),
+          segment_count_(segment_count),
+          steps_(steps),
+          stride_(stride) {}
+
+    Kind kind_;
+    const double* rows_;
+    size_t delta_len_;
+    const DeltaSegment* segments_;
+    size_t segment_count_;
+    size_t steps_;
+    size_t stride_;
+};
+
+// Returns the 0-based index (relative to this call) of the first Step() that would
+// return COLLAPSE when `core` is fed `source` with a constant dt, looking at most
+// `horizon` steps ahead. Returns std::nullopt if no collapse occurs within the
+// horizon, the source ends first, the core is already terminal, or a step would
+// return ERROR.
+//
+// The core is not mutated, and the index always equals that of a Step() loop.
+// Constant and piecewise-constant sources use the closed-form fast-forward of
+// MaxCore::Advance only to bracket the collapse: exact steps taken from a jumped
+// state must clear the collapse margin, and if one lands on a rounding-level tie
+// the query is re-run from `core` with plain steps (O(index), or O(horizon)
+// without a collapse). Streams use the early-exit block loop of
+// MaxCore::StepSequence.
+std::optional<uint64_t> PredictCollapse(
+    const MaxCore& core,
+    const DeltaSource& source,
+    double dt,
+    uint64_t horizon
+);
+
+} // namespace maxcore
+
+#endif // MAXCORE_PREDICT_H
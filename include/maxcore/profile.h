@@ -0,0 +1,76 @@
+// ==============================
+// File: include/maxcore/profile.h
+// ==============================
+#ifndef MAXCORE_PROFILE_H
+#define MAXCORE_PROFILE_H
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+#include "reduction.h"
+#include "types.h"
+
+namespace maxcore {
+
+namespace detail {
+
+// Shared block behind a ParameterProfile. Immutable after creation except for
+// the reference count.
+struct ProfileData {
+    ParameterSet params;
+    size_t delta_dim;
+    std::optional<double> delta_max;
+    ReductionMode reduction;
+    double max_rate;  // detail::max_rate(params), hoisted out of every Step()
+    mutable std::atomic<size_t> refs;
+};
+
+} // namespace detail
+
+// Validated, immutable configuration shared by many cores (flyweight).
+// A profile is an 8-byte intrusive reference: copies share one block and the
+// block lives as long as any copy (or any core created from it). Copies may be
+// made and destroyed concurrently from different threads. Moves share the block
+// too (move-assignment swaps), so a moved-from profile stays fully usable.
+class ParameterProfile final {
+public:
+    // Create() is the only construction entry point.
+    // Same validation as MaxCore::Create for everything except the initial state.
+    static std::optional<ParameterProfile> Create(
+        const ParameterSet& params,
+        size_t delta_dim,
+        std::optional<double> delta_max = std::nullopt,
+        ReductionMode reduction = ReductionMode::SERIAL
+    );
+
+    ParameterProfile(const ParameterProfile& other) noexcept;
+    ParameterProfile(ParameterProfile&& other) noexcept;
+    ParameterProfile& operator=(const ParameterProfile& other) noexcept;
+    ParameterProfile& operator=(ParameterProfile&& other) noexcept;
+    ~ParameterProfile();
+
+    const ParameterSet& Params() const noexcept { return data_->params; }
+    size_t DeltaDim() const noexcept { return data_->delta_dim; }
+    const std::optional<double>& DeltaMax() const noexcept { return data_->delta_max; }
+    ReductionMode Reduction() const noexcept { return data_->reduction; }
+    double MaxRate() const noexcept { return data_->max_rate; }
+
+    // Number of live references (profiles and cores) to the shared block.
+    size_t UseCount() const noexcept { return data_->refs.load(std::memory_order_relaxed); }
+
+    // Identity, not value: two profiles are equal iff they share one block.
+    bool operator==(const ParameterProfile& other) const noexcept { return data_ == other.data_; }
+    bool operator!=(const ParameterProfile& other) const noexcept { return data_ != other.data_; }
+
+private:
+    explicit ParameterProfile(detail::ProfileData* data) noexcept : data_(data) {}
+
+    void Release() noexcept;
+
+    detail::ProfileData* data_;  // never null
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_PROFILE_H
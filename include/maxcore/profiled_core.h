@@ -0,0 +1,104 @@
+// ==============================
+// File: include/maxcore/profiled_core.h
+// ==============================
+#ifndef MAXCORE_PROFILED_CORE_H
+#define MAXCORE_PROFILED_CORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+#include "maxcore/profile.h"
+#include "maxcore/types.h"
+
+namespace maxcore {
+
+namespace detail {
+
+// Previous-state slot, present only when KeepPrevious (empty base otherwise).
+template <bool KeepPrevious>
+struct PreviousSlot {
+    StructuralState previous_;
+};
+
+template <>
+struct PreviousSlot<false> {};
+
+} // namespace detail
+
+// Compact engine for large populations sharing a few parameter sets.
+// Configuration lives in a shared ParameterProfile; the instance holds only the
+// profile reference, the structural state and a packed lifecycle word. Step()
+// follows the MaxCore::Step contract and is bitwise identical to a MaxCore
+// created with the profile's configuration (same kernel, same order).
+//
+// KeepPrevious = false ("lean") drops Previous() (about 40 bytes per instance);
+// use it when ComputeDerived is never needed. The profile is fixed for the
+// lifetime of the instance, including across Genesis().
+//
+// step_counter is stored in 62 bits.
+template <bool KeepPrevious>
+class BasicProfiledCore final : private detail::PreviousSlot<KeepPrevious> {
+public:
+    // Create() is the only construction entry point.
+    // Returns std::nullopt if initial_state is invalid for the profile.
+    static std::optional<BasicProfiledCore> Create(
+        const ParameterProfile& profile,
+        const StructuralState& initial_state
+    );
+
+    // Step() is the only mutation authority (MaxCore::Step contract).
+    EventFlag Step(
+        const double* delta_input,
+        size_t delta_len,
+        double dt
+    ) noexcept;
+
+    // Same as above; `status` receives the reason (OK, TERMINAL or the failed check).
+    EventFlag Step(
+        const double* delta_input,
+        size_t delta_len,
+        double dt,
+        StepStatus& status
+    ) noexcept;
+
+    // Fresh lifecycle in place (MaxCore::Genesis contract); the profile is kept.
+    bool Genesis(const StructuralState& initial_state) noexcept;
+
+    const StructuralState& Current() const noexcept { return current_; }
+
+    template <bool K = KeepPrevious, typename = std::enable_if_t<K>>
+    const StructuralState& Previous() const noexcept {
+        return this->previous_;
+    }
+
+    LifecycleContext Lifecycle() const noexcept {
+        return LifecycleContext{lifecycle_ >> kCounterShift, (lifecycle_ & kTerminalBit) != 0u,
+                                (lifecycle_ & kCollapseBit) != 0u};
+    }
+
+    const ParameterProfile& Profile() const noexcept { return profile_; }
+    size_t DeltaDim() const noexcept { return profile_.DeltaDim(); }
+
+private:
+    static constexpr uint64_t kTerminalBit = 1u;
+    static constexpr uint64_t kCollapseBit = 2u;
+    static constexpr unsigned kCounterShift = 2u;
+
+    BasicProfiledCore(const ParameterProfile& profile, const StructuralState& initial_state) noexcept;
+
+    ParameterProfile profile_;
+    StructuralState current_;
+    uint64_t lifecycle_;  // step_counter << 2 | collapse_emitted << 1 | terminal
+};
+
+using ProfiledCore = BasicProfiledCore<true>;
+using LeanCore = BasicProfiledCore<false>;
+
+extern template class BasicProfiledCore<true>;
+extern template class BasicProfiledCore<false>;
+
+} // namespace maxcore
+
+#endif // MAXCORE_PROFILED_CORE_H
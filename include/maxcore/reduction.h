@@ -0,0 +1,50 @@
+// ==============================
+// File: include/maxcore/reduction.h
+// ==============================
+#ifndef MAXCORE_REDUCTION_H
+#define MAXCORE_REDUCTION_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace maxcore {
+
+// Sum-of-squares reduction used by Step() for ||delta||^2.
+enum class ReductionMode : uint8_t {
+    // Canonical serial loop: norm2 = ((0 + v0^2) + v1^2) + ... (default, specification order)
+    SERIAL = 0,
+
+    // Fixed 4-lane partition (opt-in, SIMD accelerated):
+    //   s_j = (((0 + v_j^2) + v_{j+4}^2) + v_{j+8}^2) + ...   for j = 0..3
+    //   norm2 = (s_0 + s_1) + (s_2 + s_3)
+    // Every ISA implements exactly this order, so results are bitwise reproducible
+    // across runs and ISA levels. They are NOT bitwise equal to SERIAL for dim > 2.
+    LANES4 = 1
+};
+
+enum class ReductionIsa : uint8_t {
+    SCALAR = 0,
+    SSE2 = 1,
+    AVX2 = 2
+};
+
+// True if the running CPU (and this build) can execute the given ISA kernel.
+bool ReductionIsaSupported(ReductionIsa isa) noexcept;
+
+// Widest supported ISA (resolved once per process).
+ReductionIsa BestReductionIsa() noexcept;
+
+// Scalar reference implementation of the LANES4 order.
+double Norm2Lanes4Reference(const double* v, size_t n) noexcept;
+
+// LANES4 order executed with the given ISA (unsupported ISAs fall back to SCALAR).
+// Result is bitwise identical to Norm2Lanes4Reference for every ISA.
+// Non-finite components propagate to a non-finite result.
+double Norm2Lanes4(const double* v, size_t n, ReductionIsa isa) noexcept;
+
+// LANES4 order executed with BestReductionIsa().
+double Norm2Lanes4(const double* v, size_t n) noexcept;
+
+} // namespace maxcore
+
+#endif // MAXCORE_REDUCTION_H
@@ -0,0 +1,106 @@
+// ==============================
+// File: include/maxcore/scalar_core.h
+// ==============================
+#ifndef MAXCORE_SCALAR_CORE_H
+#define MAXCORE_SCALAR_CORE_H
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+#include "maxcore/types.h"
+
+namespace maxcore {
+
+// Rounds a parameter set / state to another scalar type (one conversion per field).
+template <typename To, typename From>
+BasicParameterSet<To> ParamsAs(const BasicParameterSet<From>& p) noexcept {
+    return BasicParameterSet<To>{static_cast<To>(p.alpha),      static_cast<To>(p.eta),
+                                 static_cast<To>(p.beta),       static_cast<To>(p.gamma),
+                                 static_cast<To>(p.rho),        static_cast<To>(p.lambda_phi),
+                                 static_cast<To>(p.lambda_m),   static_cast<To>(p.kappa_max)};
+}
+
+template <typename To, typename From>
+BasicStructuralState<To> StateAs(const BasicStructuralState<From>& s) noexcept {
+    return BasicStructuralState<To>{static_cast<To>(s.phi), static_cast<To>(s.memory), static_cast<To>(s.kappa)};
+}
+
+// Scalar-generic engine: the MaxCore::Step contract (validation order, clamps,
+// terminal short-circuit, single COLLAPSE edge, StepStatus reasons) evaluated
+// entirely in Scalar by the shared kernel. Params, states, delta and dt are
+// Scalar; validation runs on those values, so a double configuration rounded
+// to float is validated as float (e.g. a coefficient that underflows to 0 is
+// rejected).
+//
+// MaxCoreT<double> is bitwise identical to MaxCore with ReductionMode::SERIAL;
+// MaxCoreT<float> halves the state and input footprint at single-precision
+// accuracy. MaxCore remains the full-featured engine (StepSequence, Advance,
+// StepWithDerived, LANES4).
+template <typename Scalar>
+class MaxCoreT final {
+    static_assert(std::is_same_v<Scalar, double> || std::is_same_v<Scalar, float>,
+                  "MaxCoreT supports double and float");
+
+public:
+    using State = BasicStructuralState<Scalar>;
+    using Parameters = BasicParameterSet<Scalar>;
+
+    // Create() is the only construction entry point.
+    // Returns std::nullopt on any validation failure (same checks as MaxCore::Create).
+    static std::optional<MaxCoreT> Create(
+        const Parameters& params,
+        size_t delta_dim,
+        const State& initial_state,
+        std::optional<Scalar> delta_max = std::nullopt
+    );
+
+    // Step() is the only mutation authority (MaxCore::Step contract).
+    EventFlag Step(
+        const Scalar* delta_input,
+        size_t delta_len,
+        Scalar dt
+    ) noexcept;
+
+    // Same as above; `status` receives the reason (OK, TERMINAL or the failed check).
+    EventFlag Step(
+        const Scalar* delta_input,
+        size_t delta_len,
+        Scalar dt,
+        StepStatus& status
+    ) noexcept;
+
+    // Fresh lifecycle in place (MaxCore::Genesis contract).
+    bool Genesis(const State& initial_state) noexcept;
+
+    const State& Current() const noexcept { return current_; }
+    const State& Previous() const noexcept { return previous_; }
+    const LifecycleContext& Lifecycle() const noexcept { return lifecycle_; }
+    const Parameters& Params() const noexcept { return params_; }
+    size_t DeltaDim() const noexcept { return delta_dim_; }
+
+private:
+    MaxCoreT(
+        const Parameters& params,
+        size_t delta_dim,
+        const State& initial_state,
+        std::optional<Scalar> delta_max
+    ) noexcept;
+
+    // Persistent immutable configuration
+    Parameters params_;
+    size_t delta_dim_;
+    std::optional<Scalar> delta_max_;
+
+    // Persistent structural state
+    State current_;
+    State previous_;
+    LifecycleContext lifecycle_;
+};
+
+extern template class MaxCoreT<double>;
+extern template class MaxCoreT<float>;
+
+} // namespace maxcore
+
+#endif // MAXCORE_SCALAR_CORE_H
@@ -0,0 +1,92 @@
+// ==============================
+// File: include/maxcore/snapshot.h
+// ==============================
+#ifndef MAXCORE_SNAPSHOT_H
+#define MAXCORE_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "maxcore/batch.h"
+#include "maxcore/ensemble.h"
+#include "maxcore/maxcore.h"
+
+namespace maxcore {
+
+// Binary snapshot format (version 2). Every field is 8 bytes wide.
+//
+// Header (64 bytes):
+//   magic "MAXCSNAP" | endian tag 0x0102030405060708 | version | kind |
+//   count | payload bytes | checksum | configs
+//
+// The payload starts with a table of `configs` configuration entries of
+// kSnapshotConfigWords words each:
+//   params (8 doubles) | delta_dim | has_delta_max | delta_max | reduction
+//
+// CORES body: `count` records of kSnapshotCoreWords words each:
+//   config index | current (3 doubles) | previous (3 doubles) |
+//   step_counter | flags   (flags: bit 0 terminal, bit 1 collapse_emitted)
+// Cores sharing a configuration share one entry (1 <= configs <= count; a
+// record reuses any of the 64 most recent entries).
+//
+// BATCH: exactly one configuration entry (reduction SERIAL), then one column
+// of `count` words per field:
+//   phi | memory | kappa | prev_phi | prev_memory | prev_kappa |
+//   step_counter | terminal | collapse_emitted
+//
+// The endian tag is written in native byte order; a snapshot is restored only
+// on a host with the same byte order. The checksum covers the payload.
+// Restore validates the header and the checksum once per buffer and each
+// configuration entry once (the checks of Create()), then copies the entity
+// states, checking each as Create() checks a genesis state, with the terminal
+// flag equal to Kappa == 0 and collapse_emitted only on terminal entities. Any
+// failure rejects the whole buffer. Restored engines produce bit-identical futures.
+//
+// Only double engines are covered: MaxCoreBatchT<float> has no snapshot path.
+
+enum class SnapshotKind : uint64_t {
+    CORES = 1,  // independent MaxCore records (single core, bulk, ensemble)
+    BATCH = 2   // one MaxCoreBatch in column layout
+};
+
+constexpr uint64_t kSnapshotVersion = 2;
+constexpr size_t kSnapshotHeaderBytes = 64;
+constexpr size_t kSnapshotConfigWords = 12;
+constexpr size_t kSnapshotCoreWords = 9;
+constexpr size_t kSnapshotBatchColumns = 9;
+
+// Buffer size a CORES snapshot of `count` cores needs at most (one configuration
+// entry per core). The written snapshot is shorter when cores share configurations.
+size_t SnapshotSize(size_t count) noexcept;
+
+// Exact buffer size of a BATCH snapshot of a batch with `lanes` lanes.
+size_t BatchSnapshotSize(size_t lanes) noexcept;
+
+// Writes a CORES snapshot of cores[0, count) into out (out_len bytes).
+// Returns the number of bytes written (the snapshot's exact size), or 0 if
+// count == 0, cores or out is null, or out_len < SnapshotSize(count).
+size_t WriteSnapshot(const MaxCore* cores, size_t count, void* out, size_t out_len) noexcept;
+
+std::vector<uint8_t> Snapshot(const MaxCore& core);
+std::vector<uint8_t> SnapshotBulk(const MaxCore* cores, size_t count);
+std::vector<uint8_t> SnapshotEnsemble(const EnsembleRunner& runner);
+std::vector<uint8_t> SnapshotBatch(const MaxCoreBatch& batch);
+
+// Restores a CORES snapshot holding exactly one core.
+std::optional<MaxCore> Restore(const void* data, size_t len);
+
+// Restores every core of a CORES snapshot, in order.
+std::optional<std::vector<MaxCore>> RestoreBulk(const void* data, size_t len);
+
+// Restores a CORES snapshot into a new EnsembleRunner (entity i = record i).
+// Input buffers are not part of the snapshot and must be bound again.
+std::optional<EnsembleRunner> RestoreEnsemble(const void* data, size_t len, size_t workers = 0);
+
+// Restores a BATCH snapshot (columns are copied as contiguous blocks).
+std::optional<MaxCoreBatch> RestoreBatch(const void* data, size_t len);
+
+} // namespace maxcore
+
+#endif // MAXCORE_SNAPSHOT_H
@@ -0,0 +1,102 @@
+// ==============================
+// File: include/maxcore/sweep.h
+// ==============================
+#ifndef MAXCORE_SWEEP_H
+#define MAXCORE_SWEEP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "maxcore/types.h"
+
+namespace maxcore {
+
+// One sweep axis: the ParameterSet field it varies and the values it takes.
+// Example: SweepAxis{&ParameterSet::rho, {0.05, 0.15, 0.30}}.
+struct SweepAxis {
+    double ParameterSet::* field;
+    std::vector<double> values;
+};
+
+// Dense result tensors of ParameterSweep::Run(), one entry per grid point.
+// Points are row-major over the axes (the last axis varies fastest).
+struct SweepResult {
+    std::vector<size_t> shape;            // values.size() of each axis
+
+    std::vector<int64_t> collapse_step;   // index of the COLLAPSE step, -1 if none
+    std::vector<EventFlag> stop_event;    // COLLAPSE or ERROR that stopped the point, NORMAL otherwise
+
+    std::vector<double> final_phi;        // state after the last committed step
+    std::vector<double> final_memory;
+    std::vector<double> final_kappa;
+    std::vector<double> min_kappa;        // minimum kappa over the initial and all committed states
+
+    size_t Points() const noexcept { return collapse_step.size(); }
+};
+
+// Grid engine: evaluates one shared delta stream against every point of a
+// Cartesian grid over ParameterSet fields.
+//
+// Each point follows exactly the contract of a fresh MaxCore (same initial state,
+// delta_max and dt) fed the stream through Step() until the first COLLAPSE or
+// ERROR; its results are bitwise identical to that scalar run. Results never
+// depend on the number of threads.
+class ParameterSweep final {
+public:
+    // Create() is the only construction entry point.
+    // Returns std::nullopt if there are no axes, an axis is empty or has a null
+    // field, a swept value is not a valid parameter, the initial state is invalid
+    // for some kappa_max on the grid, or the grid size overflows size_t.
+    static std::optional<ParameterSweep> Create(
+        const ParameterSet& base,
+        std::vector<SweepAxis> axes,
+        size_t delta_dim,
+        const StructuralState& initial_state,
+        std::optional<double> delta_max = std::nullopt
+    );
+
+    // Runs the whole grid over `steps` rows (row i at deltas + i * stride).
+    // dt is checked per point against that point's stability bound: a point that
+    // fails it stops with ERROR before its first step.
+    // threads == 0 uses the hardware concurrency.
+    // Returns std::nullopt if deltas is null (with steps > 0) or stride < DeltaDim().
+    std::optional<SweepResult> Run(
+        const double* deltas,
+        size_t steps,
+        size_t stride,
+        double dt,
+        size_t threads = 0
+    ) const;
+
+    size_t Points() const noexcept { return points_; }
+    size_t DeltaDim() const noexcept { return delta_dim_; }
+    const std::vector<SweepAxis>& Axes() const noexcept { return axes_; }
+    std::vector<size_t> Shape() const;
+
+    // Parameters of grid point `index` (MUST be < Points()).
+    ParameterSet PointParams(size_t index) const noexcept;
+
+private:
+    ParameterSweep(
+        const ParameterSet& base,
+        std::vector<SweepAxis> axes,
+        size_t points,
+        size_t delta_dim,
+        const StructuralState& initial_state,
+        std::optional<double> delta_max
+    );
+
+    ParameterSet base_;
+    std::vector<SweepAxis> axes_;
+    size_t points_;
+    size_t delta_dim_;
+    StructuralState init_;
+    std::optional<double> delta_max_;
+    std::vector<size_t> strides_;
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_SWEEP_H
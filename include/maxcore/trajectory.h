@@ -0,0 +1,103 @@
+// ==============================
+// File: include/maxcore/trajectory.h
+// ==============================
+#ifndef MAXCORE_TRAJECTORY_H
+#define MAXCORE_TRAJECTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "maxcore/maxcore.h"
+
+namespace maxcore {
+
+// Read-only view over one recorded column, oldest row first.
+// A ring that has wrapped stores its rows in two contiguous segments:
+// `first` (oldest rows) followed by `second` (newest rows). Otherwise
+// `second` is empty. Views are invalidated by the next Record()/Clear().
+template <class T>
+struct ColumnView {
+    const T* first;
+    size_t first_len;
+    const T* second;
+    size_t second_len;
+
+    size_t Size() const noexcept { return first_len + second_len; }
+    bool Empty() const noexcept { return Size() == 0; }
+
+    // i MUST be < Size()
+    const T& operator[](size_t i) const noexcept {
+        return (i < first_len) ? first[i] : second[i - first_len];
+    }
+};
+
+enum class RecorderMode : uint8_t {
+    LINEAR = 0,  // keeps the first Capacity() rows, later rows are dropped
+    RING = 1     // keeps the last Capacity() rows, the oldest row is overwritten
+};
+
+// Columnar step history with storage allocated once in Create().
+// Record() and Step() perform no heap allocation and no reallocation.
+class TrajectoryRecorder final {
+public:
+    // Create() is the only construction entry point.
+    // Returns std::nullopt if capacity == 0.
+    static std::optional<TrajectoryRecorder> Create(size_t capacity, RecorderMode mode = RecorderMode::LINEAR);
+
+    // Appends one row: the core's current state, step_counter and `event`.
+    // Returns false if the row was dropped (LINEAR mode, recorder full).
+    bool Record(const MaxCore& core, EventFlag event) noexcept;
+
+    // core.Step() followed by Record() of its result (every call is recorded,
+    // including ERROR and terminal NORMAL).
+    EventFlag Step(MaxCore& core, const double* delta_input, size_t delta_len, double dt);
+
+    // Forgets every row; capacity and storage are kept.
+    void Clear() noexcept;
+
+    size_t Capacity() const noexcept { return capacity_; }
+    size_t Size() const noexcept { return size_; }
+    RecorderMode Mode() const noexcept { return mode_; }
+
+    // Rows offered to Record() since Create()/Clear(), including dropped and
+    // overwritten ones.
+    uint64_t Total() const noexcept { return total_; }
+    uint64_t Dropped() const noexcept { return dropped_; }
+
+    ColumnView<double> Phi() const noexcept { return View(phi_); }
+    ColumnView<double> Memory() const noexcept { return View(memory_); }
+    ColumnView<double> Kappa() const noexcept { return View(kappa_); }
+    ColumnView<EventFlag> Events() const noexcept { return View(event_); }
+    ColumnView<uint64_t> StepCounter() const noexcept { return View(step_counter_); }
+
+private:
+    TrajectoryRecorder(size_t capacity, RecorderMode mode);
+
+    template <class T>
+    ColumnView<T> View(const std::vector<T>& column) const noexcept {
+        const T* base = column.data();
+        if (size_ < capacity_) return ColumnView<T>{base, size_, base, 0};
+        // Full: the oldest row sits at next_ (0 for a full LINEAR recorder).
+        return ColumnView<T>{base + next_, capacity_ - next_, base, next_};
+    }
+
+    size_t capacity_;
+    RecorderMode mode_;
+
+    size_t next_ = 0;  // slot of the next row
+    size_t size_ = 0;  // rows held
+    uint64_t total_ = 0;
+    uint64_t dropped_ = 0;
+
+    std::vector<double> phi_;
+    std::vector<double> memory_;
+    std::vector<double> kappa_;
+    std::vector<EventFlag> event_;
+    std::vector<uint64_t> step_counter_;
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_TRAJECTORY_H
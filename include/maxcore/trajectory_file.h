@@ -0,0 +1,191 @@
+// ==============================
+// File: include/maxcore/trajectory_file.h
+// ==============================
+#ifndef MAXCORE_TRAJECTORY_FILE_H
+#define MAXCORE_TRAJECTORY_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "maxcore/derived.h"
+#include "maxcore/maxcore.h"
+#include "maxcore/trajectory.h"
+
+namespace maxcore {
+
+// Columnar binary trajectory file (version 1).
+//
+// Header (160 bytes, 8-byte fields):
+//   magic "MAXCTRAJ" | endian tag 0x0102030405060708 | version |
+//   params (8 doubles) | dt | delta_dim | column count | chunk_rows | rows |
+//   reserved (4 words, 0)
+//
+// Body: rows are grouped into chunks of chunk_rows rows (the last chunk may be
+// shorter). A chunk stores one block per column, in TrajectoryColumn order;
+// every block is padded to a multiple of 8 bytes, so each column of each chunk
+// is one contiguous, aligned array.
+//
+// Rows hold the current and previous state, so every DerivedFrame column of
+// the CSV pipeline is recomputed exactly (bit for bit) from the file.
+
+enum class TrajectoryColumn : uint8_t {
+    LIFECYCLE = 0,     // uint64_t lifecycle id
+    STEP_COUNTER = 1,  // uint64_t
+    EVENT = 2,         // EventFlag (1 byte)
+    FLAGS = 3,         // uint8_t: bit 0 terminal, bit 1 collapse_emitted
+    PHI = 4,           // double
+    MEMORY = 5,
+    KAPPA = 6,
+    PREV_PHI = 7,
+    PREV_MEMORY = 8,
+    PREV_KAPPA = 9,
+    COUNT = 10
+};
+
+constexpr uint64_t kTrajectoryVersion = 1;
+constexpr size_t kTrajectoryHeaderBytes = 160;
+
+struct TrajectoryRow {
+    uint64_t lifecycle_id;
+    EventFlag event;
+    StructuralState current;
+    StructuralState previous;
+    LifecycleContext lifecycle;
+};
+
+// Streams rows into a trajectory file, one chunk buffered in memory.
+class TrajectoryFileWriter final {
+public:
+    // Create() is the only construction entry point. Opens (truncates) `path`.
+    // Returns std::nullopt if params or dt are invalid (same rules as MaxCore),
+    // delta_dim == 0, chunk_rows == 0, or the file cannot be opened.
+    static std::optional<TrajectoryFileWriter> Create(
+        const std::string& path,
+        const ParameterSet& params,
+        double dt,
+        size_t delta_dim,
+        size_t chunk_rows = 65536
+    );
+
+    TrajectoryFileWriter(TrajectoryFileWriter&&) noexcept = default;
+    // Closes (finalizes) the file this writer still has open before taking over `other`.
+    TrajectoryFileWriter& operator=(TrajectoryFileWriter&& other) noexcept;
+    ~TrajectoryFileWriter();
+
+    // Appends one row. Returns false once any write has failed (the failure is sticky).
+    // The header row count is rewritten after every flushed chunk, so a run that
+    // is interrupted before Close(), even mid-flush, stays readable up to its last
+    // full chunk.
+    bool Append(const TrajectoryRow& row) noexcept;
+    bool Append(const MaxCore& core, EventFlag event, uint64_t lifecycle_id) noexcept;
+
+    // Flushes the last chunk and finalizes the header. Also run by the destructor.
+    // Returns false if any write failed.
+    bool Close() noexcept;
+
+    uint64_t Rows() const noexcept { return rows_; }
+
+private:
+    struct FileCloser {
+        void operator()(std::FILE* f) const noexcept;
+    };
+
+    TrajectoryFileWriter(std::FILE* file, const ParameterSet& params, double dt, size_t delta_dim, size_t chunk_rows);
+
+    bool FlushChunk() noexcept;
+    bool WriteHeader() noexcept;
+
+    std::unique_ptr<std::FILE, FileCloser> file_;
+    ParameterSet params_;
+    double dt_;
+    size_t delta_dim_;
+    size_t chunk_rows_;
+    uint64_t rows_ = 0;
+    size_t pending_ = 0;
+    bool ok_ = true;
+
+    std::vector<uint64_t> lifecycle_;
+    std::vector<uint64_t> step_counter_;
+    std::vector<uint8_t> event_;
+    std::vector<uint8_t> flags_;
+    std::vector<double> state_[6];  // phi, memory, kappa, prev_phi, prev_memory, prev_kappa
+};
+
+// Zero-copy reader: maps the whole file (mmap / MapViewOfFile) and hands out
+// typed column spans per chunk. Open() validates the header once (params, dt and
+// delta_dim as in TrajectoryFileWriter::Create()) and requires the body to hold
+// the header's row count; bytes past it (a chunk torn by an interrupted run) are
+// ignored. No row is parsed or copied.
+class TrajectoryFileReader final {
+public:
+    static std::optional<TrajectoryFileReader> Open(const std::string& path);
+
+    TrajectoryFileReader(TrajectoryFileReader&& other) noexcept;
+    TrajectoryFileReader& operator=(TrajectoryFileReader&& other) noexcept;
+    TrajectoryFileReader(const TrajectoryFileReader&) = delete;
+    TrajectoryFileReader& operator=(const TrajectoryFileReader&) = delete;
+    ~TrajectoryFileReader();
+
+    const ParameterSet& Params() const noexcept { return params_; }
+    double Dt() const noexcept { return dt_; }
+    size_t DeltaDim() const noexcept { return delta_dim_; }
+    uint64_t Rows() const noexcept { return rows_; }
+    size_t ChunkRows() const noexcept { return chunk_rows_; }
+    size_t Chunks() const noexcept { return chunks_; }
+    size_t ChunkSize(size_t chunk) const noexcept;
+
+    // Typed column spans of one chunk (chunk MUST be < Chunks()).
+    ColumnView<uint64_t> LifecycleIds(size_t chunk) const noexcept { return Column<uint64_t>(TrajectoryColumn::LIFECYCLE, chunk); }
+    ColumnView<uint64_t> StepCounter(size_t chunk) const noexcept { return Column<uint64_t>(TrajectoryColumn::STEP_COUNTER, chunk); }
+    ColumnView<EventFlag> Events(size_t chunk) const noexcept { return Column<EventFlag>(TrajectoryColumn::EVENT, chunk); }
+    ColumnView<uint8_t> Flags(size_t chunk) const noexcept { return Column<uint8_t>(TrajectoryColumn::FLAGS, chunk); }
+    ColumnView<double> Phi(size_t chunk) const noexcept { return Column<double>(TrajectoryColumn::PHI, chunk); }
+    ColumnView<double> Memory(size_t chunk) const noexcept { return Column<double>(TrajectoryColumn::MEMORY, chunk); }
+    ColumnView<double> Kappa(size_t chunk) const noexcept { return Column<double>(TrajectoryColumn::KAPPA, chunk); }
+    ColumnView<double> PrevPhi(size_t chunk) const noexcept { return Column<double>(TrajectoryColumn::PREV_PHI, chunk); }
+    ColumnView<double> PrevMemory(size_t chunk) const noexcept { return Column<double>(TrajectoryColumn::PREV_MEMORY, chunk); }
+    ColumnView<double> PrevKappa(size_t chunk) const noexcept { return Column<double>(TrajectoryColumn::PREV_KAPPA, chunk); }
+
+    // Gathers one row (row MUST be < Rows()).
+    TrajectoryRow Row(uint64_t row) const noexcept;
+
+    // Recomputes the pipeline's DerivedFrame for one row from the stored states.
+    std::optional<DerivedFrame> Derived(uint64_t row) const;
+
+private:
+    TrajectoryFileReader() = default;
+
+    const uint8_t* ColumnBase(TrajectoryColumn column, size_t chunk) const noexcept;
+
+    template <class T>
+    ColumnView<T> Column(TrajectoryColumn column, size_t chunk) const noexcept {
+        const T* base = reinterpret_cast<const T*>(ColumnBase(column, chunk));
+        return ColumnView<T>{base, ChunkSize(chunk), base, 0};
+    }
+
+    void Unmap() noexcept;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+
+    ParameterSet params_{};
+    double dt_ = 0.0;
+    size_t delta_dim_ = 0;
+    uint64_t rows_ = 0;
+    size_t chunk_rows_ = 0;
+    size_t chunks_ = 0;
+    size_t chunk_bytes_ = 0;  // bytes of one full chunk
+};
+
+} // namespace maxcore
+
+#endif // MAXCORE_TRAJECTORY_FILE_H
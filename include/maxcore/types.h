@@ -4,6 +4,7 @@
 #ifndef MAXCORE_TYPES_H
 #define MAXCORE_TYPES_H
 
+#include <cstddef>
 #include <cstdint>
 
 namespace maxcore {
@@ -14,30 +15,58 @@ enum class EventFlag : uint8_t {
     ERROR = 2
 };
 
-struct StructuralState {
-    double phi;
-    double memory;
-    double kappa;
+// Why a step did (or did not) commit. ERROR events carry one of the failure codes.
+enum class StepStatus : uint8_t {
+    OK = 0,                // committed (NORMAL or COLLAPSE)
+    TERMINAL = 1,          // terminal short-circuit, nothing committed (NORMAL)
+    NULL_INPUT = 2,        // delta_input == nullptr
+    DIM_MISMATCH = 3,      // delta_len != delta_dim
+    DT_INVALID = 4,        // dt non-finite or <= 0
+    DT_UNSTABLE = 5,       // dt * max_rate >= 1
+    DELTA_NON_FINITE = 6,  // non-finite delta component or norm2
+    NORM_GUARD = 7,        // delta_max guard could not scale the input
+    NUMERIC_FAILURE = 8    // canonical update produced a non-finite value
 };
 
+// State and parameter layouts are generic in the scalar type; the double
+// instantiations are the canonical engine types (see scalar_core.h for float).
+template <typename Scalar>
+struct BasicStructuralState {
+    Scalar phi;
+    Scalar memory;
+    Scalar kappa;
+};
+
+using StructuralState = BasicStructuralState<double>;
+
 struct LifecycleContext {
     uint64_t step_counter;
     bool terminal;
     bool collapse_emitted;
 };
 
-struct ParameterSet {
+// Outcome of a multi-step call (MaxCore::StepSequence).
+struct SequenceResult {
+    size_t committed;    // number of steps committed by this call
+    size_t event_index;  // index of the step that returned `event`; == steps if the block completed
+    EventFlag event;     // COLLAPSE or ERROR that stopped the block, NORMAL otherwise
+};
+
+template <typename Scalar>
+struct BasicParameterSet {
     // Canonical coefficients (all MUST be finite and > 0)
-    double alpha;       // energy injection from norm2
-    double eta;         // energy decay rate
-    double beta;        // memory gain from phi
-    double gamma;       // memory decay rate
-    double rho;         // kappa regeneration rate
-    double lambda_phi;  // kappa load from phi
-    double lambda_m;    // kappa load from memory
-    double kappa_max;   // upper bound for kappa (MUST be finite and > 0)
+    Scalar alpha;       // energy injection from norm2
+    Scalar eta;         // energy decay rate
+    Scalar beta;        // memory gain from phi
+    Scalar gamma;       // memory decay rate
+    Scalar rho;         // kappa regeneration rate
+    Scalar lambda_phi;  // kappa load from phi
+    Scalar lambda_m;    // kappa load from memory
+    Scalar kappa_max;   // upper bound for kappa (MUST be finite and > 0)
 };
 
+using ParameterSet = BasicParameterSet<double>;
+
 } // namespace maxcore
 
 #endif // MAXCORE_TYPES_H
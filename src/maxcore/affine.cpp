@@ -0,0 +1,212 @@
+// ==============================
+// File: src/maxcore/affine.cpp
+// ==============================
+#include "affine.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "kernel.h"
+
+namespace maxcore {
+namespace detail {
+
+static AffineStep affine_identity() noexcept {
+    AffineStep id{};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            id.m[i][j] = (i == j) ? 1.0 : 0.0;
+        }
+    }
+    return id;
+}
+
+// (a * b): apply b first, then a.
+static AffineStep affine_mul(const AffineStep& a, const AffineStep& b) noexcept {
+    AffineStep out{};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            double acc = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                acc += a.m[i][k] * b.m[k][j];
+            }
+            if (j == 3) acc += a.m[i][3];
+            out.m[i][j] = acc;
+        }
+    }
+    return out;
+}
+
+AffineStep affine_step(const ParameterSet& p, double norm2, double dt) noexcept {
+    const double a = 1.0 - p.eta * dt;
+    const double g = 1.0 - p.gamma * dt;
+    const double r = 1.0 - p.rho * dt;
+    const double inj = p.alpha * norm2;
+    const double bd = p.beta * dt;
+    const double lpd = p.lambda_phi * dt;
+    const double lmd = p.lambda_m * dt;
+
+    AffineStep s{};
+
+    // phi' = a*phi + inj
+    s.m[0][0] = a;
+    s.m[0][3] = inj;
+
+    // memory' = g*memory + bd*phi'
+    s.m[1][0] = bd * a;
+    s.m[1][1] = g;
+    s.m[1][3] = bd * inj;
+
+    // kappa' = r*kappa + rho*kappa_max*dt - lpd*phi' - lmd*memory'
+    s.m[2][0] = -(lpd * a) - (lmd * s.m[1][0]);
+    s.m[2][1] = -(lmd * g);
+    s.m[2][2] = r;
+    s.m[2][3] = (p.rho * p.kappa_max * dt) - (lpd * inj) - (lmd * s.m[1][3]);
+
+    return s;
+}
+
+AffineStep affine_power(const AffineStep& s, uint64_t k) noexcept {
+    AffineStep result = affine_identity();
+    AffineStep base = s;
+    while (k > 0) {
+        if ((k & 1u) != 0u) result = affine_mul(base, result);
+        k >>= 1u;
+        if (k > 0) base = affine_mul(base, base);
+    }
+    return result;
+}
+
+StructuralState affine_apply(const AffineStep& s, const StructuralState& x) noexcept {
+    StructuralState out{};
+    out.phi    = s.m[0][0] * x.phi + s.m[0][1] * x.memory + s.m[0][2] * x.kappa + s.m[0][3];
+    out.memory = s.m[1][0] * x.phi + s.m[1][1] * x.memory + s.m[1][2] * x.kappa + s.m[1][3];
+    out.kappa  = s.m[2][0] * x.phi + s.m[2][1] * x.memory + s.m[2][2] * x.kappa + s.m[2][3];
+    return out;
+}
+
+uint64_t safe_horizon(
+    const ParameterSet& p,
+    double norm2,
+    double dt,
+    const StructuralState& x,
+    uint64_t limit
+) noexcept {
+    const double margin = p.kappa_max * kAffineMargin;
+    if (limit == 0 || !(x.kappa > margin)) return 0;
+
+    // Upper bounds over the whole segment: Phi moves monotonically toward its fixed
+    // point, Memory stays below max(memory0, beta * Phi_bar / gamma).
+    const double phi_star = (p.alpha * norm2) / (p.eta * dt);
+    const double phi_bar = std::max(x.phi, phi_star);
+    const double mem_bar = std::max(x.memory, (p.beta * phi_bar) / p.gamma);
+
+    // kappa_{j+1} >= r*kappa_j + dt*L  =>  kappa_j >= steady + (kappa_0 - steady) * r^j
+    const double load = (p.rho * p.kappa_max) - (p.lambda_phi * phi_bar) - (p.lambda_m * mem_bar);
+    const double steady = load / p.rho;
+    const double r = 1.0 - p.rho * dt;
+
+    if (!is_finite(steady) || !is_finite(r)) return 0;
+    if (steady > margin) return limit;
+
+    // Lower bound is non-increasing in j: bisection for the last j above the margin.
+    auto bound = [&](uint64_t j) noexcept {
+        return steady + (x.kappa - steady) * std::pow(r, static_cast<double>(j));
+    };
+
+    if (bound(limit) > margin) return limit;
+
+    uint64_t lo = 0;     // bound(lo) > margin
+    uint64_t hi = limit; // bound(hi) <= margin
+    while (hi - lo > 1u) {
+        const uint64_t mid = lo + (hi - lo) / 2u;
+        if (bound(mid) > margin) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+bool affine_admit(const ParameterSet& p, StructuralState& x) noexcept {
+    if (!is_finite(x.phi) || !is_finite(x.memory) || !is_finite(x.kappa)) return false;
+    if (x.phi < 0.0 || x.memory < 0.0) return false;
+    if (!(x.kappa > 0.0)) return false;
+    x.kappa = std::min(x.kappa, p.kappa_max);
+    return true;
+}
+
+EventFlag affine_advance(
+    const ParameterSet& p,
+    const std::optional<double>& delta_max,
+    double norm2,
+    double dt,
+    StructuralState& current,
+    StructuralState& previous,
+    LifecycleContext& lifecycle,
+    uint64_t k,
+    bool& jumped,
+    bool& tie
+) noexcept {
+    tie = false;
+
+    double guarded = norm2;
+    if (!apply_norm_guard(delta_max, guarded)) return EventFlag::ERROR;
+
+    const AffineStep one = affine_step(p, guarded, dt);
+    const double margin = p.kappa_max * kAffineMargin;
+
+    const StructuralState current0 = current;
+    const StructuralState previous0 = previous;
+    const LifecycleContext lifecycle0 = lifecycle;
+    const bool jumped0 = jumped;
+
+    uint64_t remaining = k;
+    while (remaining > 0) {
+        // The last step is always exact, so Previous() is that of a stepped run.
+        const uint64_t h = safe_horizon(p, guarded, dt, current, remaining - 1u);
+
+        if (h >= kAffineMinJump) {
+            StructuralState x = affine_apply(affine_power(one, h), current);
+            if (affine_admit(p, x)) {
+                current = x;
+                lifecycle.step_counter += h;
+                remaining -= h;
+                jumped = true;
+                continue;
+            }
+        }
+
+        // Near a possible collapse: a short run of exact steps before re-certifying.
+        const uint64_t exact = std::min<uint64_t>(remaining, kAffineMinJump);
+        for (uint64_t i = 0; i < exact; ++i) {
+            const StructuralState before = current;
+            StepStatus status = StepStatus::OK;
+            double load_phi = 0.0;
+            double load_m = 0.0;
+            const EventFlag ev = commit_norm2(p, delta_max, norm2, dt, current, previous, lifecycle, status,
+                                              load_phi, load_m);
+
+            if (jumped) {
+                const bool decisive = (ev == EventFlag::NORMAL && current.kappa > margin) ||
+                                      (ev == EventFlag::COLLAPSE && affine_apply(one, before).kappa < -margin);
+                if (!decisive) {
+                    current = current0;
+                    previous = previous0;
+                    lifecycle = lifecycle0;
+                    jumped = jumped0;
+                    tie = true;
+                    return EventFlag::NORMAL;
+                }
+            }
+            if (ev != EventFlag::NORMAL) return ev;
+        }
+        remaining -= exact;
+    }
+
+    return EventFlag::NORMAL;
+}
+
+} // namespace detail
+} // namespace maxcore
@@ -0,0 +1,84 @@
+// ==============================
+// File: src/maxcore/affine.h
+// ==============================
+#ifndef MAXCORE_AFFINE_H
+#define MAXCORE_AFFINE_H
+
+// Private closed-form propagation for constant-input segments.
+// With a constant norm2 and no active clamp, one canonical step is an affine map
+// x' = M x + c of x = (phi, memory, kappa). Phi and Memory can never clamp for
+// admitted inputs (all coefficients are non-negative), so the only event a
+// constant segment can produce is Kappa reaching 0. safe_horizon() certifies how
+// many steps can be jumped before that can happen; callers step exactly from there.
+
+#include <cstdint>
+#include <optional>
+
+#include "maxcore/types.h"
+
+namespace maxcore {
+namespace detail {
+
+// Rows: phi, memory, kappa. Columns: phi, memory, kappa, constant.
+// The implicit fourth row is (0, 0, 0, 1).
+struct AffineStep {
+    double m[3][4];
+};
+
+// One canonical step for a constant (already guarded) norm2.
+AffineStep affine_step(const ParameterSet& p, double norm2, double dt) noexcept;
+
+// s^k by exponentiation by squaring (k == 0 yields the identity).
+AffineStep affine_power(const AffineStep& s, uint64_t k) noexcept;
+
+StructuralState affine_apply(const AffineStep& s, const StructuralState& x) noexcept;
+
+// Relative collapse margin: jumps never end with a certified lower bound of
+// Kappa below kappa_max * kAffineMargin; the remainder is stepped exactly.
+constexpr double kAffineMargin = 1e-6;
+
+// Jumps shorter than this are stepped exactly (cheaper than a matrix power).
+constexpr uint64_t kAffineMinJump = 16u;
+
+// Largest j <= limit such that Kappa provably stays above the collapse margin
+// for steps 1..j from x (certified lower bound, located by bisection).
+uint64_t safe_horizon(
+    const ParameterSet& p,
+    double norm2,
+    double dt,
+    const StructuralState& x,
+    uint64_t limit
+) noexcept;
+
+// Result of a jump: true if x is a finite, invariant-respecting, non-terminal state.
+// Kappa is clamped to kappa_max (rounding of the closed form may overshoot by an ulp).
+bool affine_admit(const ParameterSet& p, StructuralState& x) noexcept;
+
+// k canonical steps of one constant norm2 from a non-terminal state: certified
+// jumps while Kappa provably stays clear of 0, exact steps near a possible
+// collapse and for the last step. Jumped states agree with stepped ones up to
+// rounding, assumed (like the certification itself) to stay far below
+// kappa_max * kAffineMargin. Every exact step taken after a jump must therefore be
+// decisive: Kappa stays above the margin, or a collapsing step's unclamped Kappa is
+// below -margin. Otherwise the event or its step could differ from a Step() loop:
+// the state is restored, `tie` is set and NORMAL is returned, and the caller steps
+// exactly instead. `jumped` is in/out: true if the state already carries closed-form
+// rounding (chained segments), set once a jump is taken. norm2 is unguarded (the
+// guard is applied per step).
+EventFlag affine_advance(
+    const ParameterSet& p,
+    const std::optional<double>& delta_max,
+    double norm2,
+    double dt,
+    StructuralState& current,
+    StructuralState& previous,
+    LifecycleContext& lifecycle,
+    uint64_t k,
+    bool& jumped,
+    bool& tie
+) noexcept;
+
+} // namespace detail
+} // namespace maxcore
+
+#endif // MAXCORE_AFFINE_H
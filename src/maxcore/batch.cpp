@@ -0,0 +1,166 @@
+// ==============================
+// File: src/maxcore/batch.cpp
+// ==============================
+#include "maxcore/batch.h"
+
+#include <algorithm>
+
+#include "kernel.h"
+
+namespace maxcore {
+
+using detail::is_zero;
+
+template <typename Scalar>
+MaxCoreBatchT<Scalar>::MaxCoreBatchT(
+    const Parameters& params,
+    size_t delta_dim,
+    size_t lanes,
+    std::optional<Scalar> delta_max
+)
+    : params_(params),
+      delta_dim_(delta_dim),
+      delta_max_(delta_max),
+      phi_(lanes),
+      memory_(lanes),
+      kappa_(lanes),
+      prev_phi_(lanes),
+      prev_memory_(lanes),
+      prev_kappa_(lanes),
+      step_counter_(lanes, 0u),
+      terminal_(lanes, 0u),
+      collapse_emitted_(lanes, 0u),
+      events_(lanes, EventFlag::NORMAL) {}
+
+template <typename Scalar>
+MaxCoreBatchT<Scalar>::MaxCoreBatchT(
+    const Parameters& params,
+    size_t delta_dim,
+    const State* initial_states,
+    size_t lanes,
+    std::optional<Scalar> delta_max
+)
+    : MaxCoreBatchT(params, delta_dim, lanes, delta_max) {
+    for (size_t i = 0; i < lanes; ++i) {
+        const State& s = initial_states[i];
+        phi_[i] = s.phi;
+        memory_[i] = s.memory;
+        kappa_[i] = s.kappa;
+        prev_phi_[i] = s.phi;
+        prev_memory_[i] = s.memory;
+        prev_kappa_[i] = s.kappa;
+        terminal_[i] = is_zero(s.kappa) ? 1u : 0u;
+    }
+    RebuildLive();
+}
+
+template <typename Scalar>
+std::optional<MaxCoreBatchT<Scalar>> MaxCoreBatchT<Scalar>::Create(
+    const Parameters& params,
+    size_t delta_dim,
+    const State* initial_states,
+    size_t lanes,
+    std::optional<Scalar> delta_max
+) {
+    if (delta_dim == 0) return std::nullopt;
+    if (lanes == 0 || initial_states == nullptr) return std::nullopt;
+    if (!detail::validate_params(params)) return std::nullopt;
+    if (!detail::validate_delta_max(delta_max)) return std::nullopt;
+
+    for (size_t i = 0; i < lanes; ++i) {
+        if (!detail::validate_initial_state(initial_states[i], params.kappa_max)) return std::nullopt;
+    }
+
+    return MaxCoreBatchT(params, delta_dim, initial_states, lanes, delta_max);
+}
+
+template <typename Scalar>
+const std::vector<EventFlag>& MaxCoreBatchT<Scalar>::StepAll(const Scalar* deltas, Scalar dt) {
+    // Lanes that collapsed in the previous call report the short-circuit NORMAL from now on.
+    for (size_t i : retired_) {
+        events_[i] = EventFlag::NORMAL;
+    }
+    retired_.clear();
+
+    // All lanes terminal: every lane short-circuits to NORMAL.
+    if (live_.empty()) return events_;
+
+    // 2-3) Shared validation runs once per call; its verdict applies to every live lane.
+    const bool shared_ok = (deltas != nullptr) && detail::admit_dt(params_, dt);
+    if (!shared_ok) {
+        for (size_t i : live_) {
+            events_[i] = EventFlag::ERROR;
+        }
+        return events_;
+    }
+
+    // 1) Terminal lanes are not in live_: their short-circuit is implicit.
+    const detail::StepConfig<Scalar> cfg{params_, Scalar(0), delta_dim_, delta_max_, ReductionMode::SERIAL};
+    for (size_t i : live_) {
+        State cur{phi_[i], memory_[i], kappa_[i]};
+        State prev{prev_phi_[i], prev_memory_[i], prev_kappa_[i]};
+        LifecycleContext lc{step_counter_[i], false, collapse_emitted_[i] != 0u};
+        StepStatus status = StepStatus::OK;
+        Scalar load_phi = Scalar(0);
+        Scalar load_m = Scalar(0);
+
+        // 5-12) Canonical step of the lane (shared validation already admitted)
+        const EventFlag ev = detail::step_admitted(cfg, deltas + i * delta_dim_, dt, cur, prev, lc, status, load_phi, load_m);
+        events_[i] = ev;
+        if (status != StepStatus::OK) continue;
+
+        prev_phi_[i] = prev.phi;
+        prev_memory_[i] = prev.memory;
+        prev_kappa_[i] = prev.kappa;
+
+        phi_[i] = cur.phi;
+        memory_[i] = cur.memory;
+        kappa_[i] = cur.kappa;
+
+        step_counter_[i] = lc.step_counter;
+        terminal_[i] = lc.terminal ? 1u : 0u;
+        if (ev == EventFlag::COLLAPSE) {
+            collapse_emitted_[i] = 1u;
+            retired_.push_back(i);
+        }
+    }
+
+    // Stream compaction: lanes that collapsed in this call leave the active set
+    // (order preserved). Runs only when something collapsed.
+    if (!retired_.empty()) {
+        live_.erase(std::remove_if(live_.begin(), live_.end(), [this](size_t i) { return terminal_[i] != 0u; }),
+                    live_.end());
+    }
+
+    return events_;
+}
+
+template <typename Scalar>
+void MaxCoreBatchT<Scalar>::RebuildLive() {
+    live_.clear();
+    retired_.clear();
+    for (size_t i = 0; i < Lanes(); ++i) {
+        if (!is_zero(kappa_[i])) live_.push_back(i);
+    }
+}
+
+template <typename Scalar>
+typename MaxCoreBatchT<Scalar>::State MaxCoreBatchT<Scalar>::Current(size_t lane) const noexcept {
+    return State{phi_[lane], memory_[lane], kappa_[lane]};
+}
+
+template <typename Scalar>
+typename MaxCoreBatchT<Scalar>::State MaxCoreBatchT<Scalar>::Previous(size_t lane) const noexcept {
+    return State{prev_phi_[lane], prev_memory_[lane], prev_kappa_[lane]};
+}
+
+template <typename Scalar>
+LifecycleContext MaxCoreBatchT<Scalar>::Lifecycle(size_t lane) const noexcept {
+    return LifecycleContext{step_counter_[lane], terminal_[lane] != 0u, collapse_emitted_[lane] != 0u};
+}
+
+// Both precisions are compiled inside the library (strict FP flags apply).
+template class MaxCoreBatchT<double>;
+template class MaxCoreBatchT<float>;
+
+} // namespace maxcore
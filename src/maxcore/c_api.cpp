@@ -6,26 +6,47 @@
 #include "maxcore/maxcore.h"
 #include "maxcore/derived.h"
 
+#include <cstdint>
 #include <new>
 #include <optional>
-#include <string>
 
+// Params, delta_dim and delta_max are read back from the core, not duplicated.
 struct maxcore_handle {
-    maxcore::ParameterSet params;
-    size_t delta_dim;
-    std::optional<double> delta_max;
     maxcore::MaxCore core;
-    std::string last_error;
-
-    maxcore_handle(
-        const maxcore::ParameterSet& p,
-        size_t dd,
-        std::optional<double> dm,
-        const maxcore::MaxCore& c
-    )
-        : params(p), delta_dim(dd), delta_max(dm), core(c), last_error() {}
+    maxcore_status status;  // set without allocation on every step
+
+    explicit maxcore_handle(const maxcore::MaxCore& c) : core(c), status(MAXCORE_STATUS_OK) {}
+};
+
+// Indexed by maxcore_status.
+static const char* const kStatusStrings[] = {
+    "ok",
+    "terminal state: step short-circuited",
+    "delta_input is NULL",
+    "delta_len does not match delta_dim",
+    "dt is not finite or not > 0",
+    "dt violates the stability bound (dt * max_rate >= 1)",
+    "delta_input has a non-finite component or norm2",
+    "delta_max guard could not scale the input",
+    "canonical update produced a non-finite value",
+    "invalid arguments"
 };
 
+static_assert(sizeof(kStatusStrings) / sizeof(kStatusStrings[0]) == MAXCORE_STATUS_INVALID_ARGUMENT + 1,
+              "status string table out of sync with maxcore_status");
+
+static inline maxcore_status to_c_status(maxcore::StepStatus s) noexcept {
+    return static_cast<maxcore_status>(static_cast<int>(s));
+}
+
+static inline maxcore_event to_c_event(maxcore::EventFlag ev) noexcept {
+    switch (ev) {
+        case maxcore::EventFlag::COLLAPSE: return MAXCORE_EVENT_COLLAPSE;
+        case maxcore::EventFlag::NORMAL:   return MAXCORE_EVENT_NORMAL;
+        default:                           return MAXCORE_EVENT_ERROR;
+    }
+}
+
 static inline maxcore::ParameterSet to_cpp_params(const maxcore_params& p) noexcept {
     maxcore::ParameterSet out{};
     out.alpha = p.alpha;
@@ -55,31 +76,60 @@ static inline void from_cpp_lifecycle(const maxcore::LifecycleContext& lc, maxco
     out.collapse_emitted = lc.collapse_emitted ? 1 : 0;
 }
 
+static inline void from_cpp_derived(const maxcore::DerivedFrame& d, maxcore_derived_frame& out) noexcept {
+    out.d_phi = d.d_phi;
+    out.d_memory = d.d_memory;
+    out.d_kappa = d.d_kappa;
+
+    out.phi_rate = d.phi_rate;
+    out.memory_rate = d.memory_rate;
+    out.kappa_rate = d.kappa_rate;
+
+    out.kappa_ratio = d.kappa_ratio;
+    out.kappa_distance = d.kappa_distance;
+
+    out.load_term = d.load_term;
+    out.regen_term = d.regen_term;
+
+    out.step_counter = d.step_counter;
+    out.terminal = d.terminal ? 1 : 0;
+    out.collapse_emitted = d.collapse_emitted ? 1 : 0;
+}
+
 const char* maxcore_version(void) {
     return "MAX-Core C API V2.5.0";
 }
 
-maxcore_handle* maxcore_create(
+// Validates the arguments and builds the core; shared by every constructor.
+static std::optional<maxcore::MaxCore> make_core(
     const maxcore_params* params,
     size_t delta_dim,
     const maxcore_state* initial_state,
     const double* delta_max_opt
 ) {
-    if (!params || !initial_state) return nullptr;
-
-    const maxcore::ParameterSet p = to_cpp_params(*params);
-    const maxcore::StructuralState init = to_cpp_state(*initial_state);
+    if (!params || !initial_state) return std::nullopt;
 
     std::optional<double> dm = std::nullopt;
     if (delta_max_opt) dm = *delta_max_opt;
+    return maxcore::MaxCore::Create(to_cpp_params(*params), delta_dim, to_cpp_state(*initial_state), dm);
+}
 
-    auto core_opt = maxcore::MaxCore::Create(p, delta_dim, init, dm);
+static inline bool is_aligned(const void* mem, size_t align) noexcept {
+    return (reinterpret_cast<uintptr_t>(mem) % align) == 0;
+}
+
+maxcore_handle* maxcore_create(
+    const maxcore_params* params,
+    size_t delta_dim,
+    const maxcore_state* initial_state,
+    const double* delta_max_opt
+) {
+    auto core_opt = make_core(params, delta_dim, initial_state, delta_max_opt);
     if (!core_opt) return nullptr;
 
-    maxcore_handle* h = new (std::nothrow) maxcore_handle(p, delta_dim, dm, *core_opt);
+    maxcore_handle* h = new (std::nothrow) maxcore_handle(*core_opt);
     if (!h) return nullptr;
 
-    h->last_error.clear();
     return h;
 }
 
@@ -87,6 +137,34 @@ void maxcore_destroy(maxcore_handle* h) {
     delete h;
 }
 
+size_t maxcore_handle_size(void) {
+    return sizeof(maxcore_handle);
+}
+
+size_t maxcore_handle_align(void) {
+    return alignof(maxcore_handle);
+}
+
+maxcore_handle* maxcore_init_in(
+    void* mem,
+    size_t mem_size,
+    const maxcore_params* params,
+    size_t delta_dim,
+    const maxcore_state* initial_state,
+    const double* delta_max_opt
+) {
+    if (!mem || mem_size < sizeof(maxcore_handle) || !is_aligned(mem, alignof(maxcore_handle))) return nullptr;
+
+    auto core_opt = make_core(params, delta_dim, initial_state, delta_max_opt);
+    if (!core_opt) return nullptr;
+
+    return new (mem) maxcore_handle(*core_opt);
+}
+
+void maxcore_fini_in(maxcore_handle* h) {
+    if (h) h->~maxcore_handle();
+}
+
 maxcore_event maxcore_step(
     maxcore_handle* h,
     const double* delta_input,
@@ -95,17 +173,40 @@ maxcore_event maxcore_step(
 ) {
     if (!h) return MAXCORE_EVENT_ERROR;
 
-    maxcore::EventFlag ev = h->core.Step(delta_input, delta_len, dt);
+    maxcore::StepStatus status = maxcore::StepStatus::OK;
+    const maxcore::EventFlag ev = h->core.Step(delta_input, delta_len, dt, status);
+    h->status = to_c_status(status);
+    return to_c_event(ev);
+}
+
+size_t maxcore_step_many(
+    maxcore_handle* h,
+    const double* deltas,
+    size_t steps,
+    size_t stride,
+    const double* dts,
+    maxcore_event* events_out,
+    maxcore_state* states_out_opt
+) {
+    if (!h) return 0;
+    if (steps == 0) return 0;
 
-    if (ev == maxcore::EventFlag::ERROR) {
-        h->last_error = "Step() returned ERROR";
-        return MAXCORE_EVENT_ERROR;
+    if (!deltas || !dts || !events_out || stride < h->core.DeltaDim()) {
+        h->status = MAXCORE_STATUS_INVALID_ARGUMENT;
+        return 0;
     }
 
-    h->last_error.clear();
+    const uint64_t before = h->core.Lifecycle().step_counter;
+    maxcore::StepStatus status = maxcore::StepStatus::OK;
 
-    if (ev == maxcore::EventFlag::COLLAPSE) return MAXCORE_EVENT_COLLAPSE;
-    return MAXCORE_EVENT_NORMAL;
+    for (size_t i = 0; i < steps; ++i) {
+        events_out[i] = to_c_event(h->core.Step(deltas + i * stride, h->core.DeltaDim(), dts[i], status));
+        if (states_out_opt) from_cpp_state(h->core.Current(), states_out_opt[i]);
+    }
+
+    // Status of the last row, as the last maxcore_step() would leave it.
+    h->status = to_c_status(status);
+    return static_cast<size_t>(h->core.Lifecycle().step_counter - before);
 }
 
 int maxcore_get_current(const maxcore_handle* h, maxcore_state* out) {
@@ -137,35 +238,151 @@ int maxcore_compute_derived(
         h->core.Current(),
         h->core.Previous(),
         h->core.Lifecycle(),
-        h->params,
+        h->core.Params(),
         dt
     );
 
     if (!d) return 0;
 
-    out->d_phi = d->d_phi;
-    out->d_memory = d->d_memory;
-    out->d_kappa = d->d_kappa;
+    from_cpp_derived(*d, *out);
+    return 1;
+}
 
-    out->phi_rate = d->phi_rate;
-    out->memory_rate = d->memory_rate;
-    out->kappa_rate = d->kappa_rate;
+maxcore_event maxcore_step_with_derived(
+    maxcore_handle* h,
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    maxcore_derived_frame* out,
+    int* derived_ok
+) {
+    if (derived_ok) *derived_ok = 0;
+    if (!h) return MAXCORE_EVENT_ERROR;
 
-    out->kappa_ratio = d->kappa_ratio;
-    out->kappa_distance = d->kappa_distance;
+    maxcore::StepStatus status = maxcore::StepStatus::OK;
+    maxcore::EventFlag ev = maxcore::EventFlag::ERROR;
+    if (out) {
+        std::optional<maxcore::DerivedFrame> d;
+        ev = h->core.StepWithDerived(delta_input, delta_len, dt, d, status);
+        if (d) {
+            from_cpp_derived(*d, *out);
+            if (derived_ok) *derived_ok = 1;
+        }
+    } else {
+        ev = h->core.Step(delta_input, delta_len, dt, status);
+    }
 
-    out->load_term = d->load_term;
-    out->regen_term = d->regen_term;
+    h->status = to_c_status(status);
+    return to_c_event(ev);
+}
 
-    out->step_counter = d->step_counter;
-    out->terminal = d->terminal ? 1 : 0;
-    out->collapse_emitted = d->collapse_emitted ? 1 : 0;
+maxcore_status maxcore_last_status(const maxcore_handle* h) {
+    if (!h) return MAXCORE_STATUS_INVALID_ARGUMENT;
+    return h->status;
+}
 
-    return 1;
+const char* maxcore_status_string(maxcore_status status) {
+    const int i = static_cast<int>(status);
+    if (i < 0 || i > MAXCORE_STATUS_INVALID_ARGUMENT) return "unknown status";
+    return kStatusStrings[i];
 }
 
 const char* maxcore_last_error(const maxcore_handle* h) {
     if (!h) return "null handle";
-    if (h->last_error.empty()) return "";
-    return h->last_error.c_str();
+    if (h->status == MAXCORE_STATUS_OK || h->status == MAXCORE_STATUS_TERMINAL) return "";
+    return kStatusStrings[h->status];
+}
+
+// ------------------------------
+// Pools
+// ------------------------------
+
+struct maxcore_pool {
+    maxcore_handle* handles;  // `count` handles, contiguous, in one kPoolAlign-aligned block
+    size_t count;
+};
+
+static constexpr size_t kPoolAlign = 64;  // cache line
+
+static void pool_release(maxcore_pool* pool, size_t constructed) noexcept {
+    for (size_t i = 0; i < constructed; ++i) pool->handles[i].~maxcore_handle();
+    ::operator delete(static_cast<void*>(pool->handles), std::align_val_t(kPoolAlign));
+    delete pool;
+}
+
+maxcore_pool* maxcore_pool_create(
+    size_t count,
+    const maxcore_params* params,
+    size_t delta_dim,
+    const maxcore_state* initial_states,
+    const double* delta_max_opt
+) {
+    if (count == 0 || !params || !initial_states) return nullptr;
+    if (count > static_cast<size_t>(-1) / sizeof(maxcore_handle)) return nullptr;
+
+    maxcore_pool* pool = new (std::nothrow) maxcore_pool{nullptr, count};
+    if (!pool) return nullptr;
+
+    void* block = ::operator new(count * sizeof(maxcore_handle), std::align_val_t(kPoolAlign), std::nothrow);
+    if (!block) {
+        delete pool;
+        return nullptr;
+    }
+    pool->handles = static_cast<maxcore_handle*>(block);
+
+    // Any invalid initial state fails the whole pool.
+    for (size_t i = 0; i < count; ++i) {
+        auto core_opt = make_core(params, delta_dim, &initial_states[i], delta_max_opt);
+        if (!core_opt) {
+            pool_release(pool, i);
+            return nullptr;
+        }
+        new (&pool->handles[i]) maxcore_handle(*core_opt);
+    }
+
+    return pool;
+}
+
+void maxcore_pool_destroy(maxcore_pool* pool) {
+    if (pool) pool_release(pool, pool->count);
+}
+
+size_t maxcore_pool_size(const maxcore_pool* pool) {
+    return pool ? pool->count : 0;
+}
+
+maxcore_handle* maxcore_pool_handle(maxcore_pool* pool, size_t index) {
+    if (!pool || index >= pool->count) return nullptr;
+    return &pool->handles[index];
+}
+
+size_t maxcore_pool_step(
+    maxcore_pool* pool,
+    const double* deltas,
+    size_t stride,
+    const double* dts,
+    maxcore_event* events_out,
+    maxcore_state* states_out_opt
+) {
+    if (!pool) return 0;
+
+    const size_t delta_dim = pool->handles[0].core.DeltaDim();
+    if (!deltas || !dts || !events_out || stride < delta_dim) {
+        for (size_t i = 0; i < pool->count; ++i) pool->handles[i].status = MAXCORE_STATUS_INVALID_ARGUMENT;
+        return 0;
+    }
+
+    size_t committed = 0;
+    for (size_t i = 0; i < pool->count; ++i) {
+        maxcore_handle& h = pool->handles[i];
+        const uint64_t before = h.core.Lifecycle().step_counter;
+
+        maxcore::StepStatus status = maxcore::StepStatus::OK;
+        events_out[i] = to_c_event(h.core.Step(deltas + i * stride, delta_dim, dts[i], status));
+        h.status = to_c_status(status);
+        if (states_out_opt) from_cpp_state(h.core.Current(), states_out_opt[i]);
+
+        committed += static_cast<size_t>(h.core.Lifecycle().step_counter - before);
+    }
+    return committed;
 }
@@ -4,7 +4,9 @@
 #include "maxcore/derived.h"
 
 #include <algorithm>
+#include <cfloat>
 #include <cmath>
+#include <cstring>
 
 namespace maxcore {
 
@@ -12,6 +14,19 @@ static inline bool is_finite(double x) noexcept {
     return std::isfinite(x) != 0;
 }
 
+#if defined(_MSC_VER)
+  #define MAXCORE_RESTRICT __restrict
+#elif defined(__GNUC__) || defined(__clang__)
+  #define MAXCORE_RESTRICT __restrict__
+#else
+  #define MAXCORE_RESTRICT
+#endif
+
+// Branch-free finiteness for the batch loop: false for +-inf and NaN.
+static inline bool finite_bit(double x) noexcept {
+    return std::fabs(x) <= DBL_MAX;
+}
+
 std::optional<DerivedFrame> ComputeDerived(
     const StructuralState& current,
     const StructuralState& previous,
@@ -67,4 +82,107 @@ std::optional<DerivedFrame> ComputeDerived(
     return out;
 }
 
+// Batch kernel. Output columns MUST NOT overlap the inputs or each other
+// (inputs may overlap: previous is usually current shifted by one row).
+static void derived_rows(
+    const double* MAXCORE_RESTRICT cur_phi,
+    const double* MAXCORE_RESTRICT cur_memory,
+    const double* MAXCORE_RESTRICT cur_kappa,
+    const double* MAXCORE_RESTRICT prev_phi,
+    const double* MAXCORE_RESTRICT prev_memory,
+    const double* MAXCORE_RESTRICT prev_kappa,
+    size_t rows,
+    const ParameterSet& params,
+    double dt,
+    double* MAXCORE_RESTRICT o_d_phi,
+    double* MAXCORE_RESTRICT o_d_memory,
+    double* MAXCORE_RESTRICT o_d_kappa,
+    double* MAXCORE_RESTRICT o_phi_rate,
+    double* MAXCORE_RESTRICT o_memory_rate,
+    double* MAXCORE_RESTRICT o_kappa_rate,
+    double* MAXCORE_RESTRICT o_kappa_ratio,
+    double* MAXCORE_RESTRICT o_kappa_distance,
+    double* MAXCORE_RESTRICT o_load_term,
+    double* MAXCORE_RESTRICT o_regen_term,
+    uint8_t* MAXCORE_RESTRICT o_valid
+) noexcept {
+    const double lambda_phi = params.lambda_phi;
+    const double lambda_m = params.lambda_m;
+    const double rho = params.rho;
+    const double kappa_max = params.kappa_max;
+
+    // Same operations in the same order as ComputeDerived; every rejection
+    // becomes a bit of the row mask instead of an early return. A finite rate
+    // implies a finite delta, which implies finite current and previous values.
+    for (size_t i = 0; i < rows; ++i) {
+        const double phi = cur_phi[i];
+        const double memory = cur_memory[i];
+        const double kappa = cur_kappa[i];
+
+        const double d_phi = phi - prev_phi[i];
+        const double d_memory = memory - prev_memory[i];
+        const double d_kappa = kappa - prev_kappa[i];
+
+        const double phi_rate = d_phi / dt;
+        const double memory_rate = d_memory / dt;
+        const double kappa_rate = d_kappa / dt;
+
+        const double ratio = kappa / kappa_max;
+        const double upper = (ratio < 1.0) ? ratio : 1.0;      // std::min(1.0, ratio)
+        const double clamped = (0.0 < upper) ? upper : 0.0;    // std::max(0.0, upper)
+
+        const double load = (lambda_phi * phi) + (lambda_m * memory);
+        const double regen = rho * (kappa_max - kappa);
+
+        const bool ok = finite_bit(phi_rate) & finite_bit(memory_rate) & finite_bit(kappa_rate) &
+                        finite_bit(ratio) & !(kappa < 0.0) & finite_bit(load) & finite_bit(regen);
+
+        o_d_phi[i] = d_phi;
+        o_d_memory[i] = d_memory;
+        o_d_kappa[i] = d_kappa;
+        o_phi_rate[i] = phi_rate;
+        o_memory_rate[i] = memory_rate;
+        o_kappa_rate[i] = kappa_rate;
+        o_kappa_ratio[i] = clamped;
+        o_kappa_distance[i] = kappa;
+        o_load_term[i] = load;
+        o_regen_term[i] = regen;
+        o_valid[i] = static_cast<uint8_t>(ok);
+    }
+}
+
+size_t ComputeDerivedBatch(
+    const StateColumns& current,
+    const StateColumns& previous,
+    size_t rows,
+    const ParameterSet& params,
+    double dt,
+    const DerivedColumns& out,
+    uint8_t* valid
+) noexcept {
+    if (rows == 0) return 0;
+
+    // Row-independent checks of ComputeDerived, hoisted out of the loop
+    if (!is_finite(params.lambda_phi) || !is_finite(params.lambda_m) || !is_finite(params.rho) || !is_finite(params.kappa_max) ||
+        !(params.kappa_max > 0.0) || !is_finite(dt) || !(dt > 0.0)) {
+        std::memset(valid, 0, rows);
+        return 0;
+    }
+
+    derived_rows(current.phi, current.memory, current.kappa,
+                 previous.phi, previous.memory, previous.kappa,
+                 rows, params, dt,
+                 out.d_phi, out.d_memory, out.d_kappa,
+                 out.phi_rate, out.memory_rate, out.kappa_rate,
+                 out.kappa_ratio, out.kappa_distance, out.load_term, out.regen_term,
+                 valid);
+
+    // Counted in a separate pass so the row loop has no cross-lane reduction.
+    size_t count = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        count += valid[i];
+    }
+    return count;
+}
+
 } // namespace maxcore
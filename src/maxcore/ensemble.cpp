@@ -0,0 +1,290 @@
+// ==============================
+// File: src/maxcore/ensemble.cpp
+// ==============================
+#include "maxcore/ensemble.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "thread_pool.h"
+
+namespace maxcore {
+
+namespace {
+
+// Entities handed out per pool task. Large enough to amortize the pool's
+// per-task bookkeeping, small enough to leave work to steal.
+constexpr size_t kEnsembleBlock = 32;
+
+size_t block_count(size_t entities) noexcept {
+    return (entities + kEnsembleBlock - 1u) / kEnsembleBlock;
+}
+
+// std::push_heap / pop_heap order for a min-heap on the expiry clock.
+template <class T>
+bool later_expiry(const T& a, const T& b) noexcept {
+    return a.expiry > b.expiry;
+}
+
+} // namespace
+
+EnsembleRunner::EnsembleRunner(std::vector<MaxCore>&& cores, size_t workers) {
+    slots_.reserve(cores.size());
+    live_.reserve(cores.size());
+    for (const MaxCore& c : cores) {
+        slots_.emplace_back(c);
+        if (c.Lifecycle().terminal) {
+            slots_.back().retired = true;
+        } else {
+            live_.push_back(slots_.size() - 1u);
+        }
+    }
+
+    const size_t n = std::min(workers, block_count(slots_.size()));
+    stats_.resize(std::max<size_t>(n, 1u));
+    if (n > 1u) {
+        pool_ = std::make_unique<detail::WorkStealingPool>(n);
+    }
+}
+
+EnsembleRunner::EnsembleRunner(EnsembleRunner&&) noexcept = default;
+EnsembleRunner& EnsembleRunner::operator=(EnsembleRunner&&) noexcept = default;
+EnsembleRunner::~EnsembleRunner() = default;
+
+std::optional<EnsembleRunner> EnsembleRunner::Create(std::vector<MaxCore> cores, size_t workers) {
+    if (cores.empty()) return std::nullopt;
+    return EnsembleRunner(std::move(cores), detail::resolve_workers(workers));
+}
+
+size_t EnsembleRunner::Workers() const noexcept {
+    return stats_.size();
+}
+
+bool EnsembleRunner::SetInput(size_t entity, const EntityInput& input) noexcept {
+    if (entity >= slots_.size()) return false;
+    if (input.steps > 0 && input.deltas == nullptr) return false;
+
+    Slot& s = slots_[entity];
+    if (input.stride < s.core.DeltaDim()) return false;
+
+    s.input = input;
+    s.cursor = 0;
+    s.last = EventFlag::NORMAL;
+
+    if (s.retired) {
+        // Any queued expiry of the previous buffer becomes stale.
+        s.epoch += 1u;
+        if (s.coasting) {
+            s.coasting = false;
+            coasting_ -= 1u;
+        }
+        StartCoast(entity);
+    }
+    return true;
+}
+
+bool EnsembleRunner::Genesis(size_t entity, const StructuralState& initial_state) {
+    if (entity >= slots_.size()) return false;
+
+    Slot& s = slots_[entity];
+    const size_t cursor = Cursor(entity);
+    const EventFlag last = LastEvent(entity);
+    if (!s.core.Genesis(initial_state)) return false;
+
+    // Settle the coast clock's share of the rows before leaving it.
+    s.cursor = cursor;
+    s.last = last;
+    if (s.retired) {
+        s.epoch += 1u;
+        if (s.coasting) {
+            s.coasting = false;
+            coasting_ -= 1u;
+        }
+    }
+
+    const bool was_retired = s.retired;
+    s.retired = s.core.Lifecycle().terminal;
+    if (s.retired) {
+        // Terminal genesis state: (re)start coasting from the current cursor.
+        if (!was_retired) live_.erase(std::lower_bound(live_.begin(), live_.end(), entity));
+        StartCoast(entity);
+    } else if (was_retired) {
+        live_.insert(std::lower_bound(live_.begin(), live_.end(), entity), entity);
+    }
+    return true;
+}
+
+size_t EnsembleRunner::Cursor(size_t entity) const noexcept {
+    const Slot& s = slots_[entity];
+    if (!s.coasting) return s.cursor;
+    return s.cursor + static_cast<size_t>(coast_clock_ - s.coast_base);
+}
+
+size_t EnsembleRunner::Remaining(size_t entity) const noexcept {
+    return slots_[entity].input.steps - Cursor(entity);
+}
+
+EventFlag EnsembleRunner::LastEvent(size_t entity) const noexcept {
+    const Slot& s = slots_[entity];
+    // A short-circuited row reports NORMAL.
+    if (s.coasting && coast_clock_ > s.coast_base) return EventFlag::NORMAL;
+    return s.last;
+}
+
+void EnsembleRunner::StartCoast(size_t entity) {
+    Slot& s = slots_[entity];
+    const size_t remaining = s.input.steps - s.cursor;
+    if (remaining == 0) return;
+
+    s.coasting = true;
+    s.coast_base = coast_clock_;
+    coasting_ += 1u;
+    coast_heap_.push_back(CoastExpiry{coast_clock_ + remaining, entity, s.epoch});
+    std::push_heap(coast_heap_.begin(), coast_heap_.end(), later_expiry<CoastExpiry>);
+}
+
+size_t EnsembleRunner::AdvanceCoast(uint64_t rows) {
+    if (coasting_ == 0) return 0;
+
+    const uint64_t from = coast_clock_;
+    const uint64_t to = (rows > std::numeric_limits<uint64_t>::max() - from)
+                            ? std::numeric_limits<uint64_t>::max()
+                            : from + rows;
+
+    // Entities whose rows run out within this call consume the rest of their buffer.
+    size_t consumed = 0;
+    while (!coast_heap_.empty() && coast_heap_.front().expiry <= to) {
+        std::pop_heap(coast_heap_.begin(), coast_heap_.end(), later_expiry<CoastExpiry>);
+        const CoastExpiry x = coast_heap_.back();
+        coast_heap_.pop_back();
+
+        Slot& s = slots_[x.entity];
+        if (!s.coasting || s.epoch != x.epoch) continue;
+
+        consumed += static_cast<size_t>(x.expiry - from);
+        s.cursor = s.input.steps;
+        s.last = EventFlag::NORMAL;
+        s.coasting = false;
+        coasting_ -= 1u;
+    }
+
+    // The others consume the full amount.
+    consumed += coasting_ * static_cast<size_t>(to - from);
+    coast_clock_ = to;
+
+    if (coasting_ == 0) {
+        // Nothing refers to the clock any more: restart it (and drop stale expiries).
+        coast_clock_ = 0;
+        coast_heap_.clear();
+    }
+    return consumed;
+}
+
+template <class Fn>
+EnsembleStats EnsembleRunner::Dispatch(Fn&& per_entity) {
+    for (WorkerStats& w : stats_) {
+        w = WorkerStats{};
+    }
+
+    // All entities terminal: nothing to dispatch.
+    const size_t entities = live_.size();
+    if (entities == 0) return EnsembleStats{0, 0, 0, 0};
+
+    auto run_block = [&](size_t block, size_t worker) {
+        WorkerStats& st = stats_[worker];
+        const size_t first = block * kEnsembleBlock;
+        const size_t last = std::min(first + kEnsembleBlock, entities);
+        for (size_t k = first; k < last; ++k) {
+            const size_t i = live_[k];
+            Slot& s = slots_[i];
+            per_entity(i, s, st);
+            if (s.core.Lifecycle().terminal) {
+                s.retired = true;
+                st.retired += 1u;
+            }
+        }
+    };
+
+    const size_t blocks = block_count(entities);
+    if (pool_) {
+        pool_->Run(blocks, run_block);
+    } else {
+        for (size_t b = 0; b < blocks; ++b) run_block(b, 0);
+    }
+
+    EnsembleStats total{0, 0, 0, 0};
+    size_t retired = 0;
+    for (const WorkerStats& w : stats_) {
+        total.rows += w.rows;
+        total.collapsed += w.collapsed;
+        total.errors += w.errors;
+        retired += w.retired;
+    }
+
+    // Stream compaction: entities that collapsed in this call leave the active set
+    // (order preserved) and start coasting from the next call.
+    if (retired > 0) {
+        size_t kept = 0;
+        for (size_t k = 0; k < entities; ++k) {
+            const size_t i = live_[k];
+            if (slots_[i].retired) {
+                StartCoast(i);
+            } else {
+                live_[kept++] = i;
+            }
+        }
+        live_.resize(kept);
+    }
+    return total;
+}
+
+void EnsembleRunner::Report(size_t entity, EventFlag ev) const noexcept {
+    const MaxCore& c = slots_[entity].core;
+    events_->TryPush(CoreEvent{entity, c.Lifecycle().step_counter, ev, c.Current()});
+}
+
+EnsembleStats EnsembleRunner::Tick() {
+    const size_t coasted = AdvanceCoast(1u);
+    EnsembleStats total = Dispatch([this](size_t i, Slot& s, WorkerStats& st) {
+        if (s.cursor >= s.input.steps) return;
+
+        const double* row = s.input.deltas + s.cursor * s.input.stride;
+        const EventFlag ev = s.core.Step(row, s.core.DeltaDim(), s.input.dt);
+
+        s.cursor += 1u;
+        s.last = ev;
+        st.rows += 1u;
+        if (ev == EventFlag::COLLAPSE) st.collapsed += 1u;
+        if (ev == EventFlag::ERROR) st.errors += 1u;
+        if (ev != EventFlag::NORMAL && events_ != nullptr) Report(i, ev);
+    });
+    total.rows += coasted;
+    total.live = live_.size();
+    return total;
+}
+
+EnsembleStats EnsembleRunner::RunFree(size_t max_steps) {
+    const size_t coasted = AdvanceCoast(static_cast<uint64_t>(max_steps));
+    EnsembleStats total = Dispatch([this, max_steps](size_t i, Slot& s, WorkerStats& st) {
+        const size_t n = std::min(max_steps, s.input.steps - s.cursor);
+        if (n == 0) return;
+
+        const double* rows = s.input.deltas + s.cursor * s.input.stride;
+        const SequenceResult r = s.core.StepSequence(rows, n, s.input.stride, s.input.dt);
+
+        // A stopping row (COLLAPSE or ERROR) is consumed like any other row.
+        const size_t consumed = (r.event == EventFlag::NORMAL) ? n : r.event_index + 1u;
+        s.cursor += consumed;
+        s.last = r.event;
+        st.rows += consumed;
+        if (r.event == EventFlag::COLLAPSE) st.collapsed += 1u;
+        if (r.event == EventFlag::ERROR) st.errors += 1u;
+        if (r.event != EventFlag::NORMAL && events_ != nullptr) Report(i, r.event);
+    });
+    total.rows += coasted;
+    total.live = live_.size();
+    return total;
+}
+
+} // namespace maxcore
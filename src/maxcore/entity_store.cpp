@@ -0,0 +1,309 @@
+// ==============================
+// File: src/maxcore/entity_store.cpp
+// ==============================
+#include "maxcore/entity_store.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "kernel.h"
+#include "thread_pool.h"
+
+namespace maxcore {
+
+using detail::is_zero;
+
+namespace {
+
+// Initial per-shard table size (buckets).
+constexpr size_t kInitialBuckets = 16;
+
+// Largest shard count accepted by Create().
+constexpr size_t kMaxShards = size_t{1} << 20;
+
+// Updates looked ahead in Apply(): home buckets are prefetched kBucketLookahead
+// updates early, the entity columns of a home-bucket hit kSlotLookahead early.
+constexpr size_t kBucketLookahead = 16;
+constexpr size_t kSlotLookahead = 4;
+
+inline void prefetch(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+// splitmix64 finalizer: sequential ids spread over shards and buckets.
+uint64_t hash_id(uint64_t x) noexcept {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace
+
+size_t EntityStore::Shard::Find(uint64_t key, uint64_t hash) const noexcept {
+    const size_t mask = table.size() - 1u;
+    for (size_t b = static_cast<size_t>(hash) & mask;; b = (b + 1u) & mask) {
+        const Bucket& bk = table[b];
+        if (bk.slot == 0) return std::numeric_limits<size_t>::max();
+        if (bk.key == key) return static_cast<size_t>(bk.slot - 1u);
+    }
+}
+
+size_t EntityStore::Shard::FindOrInsert(uint64_t key, uint64_t hash, const StructuralState& init, bool& inserted) {
+    // Keep the load factor <= 1/2 so probe runs stay short.
+    if ((phi.size() + 1u) * 2u > table.size()) Grow();
+
+    const size_t mask = table.size() - 1u;
+    size_t b = static_cast<size_t>(hash) & mask;
+    for (;; b = (b + 1u) & mask) {
+        const Bucket& bk = table[b];
+        if (bk.slot == 0) break;
+        if (bk.key == key) {
+            inserted = false;
+            return static_cast<size_t>(bk.slot - 1u);
+        }
+    }
+
+    const size_t slot = phi.size();
+    phi.push_back(init.phi);
+    memory.push_back(init.memory);
+    kappa.push_back(init.kappa);
+    prev_phi.push_back(init.phi);
+    prev_memory.push_back(init.memory);
+    prev_kappa.push_back(init.kappa);
+    step_counter.push_back(0u);
+    terminal.push_back(is_zero(init.kappa) ? 1u : 0u);
+    collapse_emitted.push_back(0u);
+
+    table[b] = Bucket{key, static_cast<uint64_t>(slot) + 1u};
+    inserted = true;
+    return slot;
+}
+
+void EntityStore::Shard::Grow() {
+    std::vector<Bucket> old = std::move(table);
+    table.assign(old.empty() ? kInitialBuckets : old.size() * 2u, Bucket{0u, 0u});
+
+    const size_t mask = table.size() - 1u;
+    for (const Bucket& bk : old) {
+        if (bk.slot == 0) continue;
+        size_t b = static_cast<size_t>(hash_id(bk.key)) & mask;
+        while (table[b].slot != 0) b = (b + 1u) & mask;
+        table[b] = bk;
+    }
+}
+
+EntityStore::EntityStore(
+    const ParameterProfile& profile,
+    const StructuralState& genesis,
+    size_t shards,
+    size_t workers
+)
+    : profile_(profile),
+      genesis_(genesis),
+      shard_bits_(0),
+      shards_(shards) {
+    while ((size_t{1} << shard_bits_) < shards) shard_bits_ += 1u;
+    for (Shard& s : shards_) {
+        s.table.assign(kInitialBuckets, Bucket{0u, 0u});
+    }
+
+    const size_t n = std::min(workers, shards);
+    if (n > 1u) {
+        pool_ = std::make_unique<detail::WorkStealingPool>(n);
+    }
+}
+
+EntityStore::EntityStore(EntityStore&&) noexcept = default;
+EntityStore& EntityStore::operator=(EntityStore&&) noexcept = default;
+EntityStore::~EntityStore() = default;
+
+std::optional<EntityStore> EntityStore::Create(
+    const ParameterProfile& profile,
+    const StructuralState& genesis,
+    size_t shards,
+    size_t workers
+) {
+    if (!detail::validate_initial_state(genesis, profile.Params().kappa_max)) return std::nullopt;
+
+    const size_t w = detail::resolve_workers(workers);
+    size_t requested = (shards == 0) ? w * 4u : shards;
+    if (requested > kMaxShards) return std::nullopt;
+
+    size_t n = 1;
+    while (n < requested) n <<= 1u;
+    return EntityStore(profile, genesis, n, w);
+}
+
+size_t EntityStore::Workers() const noexcept {
+    return pool_ ? pool_->Workers() : 1u;
+}
+
+size_t EntityStore::ShardOf(uint64_t hash) const noexcept {
+    // High bits pick the shard, low bits the bucket inside it.
+    return (shard_bits_ == 0) ? 0u : static_cast<size_t>(hash >> (64u - shard_bits_));
+}
+
+const EntityStore::Shard* EntityStore::Locate(uint64_t id, size_t& slot) const noexcept {
+    const uint64_t h = hash_id(id);
+    const Shard& s = shards_[ShardOf(h)];
+    slot = s.Find(id, h);
+    return (slot == std::numeric_limits<size_t>::max()) ? nullptr : &s;
+}
+
+bool EntityStore::Insert(uint64_t id, const StructuralState& initial_state) {
+    if (!detail::validate_initial_state(initial_state, profile_.Params().kappa_max)) return false;
+
+    const uint64_t h = hash_id(id);
+    bool inserted = false;
+    shards_[ShardOf(h)].FindOrInsert(id, h, initial_state, inserted);
+    return inserted;
+}
+
+bool EntityStore::Contains(uint64_t id) const noexcept {
+    size_t slot = 0;
+    return Locate(id, slot) != nullptr;
+}
+
+std::optional<StructuralState> EntityStore::Current(uint64_t id) const noexcept {
+    size_t i = 0;
+    const Shard* s = Locate(id, i);
+    if (s == nullptr) return std::nullopt;
+    return StructuralState{s->phi[i], s->memory[i], s->kappa[i]};
+}
+
+std::optional<StructuralState> EntityStore::Previous(uint64_t id) const noexcept {
+    size_t i = 0;
+    const Shard* s = Locate(id, i);
+    if (s == nullptr) return std::nullopt;
+    return StructuralState{s->prev_phi[i], s->prev_memory[i], s->prev_kappa[i]};
+}
+
+std::optional<LifecycleContext> EntityStore::Lifecycle(uint64_t id) const noexcept {
+    size_t i = 0;
+    const Shard* s = Locate(id, i);
+    if (s == nullptr) return std::nullopt;
+    return LifecycleContext{s->step_counter[i], s->terminal[i] != 0u, s->collapse_emitted[i] != 0u};
+}
+
+size_t EntityStore::Size() const noexcept {
+    size_t n = 0;
+    for (const Shard& s : shards_) n += s.phi.size();
+    return n;
+}
+
+EventFlag EntityStore::StepSlot(Shard& s, size_t i, const double* delta, double dt) const noexcept {
+    const detail::StepConfig<double> cfg{
+        profile_.Params(), profile_.MaxRate(), profile_.DeltaDim(), profile_.DeltaMax(), profile_.Reduction()
+    };
+    StructuralState cur{s.phi[i], s.memory[i], s.kappa[i]};
+    StructuralState prev{s.prev_phi[i], s.prev_memory[i], s.prev_kappa[i]};
+    LifecycleContext lc{s.step_counter[i], s.terminal[i] != 0u, s.collapse_emitted[i] != 0u};
+    StepStatus status = StepStatus::OK;
+
+    const EventFlag ev = detail::canonical_step(cfg, delta, profile_.DeltaDim(), dt, cur, prev, lc, status);
+    if (status != StepStatus::OK) return ev;
+
+    // Scatter the committed entity back into the shard columns.
+    s.prev_phi[i] = prev.phi;
+    s.prev_memory[i] = prev.memory;
+    s.prev_kappa[i] = prev.kappa;
+
+    s.phi[i] = cur.phi;
+    s.memory[i] = cur.memory;
+    s.kappa[i] = cur.kappa;
+
+    s.step_counter[i] = lc.step_counter;
+    s.terminal[i] = lc.terminal ? 1u : 0u;
+    s.collapse_emitted[i] = lc.collapse_emitted ? 1u : 0u;
+    return ev;
+}
+
+EntityStoreStats EntityStore::Apply(const KeyedUpdate* updates, size_t count, EventFlag* events_out) {
+    EntityStoreStats total{0, 0, 0, 0};
+    if (updates == nullptr || count == 0) return total;
+
+    // Bucket the updates by shard: counting sort, stable within a shard.
+    const size_t shard_count = shards_.size();
+    update_hash_.resize(count);
+    offsets_.assign(shard_count + 1u, 0u);
+    for (size_t k = 0; k < count; ++k) {
+        const uint64_t h = hash_id(updates[k].id);
+        update_hash_[k] = h;
+        offsets_[ShardOf(h) + 1u] += 1u;
+    }
+    for (size_t sh = 0; sh < shard_count; ++sh) {
+        offsets_[sh + 1u] += offsets_[sh];
+    }
+    order_.resize(count);
+    fill_.resize(shard_count);
+    std::copy(offsets_.begin(), offsets_.end() - 1, fill_.begin());
+    for (size_t k = 0; k < count; ++k) {
+        order_[fill_[ShardOf(update_hash_[k])]++] = k;
+    }
+
+    // Each shard applies its updates in batch order; shards are independent.
+    auto run_shard = [&](size_t sh, size_t /*worker*/) {
+        Shard& s = shards_[sh];
+        s.stats = EntityStoreStats{0, 0, 0, 0};
+        const size_t end = offsets_[sh + 1u];
+        for (size_t j = offsets_[sh]; j < end; ++j) {
+            const size_t k = order_[j];
+            const KeyedUpdate& u = updates[k];
+
+            // Cache misses dominate on large shards: pull the bucket, then the
+            // entity columns, of later updates in ahead of time.
+            const size_t mask = s.table.size() - 1u;
+            if (j + kBucketLookahead < end) {
+                prefetch(&s.table[static_cast<size_t>(update_hash_[order_[j + kBucketLookahead]]) & mask]);
+            }
+            if (j + kSlotLookahead < end) {
+                const size_t ak = order_[j + kSlotLookahead];
+                const Bucket& bk = s.table[static_cast<size_t>(update_hash_[ak]) & mask];
+                if (bk.slot != 0 && bk.key == updates[ak].id) {
+                    const size_t i = static_cast<size_t>(bk.slot - 1u);
+                    prefetch(&s.phi[i]);
+                    prefetch(&s.memory[i]);
+                    prefetch(&s.kappa[i]);
+                    prefetch(&s.prev_phi[i]);
+                    prefetch(&s.prev_memory[i]);
+                    prefetch(&s.prev_kappa[i]);
+                    prefetch(&s.step_counter[i]);
+                }
+            }
+
+            bool inserted = false;
+            const size_t slot = s.FindOrInsert(u.id, update_hash_[k], genesis_, inserted);
+            const EventFlag ev = StepSlot(s, slot, u.delta, u.dt);
+
+            if (events_out != nullptr) events_out[k] = ev;
+            s.stats.applied += 1u;
+            if (inserted) s.stats.inserted += 1u;
+            if (ev == EventFlag::COLLAPSE) s.stats.collapsed += 1u;
+            if (ev == EventFlag::ERROR) s.stats.errors += 1u;
+        }
+    };
+
+    if (pool_) {
+        pool_->Run(shard_count, run_shard);
+    } else {
+        for (size_t sh = 0; sh < shard_count; ++sh) run_shard(sh, 0);
+    }
+
+    for (const Shard& s : shards_) {
+        total.applied += s.stats.applied;
+        total.inserted += s.stats.inserted;
+        total.collapsed += s.stats.collapsed;
+        total.errors += s.stats.errors;
+    }
+    return total;
+}
+
+} // namespace maxcore
@@ -0,0 +1,132 @@
+// ==============================
+// File: src/maxcore/event_queue.cpp
+// ==============================
+#include "maxcore/event_queue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace maxcore {
+namespace detail {
+
+// Ring cell. seq == position: free for the producer claiming `position`;
+// seq == position + 1: holds the event of `position` for the consumer.
+// One cell per cache line so neighbouring producers do not share lines.
+struct alignas(64) EventCell {
+    std::atomic<size_t> seq;
+    CoreEvent ev;
+};
+
+struct EventQueueState {
+    // `cells` holds `capacity` cells, allocated by the caller (Create() does so without throwing).
+    EventQueueState(std::unique_ptr<EventCell[]> ring, size_t capacity) noexcept
+        : cells(std::move(ring)), mask(capacity - 1u) {
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    std::unique_ptr<EventCell[]> cells;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> tail{0};      // next position to claim (producers)
+    alignas(64) std::atomic<size_t> head{0};      // next position to read (consumer)
+    alignas(64) std::atomic<uint64_t> dropped{0};
+};
+
+} // namespace detail
+
+EventQueue::EventQueue(std::unique_ptr<detail::EventQueueState> state) noexcept : state_(std::move(state)) {}
+
+EventQueue::EventQueue(EventQueue&&) noexcept = default;
+EventQueue& EventQueue::operator=(EventQueue&&) noexcept = default;
+EventQueue::~EventQueue() = default;
+
+std::optional<EventQueue> EventQueue::Create(size_t capacity) {
+    if (capacity == 0) return std::nullopt;
+
+    size_t n = 1;
+    while (n < capacity) {
+        if (n > std::numeric_limits<size_t>::max() / 2u / sizeof(detail::EventCell)) return std::nullopt;
+        n <<= 1u;
+    }
+
+    std::unique_ptr<detail::EventCell[]> cells(new (std::nothrow) detail::EventCell[n]);
+    if (!cells) return std::nullopt;
+
+    std::unique_ptr<detail::EventQueueState> state(new (std::nothrow) detail::EventQueueState(std::move(cells), n));
+    if (!state) return std::nullopt;
+    return EventQueue(std::move(state));
+}
+
+bool EventQueue::TryPush(const CoreEvent& ev) noexcept {
+    detail::EventQueueState& q = *state_;
+
+    size_t pos = q.tail.load(std::memory_order_relaxed);
+    for (;;) {
+        detail::EventCell& cell = q.cells[pos & q.mask];
+        const size_t seq = cell.seq.load(std::memory_order_acquire);
+        const std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(seq - pos);
+
+        if (lag == 0) {
+            // Free cell: claim the position.
+            if (q.tail.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+                cell.ev = ev;
+                cell.seq.store(pos + 1u, std::memory_order_release);
+                return true;
+            }
+        } else if (lag < 0) {
+            // The cell still holds the event of the previous lap: full.
+            q.dropped.fetch_add(1u, std::memory_order_relaxed);
+            return false;
+        } else {
+            // Another producer claimed pos first.
+            pos = q.tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool EventQueue::TryPop(CoreEvent& out) noexcept {
+    return PopBatch(&out, 1u) == 1u;
+}
+
+size_t EventQueue::PopBatch(CoreEvent* out, size_t max_count) noexcept {
+    if (out == nullptr) return 0;
+
+    detail::EventQueueState& q = *state_;
+    size_t pos = q.head.load(std::memory_order_relaxed);
+
+    size_t n = 0;
+    while (n < max_count) {
+        detail::EventCell& cell = q.cells[pos & q.mask];
+        if (cell.seq.load(std::memory_order_acquire) != pos + 1u) break;
+
+        out[n++] = cell.ev;
+        // Hand the cell to the producer of the next lap.
+        cell.seq.store(pos + q.mask + 1u, std::memory_order_release);
+        pos += 1u;
+    }
+
+    q.head.store(pos, std::memory_order_relaxed);
+    return n;
+}
+
+size_t EventQueue::Capacity() const noexcept {
+    return state_->mask + 1u;
+}
+
+size_t EventQueue::SizeApprox() const noexcept {
+    const size_t tail = state_->tail.load(std::memory_order_relaxed);
+    const size_t head = state_->head.load(std::memory_order_relaxed);
+    return (tail > head) ? tail - head : 0u;
+}
+
+uint64_t EventQueue::Dropped() const noexcept {
+    return state_->dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace maxcore
@@ -0,0 +1,239 @@
+// ==============================
+// File: src/maxcore/exporter.cpp
+// ==============================
+#include "maxcore/exporter.h"
+
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+#include "kernel.h"
+
+namespace maxcore {
+
+namespace {
+
+constexpr const char* kColumns[] = {
+    "t", "lifecycle", "step_counter", "event", "terminal", "collapse_emitted",
+    "phi", "memory", "kappa",
+    "d_phi", "d_memory", "d_kappa", "phi_rate", "memory_rate", "kappa_rate",
+    "kappa_ratio", "kappa_distance", "load_term", "regen_term"
+};
+
+constexpr size_t kColumnCount = sizeof(kColumns) / sizeof(kColumns[0]);
+
+const char* event_name(EventFlag ev) noexcept {
+    switch (ev) {
+        case EventFlag::NORMAL:   return "NORMAL";
+        case EventFlag::COLLAPSE: return "COLLAPSE";
+        case EventFlag::ERROR:    return "ERROR";
+        default:                  return "UNKNOWN";
+    }
+}
+
+// Append-only cursor over a buffer that is known to be large enough.
+class RowWriter {
+public:
+    RowWriter(char* out, const ExportOptions& options) noexcept
+        : begin_(out), p_(out), json_(options.format == ExportFormat::JSONL), precision_(options.precision) {}
+
+    size_t Size() const noexcept { return static_cast<size_t>(p_ - begin_); }
+
+    void Open() noexcept {
+        if (json_) *p_++ = '{';
+    }
+
+    void Close() noexcept {
+        if (json_) *p_++ = '}';
+        *p_++ = '\n';
+    }
+
+    void U64(size_t column, uint64_t v) noexcept {
+        Key(column);
+        p_ = std::to_chars(p_, p_ + 24, v).ptr;
+    }
+
+    void Bool(size_t column, bool v) noexcept {
+        Key(column);
+        if (json_) {
+            Raw(v ? "true" : "false");
+        } else {
+            *p_++ = v ? '1' : '0';
+        }
+    }
+
+    void Text(size_t column, const char* s) noexcept {
+        Key(column);
+        if (json_) *p_++ = '"';
+        Raw(s);
+        if (json_) *p_++ = '"';
+    }
+
+    void F64(size_t column, double v) noexcept {
+        Key(column);
+        if (json_ && !detail::is_finite(v)) {
+            Raw("null");
+            return;
+        }
+        // The caller guarantees kMaxExportRowBytes, which covers any double.
+        char* const end = p_ + 400;
+        p_ = (precision_ < 0) ? std::to_chars(p_, end, v).ptr
+                              : std::to_chars(p_, end, v, std::chars_format::fixed, precision_).ptr;
+    }
+
+private:
+    void Key(size_t column) noexcept {
+        if (column != 0) *p_++ = ',';
+        if (json_) {
+            *p_++ = '"';
+            Raw(kColumns[column]);
+            *p_++ = '"';
+            *p_++ = ':';
+        }
+    }
+
+    void Raw(const char* s) noexcept {
+        const size_t n = std::strlen(s);
+        std::memcpy(p_, s, n);
+        p_ += n;
+    }
+
+    char* begin_;
+    char* p_;
+    bool json_;
+    int precision_;
+};
+
+} // namespace
+
+void TextExporter::FileCloser::operator()(std::FILE* f) const noexcept {
+    if (f != nullptr) std::fclose(f);
+}
+
+TextExporter::TextExporter(std::FILE* file, const ExportOptions& options)
+    : file_(file), options_(options), block_(options.block_bytes) {}
+
+TextExporter::~TextExporter() {
+    Close();
+}
+
+TextExporter& TextExporter::operator=(TextExporter&& other) noexcept {
+    if (this == &other) return *this;
+    Close();
+
+    file_ = std::move(other.file_);
+    options_ = other.options_;
+    block_ = std::move(other.block_);
+    used_ = std::exchange(other.used_, 0u);
+    rows_ = other.rows_;
+    ok_ = other.ok_;
+    return *this;
+}
+
+std::optional<TextExporter> TextExporter::Create(const std::string& path, const ExportOptions& options) {
+    if (options.format != ExportFormat::CSV && options.format != ExportFormat::JSONL) return std::nullopt;
+    if (options.precision > kMaxExportPrecision) return std::nullopt;
+    if (options.block_bytes < kMaxExportRowBytes) return std::nullopt;
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr) return std::nullopt;
+    // Blocks are already large; stdio buffering would only add a copy.
+    std::setvbuf(f, nullptr, _IONBF, 0);
+
+    TextExporter e(f, options);
+    const std::string header = Header(options.format);
+    std::memcpy(e.block_.data(), header.data(), header.size());
+    e.used_ = header.size();
+    return e;
+}
+
+std::string TextExporter::Header(ExportFormat format) {
+    std::string header;
+    if (format != ExportFormat::CSV) return header;
+    for (size_t c = 0; c < kColumnCount; ++c) {
+        if (c != 0) header += ',';
+        header += kColumns[c];
+    }
+    header += '\n';
+    return header;
+}
+
+size_t TextExporter::FormatRow(
+    char* out,
+    const ExportOptions& options,
+    uint64_t t,
+    uint64_t lifecycle_id,
+    EventFlag event,
+    const StructuralState& state,
+    const LifecycleContext& lifecycle,
+    const DerivedFrame& derived
+) noexcept {
+    RowWriter w(out, options);
+    w.Open();
+    w.U64(0, t);
+    w.U64(1, lifecycle_id);
+    w.U64(2, lifecycle.step_counter);
+    w.Text(3, event_name(event));
+    w.Bool(4, lifecycle.terminal);
+    w.Bool(5, lifecycle.collapse_emitted);
+    w.F64(6, state.phi);
+    w.F64(7, state.memory);
+    w.F64(8, state.kappa);
+    w.F64(9, derived.d_phi);
+    w.F64(10, derived.d_memory);
+    w.F64(11, derived.d_kappa);
+    w.F64(12, derived.phi_rate);
+    w.F64(13, derived.memory_rate);
+    w.F64(14, derived.kappa_rate);
+    w.F64(15, derived.kappa_ratio);
+    w.F64(16, derived.kappa_distance);
+    w.F64(17, derived.load_term);
+    w.F64(18, derived.regen_term);
+    w.Close();
+    return w.Size();
+}
+
+bool TextExporter::Append(
+    uint64_t t,
+    uint64_t lifecycle_id,
+    EventFlag event,
+    const StructuralState& state,
+    const LifecycleContext& lifecycle,
+    const DerivedFrame& derived
+) noexcept {
+    if (!ok_ || !file_) return false;
+
+    if (block_.size() - used_ < kMaxExportRowBytes && !Flush()) return false;
+    used_ += FormatRow(block_.data() + used_, options_, t, lifecycle_id, event, state, lifecycle, derived);
+    rows_ += 1u;
+    return true;
+}
+
+bool TextExporter::Append(
+    uint64_t t,
+    uint64_t lifecycle_id,
+    EventFlag event,
+    const MaxCore& core,
+    const DerivedFrame& derived
+) noexcept {
+    return Append(t, lifecycle_id, event, core.Current(), core.Lifecycle(), derived);
+}
+
+bool TextExporter::Flush() noexcept {
+    if (!ok_ || !file_) return false;
+    if (used_ == 0) return true;
+
+    ok_ = std::fwrite(block_.data(), 1, used_, file_.get()) == used_;
+    used_ = 0;
+    return ok_;
+}
+
+bool TextExporter::Close() noexcept {
+    if (!file_) return ok_;
+
+    ok_ = Flush();
+    ok_ = (std::fclose(file_.release()) == 0) && ok_;
+    return ok_;
+}
+
+} // namespace maxcore
@@ -0,0 +1,13 @@
+// ==============================
+// File: src/maxcore/fixed.cpp
+// ==============================
+#include "maxcore/fixed.h"
+
+namespace maxcore {
+
+// Production dimensions, compiled under the library's strict FP flags.
+template class MaxCoreFixed<2>;
+template class MaxCoreFixed<3>;
+template class MaxCoreFixed<8>;
+
+} // namespace maxcore
@@ -0,0 +1,442 @@
+// ==============================
+// File: src/maxcore/kernel.h
+// ==============================
+#ifndef MAXCORE_KERNEL_H
+#define MAXCORE_KERNEL_H
+
+// Private canonical kernel shared by every engine front-end.
+// Each helper implements one numbered phase of MaxCore::Step with the exact
+// operation order of the specification. Front-ends MUST NOT re-implement
+// these phases, otherwise bitwise parity between them is lost.
+//
+// Helpers are templated on the scalar type S (double is the canonical
+// engine, float the single-precision variant). Every operation stays in S;
+// literals are converted to S so no step is silently widened.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+
+#include "maxcore/reduction.h"
+#include "maxcore/types.h"
+
+namespace maxcore {
+namespace detail {
+
+template <typename S>
+inline bool is_finite(S x) noexcept {
+    return std::isfinite(x) != 0;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+
+template <typename S>
+inline bool is_zero(S x) noexcept {
+    return x == S(0);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+template <typename S>
+inline S clamp_range(S x, S lo, S hi) noexcept {
+    if (x < lo) return lo;
+    if (x > hi) return hi;
+    return x;
+}
+
+template <typename S>
+inline bool validate_params(const BasicParameterSet<S>& p) noexcept {
+    const S vals[] = {
+        p.alpha, p.eta, p.beta, p.gamma, p.rho, p.lambda_phi, p.lambda_m, p.kappa_max
+    };
+
+    for (S v : vals) {
+        if (!is_finite(v) || !(v > S(0))) return false;
+    }
+    return true;
+}
+
+template <typename S>
+inline bool validate_initial_state(const BasicStructuralState<S>& s, S kappa_max) noexcept {
+    if (!is_finite(s.phi) || !is_finite(s.memory) || !is_finite(s.kappa)) return false;
+    if (s.phi < S(0)) return false;
+    if (s.memory < S(0)) return false;
+    if (s.kappa < S(0)) return false;
+    if (s.kappa > kappa_max) return false;
+    return true;
+}
+
+template <typename S>
+inline bool validate_delta_max(const std::optional<S>& delta_max) noexcept {
+    if (!delta_max.has_value()) return true;
+    const S dm = *delta_max;
+    return is_finite(dm) && (dm > S(0));
+}
+
+template <typename S>
+inline S max_rate(const BasicParameterSet<S>& p) noexcept {
+    S r = p.eta;
+    r = std::max(r, p.gamma);
+    r = std::max(r, p.rho);
+    r = std::max(r, p.lambda_phi);
+    r = std::max(r, p.lambda_m);
+    return r;
+}
+
+// 2-3) dt validation and stability check (dt * max_rate < 1), with max_rate hoisted
+template <typename S>
+inline bool admit_dt_rate(S mr, S dt) noexcept {
+    if (!is_finite(dt) || !(dt > S(0))) return false;
+    if (!is_finite(mr)) return false;
+
+    const S prod = dt * mr;
+    if (!is_finite(prod)) return false;
+    if (!(prod < S(1))) return false;
+    return true;
+}
+
+// 2-3) dt validation and stability check (dt * max_rate < 1)
+template <typename S>
+inline bool admit_dt(const BasicParameterSet<S>& p, S dt) noexcept {
+    return admit_dt_rate(max_rate(p), dt);
+}
+
+// 5) Accumulated norm2 MUST be finite and non-negative
+template <typename S>
+inline bool admit_norm2(S norm2) noexcept {
+    return is_finite(norm2) && !(norm2 < S(0));
+}
+
+// 5) Delta processing (deterministic serial norm2, left to right)
+template <typename S>
+inline bool accumulate_norm2(const S* delta_input, size_t delta_dim, S& norm2_out) noexcept {
+    S norm2 = S(0);
+    for (size_t i = 0; i < delta_dim; ++i) {
+        const S v = delta_input[i];
+        if (!is_finite(v)) return false;
+        const S term = v * v;
+        norm2 += term;
+    }
+    if (!admit_norm2(norm2)) return false;
+
+    norm2_out = norm2;
+    return true;
+}
+
+// 5) norm2 in the configured reduction order. LANES4 lets non-finite components
+// propagate into norm2, which admit_norm2 then rejects.
+inline bool accumulate_norm2(
+    ReductionMode reduction,
+    const double* delta_input,
+    size_t delta_dim,
+    double& norm2_out
+) noexcept {
+    if (reduction == ReductionMode::LANES4) {
+        norm2_out = Norm2Lanes4(delta_input, delta_dim);
+        return admit_norm2(norm2_out);
+    }
+    return accumulate_norm2(delta_input, delta_dim, norm2_out);
+}
+
+// 5b) Optional norm guard (preserve direction by uniform scaling)
+template <typename S>
+inline bool apply_norm_guard(const std::optional<S>& delta_max, S& norm2) noexcept {
+    if (!delta_max.has_value()) return true;
+
+    const S dm = *delta_max;
+    if (!is_finite(dm) || !(dm > S(0))) return false;
+
+    const S dm2 = dm * dm;
+    if (!is_finite(dm2)) return false;
+
+    if (norm2 > dm2) {
+        // scale = dm / ||delta||, applied uniformly to all components (direction preserved)
+        const S n = std::sqrt(norm2);
+        if (!is_finite(n) || !(n > S(0))) return false;
+
+        const S scale = dm / n;
+        if (!is_finite(scale) || !(scale > S(0))) return false;
+
+        // For this canonical model, only norm2 is used downstream.
+        // Uniform scaling implies norm2_scaled = (scale^2) * norm2 == dm^2.
+        norm2 = dm2;
+    }
+    return true;
+}
+
+// 6-9) Canonical update of the candidate state, including clamps.
+// load_phi / load_m receive lambda_phi * Phi_next and lambda_m * Memory_next
+// (the clamped values), i.e. the load products of the committed state.
+template <typename S>
+inline bool canonical_update(
+    const BasicParameterSet<S>& p,
+    const BasicStructuralState<S>& current,
+    S norm2,
+    S dt,
+    BasicStructuralState<S>& next,
+    S& load_phi,
+    S& load_m
+) noexcept {
+    // 6) Energy update (canonical)
+    S phi_next = current.phi + (p.alpha * norm2) - (p.eta * current.phi * dt);
+    if (!is_finite(phi_next)) return false;
+    if (phi_next < S(0)) phi_next = S(0);
+
+    // 7) Memory update (canonical, uses Phi_next)
+    S memory_next =
+        current.memory
+        + (p.beta * phi_next * dt)
+        - (p.gamma * current.memory * dt);
+    if (!is_finite(memory_next)) return false;
+    if (memory_next < S(0)) memory_next = S(0);
+
+    // 8) Stability update (canonical)
+    const S lphi = p.lambda_phi * phi_next;
+    const S lm = p.lambda_m * memory_next;
+    S kappa_next =
+        current.kappa
+        + (p.rho * (p.kappa_max - current.kappa) * dt)
+        - (lphi * dt)
+        - (lm * dt);
+    if (!is_finite(kappa_next)) return false;
+
+    // 9) Invariants MUST be enforced before commit (clamps)
+    kappa_next = clamp_range(kappa_next, S(0), p.kappa_max);
+
+    if (!is_finite(phi_next) || !is_finite(memory_next) || !is_finite(kappa_next)) {
+        return false;
+    }
+
+    next.phi = phi_next;
+    next.memory = memory_next;
+    next.kappa = kappa_next;
+    load_phi = lphi;
+    load_m = lm;
+    return true;
+}
+
+template <typename S>
+inline bool canonical_update(
+    const BasicParameterSet<S>& p,
+    const BasicStructuralState<S>& current,
+    S norm2,
+    S dt,
+    BasicStructuralState<S>& next
+) noexcept {
+    S load_phi = S(0);
+    S load_m = S(0);
+    return canonical_update(p, current, norm2, dt, next, load_phi, load_m);
+}
+
+// 10) Collapse detection (before commit)
+template <typename S>
+inline bool collapse_edge(S kappa_current, S kappa_next) noexcept {
+    return (kappa_current > S(0)) && is_zero(kappa_next);
+}
+
+// 5) float has a single (serial) reduction order.
+inline bool accumulate_norm2(
+    ReductionMode /*reduction*/,
+    const float* delta_input,
+    size_t delta_dim,
+    float& norm2_out
+) noexcept {
+    return accumulate_norm2(delta_input, delta_dim, norm2_out);
+}
+
+// Validated configuration read by one step. Front-ends keep it in whatever
+// layout they like and hand it over by reference.
+template <typename S>
+struct StepConfig {
+    const BasicParameterSet<S>& params;
+    S max_rate;  // max_rate(params)
+    size_t delta_dim;
+    const std::optional<S>& delta_max;
+    ReductionMode reduction;
+};
+
+// 4-12) Commit of an admitted norm2: norm guard, canonical update, collapse
+// edge, AtomicCommit and lifecycle update. current / previous / lifecycle are
+// only written on success. The caller guarantees a non-terminal entity and an
+// admitted dt.
+template <typename S>
+inline EventFlag commit_norm2(
+    const BasicParameterSet<S>& p,
+    const std::optional<S>& delta_max,
+    S norm2,
+    S dt,
+    BasicStructuralState<S>& current,
+    BasicStructuralState<S>& previous,
+    LifecycleContext& lifecycle,
+    StepStatus& status,
+    S& load_phi,
+    S& load_m
+) noexcept {
+    // 5b) Optional norm guard
+    if (!apply_norm_guard(delta_max, norm2)) {
+        status = StepStatus::NORM_GUARD;
+        return EventFlag::ERROR;
+    }
+
+    // 4, 6-9) Candidate state, canonical updates + clamps
+    BasicStructuralState<S> next = current;
+    if (!canonical_update(p, current, norm2, dt, next, load_phi, load_m)) {
+        status = StepStatus::NUMERIC_FAILURE;
+        return EventFlag::ERROR;
+    }
+
+    // 10) Collapse detection MUST occur before commit
+    const bool collapse_now = collapse_edge(current.kappa, next.kappa);
+
+    // 11) AtomicCommit (the only mutation boundary)
+    previous = current;
+    current = next;
+
+    lifecycle.step_counter += 1u;
+    lifecycle.terminal = is_zero(current.kappa);
+    if (collapse_now) {
+        lifecycle.collapse_emitted = true;
+    }
+    status = StepStatus::OK;
+
+    // 12) Return EventFlag
+    return collapse_now ? EventFlag::COLLAPSE : EventFlag::NORMAL;
+}
+
+// 5-12) Step of a non-terminal entity whose input pointer, length and dt were
+// already admitted (e.g. once per batch call).
+template <typename S>
+inline EventFlag step_admitted(
+    const StepConfig<S>& cfg,
+    const S* delta_input,
+    S dt,
+    BasicStructuralState<S>& current,
+    BasicStructuralState<S>& previous,
+    LifecycleContext& lifecycle,
+    StepStatus& status,
+    S& load_phi,
+    S& load_m
+) noexcept {
+    // 5) Delta processing (deterministic norm2)
+    S norm2 = S(0);
+    if (!accumulate_norm2(cfg.reduction, delta_input, cfg.delta_dim, norm2)) {
+        status = StepStatus::DELTA_NON_FINITE;
+        return EventFlag::ERROR;
+    }
+    return commit_norm2(cfg.params, cfg.delta_max, norm2, dt, current, previous, lifecycle, status, load_phi, load_m);
+}
+
+// 1-3) Terminal short-circuit, input and dt checks. Returns false when the step
+// ends here, with its EventFlag in `ev` (nothing is committed).
+template <typename S>
+inline bool admit_step(
+    const StepConfig<S>& cfg,
+    const S* delta_input,
+    size_t delta_len,
+    S dt,
+    const BasicStructuralState<S>& current,
+    StepStatus& status,
+    EventFlag& ev
+) noexcept {
+    // 1) Terminal short-circuit MUST execute before validation
+    if (is_zero(current.kappa)) {
+        status = StepStatus::TERMINAL;
+        ev = EventFlag::NORMAL;
+        return false;
+    }
+
+    ev = EventFlag::ERROR;
+
+    // 2) Input validation MUST precede computation
+    if (delta_input == nullptr) {
+        status = StepStatus::NULL_INPUT;
+        return false;
+    }
+    if (delta_len != cfg.delta_dim) {
+        status = StepStatus::DIM_MISMATCH;
+        return false;
+    }
+
+    // 3) dt stability check MUST precede canonical updates
+    if (!admit_dt_rate(cfg.max_rate, dt)) {
+        status = (is_finite(dt) && dt > S(0)) ? StepStatus::DT_UNSTABLE : StepStatus::DT_INVALID;
+        return false;
+    }
+    return true;
+}
+
+// 1-12) The full MaxCore::Step contract. Every front-end steps through this
+// function (or its admitted tails above), so they agree bitwise by construction.
+template <typename S>
+inline EventFlag canonical_step(
+    const StepConfig<S>& cfg,
+    const S* delta_input,
+    size_t delta_len,
+    S dt,
+    BasicStructuralState<S>& current,
+    BasicStructuralState<S>& previous,
+    LifecycleContext& lifecycle,
+    StepStatus& status,
+    S& load_phi,
+    S& load_m
+) noexcept {
+    EventFlag ev = EventFlag::NORMAL;
+    if (!admit_step(cfg, delta_input, delta_len, dt, current, status, ev)) return ev;
+
+    return step_admitted(cfg, delta_input, dt, current, previous, lifecycle, status, load_phi, load_m);
+}
+
+// 1-12) canonical_step for a caller that ran phase 5 itself (e.g. an unrolled
+// serial-order kernel): `delta_finite` and `norm2` stand in for accumulate_norm2.
+template <typename S>
+inline EventFlag canonical_step_norm2(
+    const StepConfig<S>& cfg,
+    const S* delta_input,
+    size_t delta_len,
+    S dt,
+    bool delta_finite,
+    S norm2,
+    BasicStructuralState<S>& current,
+    BasicStructuralState<S>& previous,
+    LifecycleContext& lifecycle,
+    StepStatus& status,
+    S& load_phi,
+    S& load_m
+) noexcept {
+    EventFlag ev = EventFlag::NORMAL;
+    if (!admit_step(cfg, delta_input, delta_len, dt, current, status, ev)) return ev;
+
+    // 5) Component finiteness and norm2 as accumulate_norm2 would report them
+    if (!delta_finite || !admit_norm2(norm2)) {
+        status = StepStatus::DELTA_NON_FINITE;
+        return EventFlag::ERROR;
+    }
+    return commit_norm2(cfg.params, cfg.delta_max, norm2, dt, current, previous, lifecycle, status, load_phi, load_m);
+}
+
+template <typename S>
+inline EventFlag canonical_step(
+    const StepConfig<S>& cfg,
+    const S* delta_input,
+    size_t delta_len,
+    S dt,
+    BasicStructuralState<S>& current,
+    BasicStructuralState<S>& previous,
+    LifecycleContext& lifecycle,
+    StepStatus& status
+) noexcept {
+    S load_phi = S(0);
+    S load_m = S(0);
+    return canonical_step(cfg, delta_input, delta_len, dt, current, previous, lifecycle, status, load_phi, load_m);
+}
+
+} // namespace detail
+} // namespace maxcore
+
+#endif // MAXCORE_KERNEL_H
@@ -0,0 +1,126 @@
+// ==============================
+// File: src/maxcore/lazy_store.cpp
+// ==============================
+#include "maxcore/lazy_store.h"
+
+#include "affine.h"
+#include "kernel.h"
+
+namespace maxcore {
+
+using detail::is_zero;
+
+LazyEntityStore::LazyEntityStore(const ParameterProfile& profile, double dt, CatchUpMode mode) noexcept
+    : profile_(profile),
+      dt_(dt),
+      mode_(mode),
+      now_(0u) {}
+
+std::optional<LazyEntityStore> LazyEntityStore::Create(
+    const ParameterProfile& profile,
+    double dt,
+    CatchUpMode mode
+) {
+    if (!detail::admit_dt_rate(profile.MaxRate(), dt)) return std::nullopt;
+    if (mode != CatchUpMode::CLOSED_FORM && mode != CatchUpMode::EXACT) return std::nullopt;
+
+    return LazyEntityStore(profile, dt, mode);
+}
+
+std::optional<size_t> LazyEntityStore::Add(const StructuralState& initial_state) {
+    if (!detail::validate_initial_state(initial_state, profile_.Params().kappa_max)) return std::nullopt;
+
+    entities_.push_back(Entity{initial_state, initial_state,
+                               LifecycleContext{0u, is_zero(initial_state.kappa), false}, now_});
+    return entities_.size() - 1u;
+}
+
+EventFlag LazyEntityStore::Input(size_t entity, const double* delta_input, size_t delta_len) {
+    Entity& e = entities_[entity];
+
+    // The entity's step of the current tick has already been taken.
+    if (e.next_tick > now_) return EventFlag::ERROR;
+
+    CatchUp(entity, e);
+    e.next_tick = now_ + 1u;
+
+    // dt was admitted by Create(); the canonical step re-checks it at no real cost.
+    const detail::StepConfig<double> cfg{
+        profile_.Params(), profile_.MaxRate(), profile_.DeltaDim(), profile_.DeltaMax(), profile_.Reduction()
+    };
+    StepStatus status = StepStatus::OK;
+    const EventFlag ev = detail::canonical_step(cfg, delta_input, delta_len, dt_, e.current, e.previous, e.lifecycle, status);
+    if (ev == EventFlag::COLLAPSE) collapses_.push_back(CollapseRecord{entity, now_});
+    return ev;
+}
+
+void LazyEntityStore::Sync(size_t entity) {
+    CatchUp(entity, entities_[entity]);
+}
+
+void LazyEntityStore::SyncAll() {
+    for (size_t i = 0; i < entities_.size(); ++i) {
+        CatchUp(i, entities_[i]);
+    }
+}
+
+const StructuralState& LazyEntityStore::Current(size_t entity) {
+    Sync(entity);
+    return entities_[entity].current;
+}
+
+const StructuralState& LazyEntityStore::Previous(size_t entity) {
+    Sync(entity);
+    return entities_[entity].previous;
+}
+
+LifecycleContext LazyEntityStore::Lifecycle(size_t entity) {
+    Sync(entity);
+    return entities_[entity].lifecycle;
+}
+
+void LazyEntityStore::CatchUp(size_t id, Entity& e) {
+    if (e.next_tick >= now_) return;
+
+    uint64_t tick = e.next_tick;
+    e.next_tick = now_;
+
+    // Skipped ticks of a terminal entity are short-circuited steps.
+    if (is_zero(e.current.kappa)) return;
+
+    // A zero delta has norm2 == 0 in every reduction order and passes the guard.
+    const ParameterSet& p = profile_.Params();
+
+    if (mode_ == CatchUpMode::CLOSED_FORM) {
+        // The MaxCore::Advance schedule. Within the gap the collapse tick is that
+        // of stepping from the entity's state at next_tick; a tie falls through to
+        // exact steps below.
+        const uint64_t counter0 = e.lifecycle.step_counter;
+        bool jumped = false;
+        bool tie = false;
+        const EventFlag ev = detail::affine_advance(p, profile_.DeltaMax(), 0.0, dt_, e.current, e.previous,
+                                                    e.lifecycle, now_ - tick, jumped, tie);
+        if (!tie) {
+            if (ev == EventFlag::COLLAPSE) {
+                collapses_.push_back(CollapseRecord{id, tick + (e.lifecycle.step_counter - counter0) - 1u});
+            }
+            return;
+        }
+    }
+
+    for (; tick < now_; ++tick) {
+        if (Commit(id, e, 0.0, tick) != EventFlag::NORMAL) return;
+    }
+}
+
+EventFlag LazyEntityStore::Commit(size_t id, Entity& e, double norm2, uint64_t tick) {
+    StepStatus status = StepStatus::OK;
+    double load_phi = 0.0;
+    double load_m = 0.0;
+    const EventFlag ev = detail::commit_norm2(profile_.Params(), profile_.DeltaMax(), norm2, dt_, e.current, e.previous,
+                                              e.lifecycle, status, load_phi, load_m);
+    if (ev == EventFlag::COLLAPSE) collapses_.push_back(CollapseRecord{id, tick});
+    return ev;
+}
+
+} // namespace maxcore
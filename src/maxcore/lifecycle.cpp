@@ -0,0 +1,63 @@
+// ==============================
+// File: src/maxcore/lifecycle.cpp
+// ==============================
+#include "maxcore/lifecycle.h"
+
+#include <algorithm>
+
+namespace maxcore {
+
+LifecycleRunner::LifecycleRunner(const MaxCore& core, const StructuralState& genesis_state) noexcept
+    : core_(core),
+      genesis_(genesis_state),
+      min_kappa_(genesis_state.kappa) {}
+
+std::optional<LifecycleRunner> LifecycleRunner::Create(
+    const ParameterSet& params,
+    size_t delta_dim,
+    const StructuralState& genesis_state,
+    std::optional<double> delta_max
+) {
+    const std::optional<MaxCore> core = MaxCore::Create(params, delta_dim, genesis_state, delta_max);
+    if (!core) return std::nullopt;
+    return LifecycleRunner(*core, genesis_state);
+}
+
+EventFlag LifecycleRunner::Step(const double* delta_input, size_t delta_len, double dt) {
+    const EventFlag ev = core_.Step(delta_input, delta_len, dt);
+    if (ev != EventFlag::ERROR) {
+        min_kappa_ = std::min(min_kappa_, core_.Current().kappa);
+    }
+    return ev;
+}
+
+EventFlag LifecycleRunner::StepWithDerived(
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    std::optional<DerivedFrame>& derived
+) {
+    const EventFlag ev = core_.StepWithDerived(delta_input, delta_len, dt, derived);
+    if (ev != EventFlag::ERROR) {
+        min_kappa_ = std::min(min_kappa_, core_.Current().kappa);
+    }
+    return ev;
+}
+
+LifecycleSummary LifecycleRunner::Running() const noexcept {
+    const LifecycleContext& lc = core_.Lifecycle();
+    return LifecycleSummary{lifecycle_id_, lc.step_counter, min_kappa_, lc.collapse_emitted};
+}
+
+LifecycleSummary LifecycleRunner::Genesis() {
+    const LifecycleSummary closed = Running();
+    history_.push_back(closed);
+
+    // genesis_ was validated by Create(), so the in-place reset cannot fail.
+    core_.Genesis(genesis_);
+    lifecycle_id_ += 1u;
+    min_kappa_ = genesis_.kappa;
+    return closed;
+}
+
+} // namespace maxcore
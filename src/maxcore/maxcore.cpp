@@ -4,72 +4,25 @@
 #include "maxcore/maxcore.h"
 
 #include <algorithm>
-#include <cmath>
-#include <limits>
 
-namespace maxcore {
-
-static inline bool is_finite(double x) noexcept {
-    return std::isfinite(x) != 0;
-}
-
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wfloat-equal"
-#endif
-
-static inline bool is_zero(double x) noexcept {
-    return x == 0.0;
-}
-
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic pop
-#endif
-
-static inline double clamp_range(double x, double lo, double hi) noexcept {
-    if (x < lo) return lo;
-    if (x > hi) return hi;
-    return x;
-}
-
-static bool validate_params(const ParameterSet& p) noexcept {
-    const double vals[] = {
-        p.alpha, p.eta, p.beta, p.gamma, p.rho, p.lambda_phi, p.lambda_m, p.kappa_max
-    };
-
-    for (double v : vals) {
-        if (!is_finite(v) || !(v > 0.0)) return false;
-    }
-    return true;
-}
+#include "affine.h"
+#include "kernel.h"
 
-static bool validate_initial_state(const StructuralState& s, double kappa_max) noexcept {
-    if (!is_finite(s.phi) || !is_finite(s.memory) || !is_finite(s.kappa)) return false;
-    if (s.phi < 0.0) return false;
-    if (s.memory < 0.0) return false;
-    if (s.kappa < 0.0) return false;
-    if (s.kappa > kappa_max) return false;
-    return true;
-}
+namespace maxcore {
 
-static inline double max_rate(const ParameterSet& p) noexcept {
-    double r = p.eta;
-    r = std::max(r, p.gamma);
-    r = std::max(r, p.rho);
-    r = std::max(r, p.lambda_phi);
-    r = std::max(r, p.lambda_m);
-    return r;
-}
+using detail::is_zero;
 
 MaxCore::MaxCore(
     const ParameterSet& params,
     size_t delta_dim,
     const StructuralState& initial_state,
-    std::optional<double> delta_max
+    std::optional<double> delta_max,
+    ReductionMode reduction
 ) noexcept
     : params_(params),
       delta_dim_(delta_dim),
       delta_max_(delta_max),
+      reduction_(reduction),
       current_(initial_state),
       previous_(initial_state),
       lifecycle_{0u, is_zero(initial_state.kappa), false} {}
@@ -78,129 +31,248 @@ std::optional<MaxCore> MaxCore::Create(
     const ParameterSet& params,
     size_t delta_dim,
     const StructuralState& initial_state,
-    std::optional<double> delta_max
+    std::optional<double> delta_max,
+    ReductionMode reduction
 ) {
     if (delta_dim == 0) return std::nullopt;
-    if (!validate_params(params)) return std::nullopt;
-    if (!validate_initial_state(initial_state, params.kappa_max)) return std::nullopt;
+    if (!detail::validate_params(params)) return std::nullopt;
+    if (!detail::validate_initial_state(initial_state, params.kappa_max)) return std::nullopt;
+    if (!detail::validate_delta_max(delta_max)) return std::nullopt;
+    if (reduction != ReductionMode::SERIAL && reduction != ReductionMode::LANES4) return std::nullopt;
 
-    if (delta_max.has_value()) {
-        const double dm = *delta_max;
-        if (!is_finite(dm) || !(dm > 0.0)) return std::nullopt;
-    }
+    return MaxCore(params, delta_dim, initial_state, delta_max, reduction);
+}
 
-    return MaxCore(params, delta_dim, initial_state, delta_max);
+bool MaxCore::Genesis(const StructuralState& initial_state) noexcept {
+    if (!detail::validate_initial_state(initial_state, params_.kappa_max)) return false;
+
+    current_ = initial_state;
+    previous_ = initial_state;
+    lifecycle_ = LifecycleContext{0u, is_zero(initial_state.kappa), false};
+    return true;
 }
 
 EventFlag MaxCore::Step(
     const double* delta_input,
     size_t delta_len,
     double dt
+) {
+    StepStatus status = StepStatus::OK;
+    return Step(delta_input, delta_len, dt, status);
+}
+
+EventFlag MaxCore::Step(
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    StepStatus& status
+) {
+    double load_phi = 0.0;
+    double load_m = 0.0;
+    return StepChecked(delta_input, delta_len, dt, status, load_phi, load_m);
+}
+
+EventFlag MaxCore::StepChecked(
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    StepStatus& status,
+    double& load_phi,
+    double& load_m
+) noexcept {
+    const detail::StepConfig<double> cfg{params_, detail::max_rate(params_), delta_dim_, delta_max_, reduction_};
+    return detail::canonical_step(cfg, delta_input, delta_len, dt, current_, previous_, lifecycle_, status, load_phi, load_m);
+}
+
+bool MaxCore::AccumulateNorm2(const double* delta_input, double& norm2) const noexcept {
+    return detail::accumulate_norm2(reduction_, delta_input, delta_dim_, norm2);
+}
+
+EventFlag MaxCore::StepAdmitted(const double* delta_input, double dt) noexcept {
+    // max_rate is not read past phase 3.
+    const detail::StepConfig<double> cfg{params_, 0.0, delta_dim_, delta_max_, reduction_};
+    StepStatus status = StepStatus::OK;
+    double load_phi = 0.0;
+    double load_m = 0.0;
+    return detail::step_admitted(cfg, delta_input, dt, current_, previous_, lifecycle_, status, load_phi, load_m);
+}
+
+EventFlag MaxCore::StepNorm2(const double* delta_input, bool delta_finite, double norm2, double dt) noexcept {
+    const detail::StepConfig<double> cfg{params_, detail::max_rate(params_), delta_dim_, delta_max_, reduction_};
+    StepStatus status = StepStatus::OK;
+    double load_phi = 0.0;
+    double load_m = 0.0;
+    return detail::canonical_step_norm2(cfg, delta_input, delta_dim_, dt, delta_finite, norm2, current_, previous_,
+                                        lifecycle_, status, load_phi, load_m);
+}
+
+EventFlag MaxCore::CommitNorm2(double norm2, double dt) noexcept {
+    StepStatus status = StepStatus::OK;
+    double load_phi = 0.0;
+    double load_m = 0.0;
+    return detail::commit_norm2(params_, delta_max_, norm2, dt, current_, previous_, lifecycle_, status, load_phi, load_m);
+}
+
+EventFlag MaxCore::StepWithDerived(
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    std::optional<DerivedFrame>& derived
+) {
+    StepStatus status = StepStatus::OK;
+    return StepWithDerived(delta_input, delta_len, dt, derived, status);
+}
+
+EventFlag MaxCore::StepWithDerived(
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    std::optional<DerivedFrame>& derived,
+    StepStatus& status
+) {
+    double load_phi = 0.0;
+    double load_m = 0.0;
+    const EventFlag ev = StepChecked(delta_input, delta_len, dt, status, load_phi, load_m);
+
+    if (status != StepStatus::OK) {
+        // Nothing committed (terminal or ERROR): the state is the one the caller
+        // would project, so the plain projection is the reference.
+        derived = ComputeDerived(current_, previous_, lifecycle_, params_, dt);
+        return ev;
+    }
+
+    // Committed: dt is admitted, params are validated, previous_ and current_ are
+    // finite and 0 <= Kappa <= kappa_max, so only the arithmetic can overflow.
+    // Same operations in the same order as ComputeDerived.
+    DerivedFrame f{};
+    f.d_phi = current_.phi - previous_.phi;
+    f.d_memory = current_.memory - previous_.memory;
+    f.d_kappa = current_.kappa - previous_.kappa;
+    f.phi_rate = f.d_phi / dt;
+    f.memory_rate = f.d_memory / dt;
+    f.kappa_rate = f.d_kappa / dt;
+    const double ratio = current_.kappa / params_.kappa_max;
+    f.kappa_ratio = std::max(0.0, std::min(1.0, ratio));
+    f.kappa_distance = current_.kappa;
+    f.load_term = load_phi + load_m;
+    f.regen_term = params_.rho * (params_.kappa_max - current_.kappa);
+    f.step_counter = lifecycle_.step_counter;
+    f.terminal = lifecycle_.terminal;
+    f.collapse_emitted = lifecycle_.collapse_emitted;
+
+    // A finite rate implies a finite delta.
+    if (detail::is_finite(f.phi_rate) && detail::is_finite(f.memory_rate) && detail::is_finite(f.kappa_rate) &&
+        detail::is_finite(ratio) && detail::is_finite(f.load_term) && detail::is_finite(f.regen_term)) {
+        derived = f;
+    } else {
+        derived.reset();
+    }
+    return ev;
+}
+
+SequenceResult MaxCore::StepSequence(
+    const double* deltas,
+    size_t steps,
+    size_t stride,
+    double dt
 ) {
     // 1) Terminal short-circuit MUST execute before validation
-    if (is_zero(current_.kappa)) {
-        return EventFlag::NORMAL;
+    if (is_zero(current_.kappa) || steps == 0) {
+        return SequenceResult{0u, steps, EventFlag::NORMAL};
     }
 
-    // 2) Input validation MUST precede computation
-    if (delta_input == nullptr) return EventFlag::ERROR;
-    if (delta_len != delta_dim_) return EventFlag::ERROR;
-    if (!is_finite(dt) || !(dt > 0.0)) return EventFlag::ERROR;
+    // 2-3) Validation runs once for the whole block
+    if (deltas == nullptr || stride < delta_dim_ || !detail::admit_dt(params_, dt)) {
+        return SequenceResult{0u, 0u, EventFlag::ERROR};
+    }
 
-    // 3) dt stability check MUST precede canonical updates
-    const double mr = max_rate(params_);
-    if (!is_finite(mr)) return EventFlag::ERROR;
+    for (size_t i = 0; i < steps; ++i) {
+        const EventFlag ev = StepAdmitted(deltas + i * stride, dt);
+        if (ev == EventFlag::COLLAPSE) return SequenceResult{i + 1u, i, ev};
+        if (ev == EventFlag::ERROR) return SequenceResult{i, i, ev};
+    }
 
-    const double prod = dt * mr;
-    if (!is_finite(prod)) return EventFlag::ERROR;
-    if (!(prod < 1.0)) return EventFlag::ERROR;
+    return SequenceResult{steps, steps, EventFlag::NORMAL};
+}
 
-    // 4) Candidate state MUST be created before mutation
-    StructuralState next = current_;
+SequenceResult MaxCore::StepSequence(
+    const double* deltas,
+    size_t steps,
+    size_t stride,
+    const double* dts
+) {
+    // 1) Terminal short-circuit MUST execute before validation
+    if (is_zero(current_.kappa) || steps == 0) {
+        return SequenceResult{0u, steps, EventFlag::NORMAL};
+    }
 
-    // 5) Delta processing (deterministic norm2)
-    double norm2 = 0.0;
-    for (size_t i = 0; i < delta_dim_; ++i) {
-        const double v = delta_input[i];
-        if (!is_finite(v)) return EventFlag::ERROR;
-        const double term = v * v;
-        norm2 += term;
+    // 2) Pointer/stride validation runs once for the whole block
+    if (deltas == nullptr || dts == nullptr || stride < delta_dim_) {
+        return SequenceResult{0u, 0u, EventFlag::ERROR};
     }
-    if (!is_finite(norm2) || norm2 < 0.0) return EventFlag::ERROR;
 
-// Optional norm guard (preserve direction by uniform scaling)
-if (delta_max_.has_value()) {
-    const double dm = *delta_max_;
-    if (!is_finite(dm) || !(dm > 0.0)) return EventFlag::ERROR;
+    const double mr = detail::max_rate(params_);
 
-    const double dm2 = dm * dm;
-    if (!is_finite(dm2)) return EventFlag::ERROR;
+    for (size_t i = 0; i < steps; ++i) {
+        // 3) Per-row dt stability check (max_rate hoisted)
+        if (!detail::admit_dt_rate(mr, dts[i])) return SequenceResult{i, i, EventFlag::ERROR};
 
-    if (norm2 > dm2) {
-        // scale = dm / ||delta||, applied uniformly to all components (direction preserved)
-        const double n = std::sqrt(norm2);
-        if (!is_finite(n) || !(n > 0.0)) return EventFlag::ERROR;
+        const EventFlag ev = StepAdmitted(deltas + i * stride, dts[i]);
+        if (ev == EventFlag::COLLAPSE) return SequenceResult{i + 1u, i, ev};
+        if (ev == EventFlag::ERROR) return SequenceResult{i, i, ev};
+    }
 
-        const double scale = dm / n;
-        if (!is_finite(scale) || !(scale > 0.0)) return EventFlag::ERROR;
+    return SequenceResult{steps, steps, EventFlag::NORMAL};
+}
 
-        // For this canonical model, only norm2 is used downstream.
-        // Uniform scaling implies norm2_scaled = (scale^2) * norm2 == dm^2.
-        norm2 = dm2;
+EventFlag MaxCore::Advance(
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    uint64_t k
+) {
+    bool jumped = false;
+    bool tie = false;
+    const EventFlag ev = AdvanceChained(delta_input, delta_len, dt, k, jumped, tie);
+    if (!tie) return ev;
 
-        // (Optional sanity) Ensure computed equivalence holds:
-        // const double norm2_scaled = (scale * scale) * norm2_original;
-        // but we intentionally avoid extra ops to preserve determinism and performance.
+    // Rounding-level tie near the collapse margin: k exact steps instead
+    // (validation already passed, so norm2 is finite).
+    double norm2 = 0.0;
+    AccumulateNorm2(delta_input, norm2);
+    for (uint64_t i = 0; i < k; ++i) {
+        const EventFlag step_ev = CommitNorm2(norm2, dt);
+        if (step_ev != EventFlag::NORMAL) return step_ev;
     }
+    return EventFlag::NORMAL;
 }
 
-    // 6) Energy update (canonical)
-    double phi_next = current_.phi + (params_.alpha * norm2) - (params_.eta * current_.phi * dt);
-    if (!is_finite(phi_next)) return EventFlag::ERROR;
-    if (phi_next < 0.0) phi_next = 0.0;
-
-    // 7) Memory update (canonical, uses Phi_next)
-    double memory_next =
-        current_.memory
-        + (params_.beta * phi_next * dt)
-        - (params_.gamma * current_.memory * dt);
-    if (!is_finite(memory_next)) return EventFlag::ERROR;
-    if (memory_next < 0.0) memory_next = 0.0;
-
-    // 8) Stability update (canonical)
-    double kappa_next =
-        current_.kappa
-        + (params_.rho * (params_.kappa_max - current_.kappa) * dt)
-        - (params_.lambda_phi * phi_next * dt)
-        - (params_.lambda_m * memory_next * dt);
-    if (!is_finite(kappa_next)) return EventFlag::ERROR;
-
-    // 9) Invariants MUST be enforced before commit (clamps)
-    kappa_next = clamp_range(kappa_next, 0.0, params_.kappa_max);
-
-    next.phi = phi_next;
-    next.memory = memory_next;
-    next.kappa = kappa_next;
-
-    if (!is_finite(next.phi) || !is_finite(next.memory) || !is_finite(next.kappa)) {
-        return EventFlag::ERROR;
-    }
+EventFlag MaxCore::AdvanceChained(
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    uint64_t k,
+    bool& jumped,
+    bool& tie
+) {
+    tie = false;
+    if (k == 0) return EventFlag::NORMAL;
 
-    // 10) Collapse detection MUST occur before commit
-    const bool collapse_now = (current_.kappa > 0.0) && is_zero(next.kappa);
+    // 1) Terminal short-circuit MUST execute before validation
+    if (is_zero(current_.kappa)) {
+        return EventFlag::NORMAL;
+    }
 
-    // 11) AtomicCommit (the only mutation boundary)
-    previous_ = current_;
-    current_ = next;
+    // 2-3) Validation runs once for the whole segment
+    if (delta_input == nullptr) return EventFlag::ERROR;
+    if (delta_len != delta_dim_) return EventFlag::ERROR;
+    if (!detail::admit_dt(params_, dt)) return EventFlag::ERROR;
 
-    lifecycle_.step_counter += 1u;
-    lifecycle_.terminal = is_zero(current_.kappa);
-    if (collapse_now) {
-        lifecycle_.collapse_emitted = true;
-    }
+    // 5) Constant input: norm2 is computed once
+    double norm2 = 0.0;
+    if (!AccumulateNorm2(delta_input, norm2)) return EventFlag::ERROR;
 
-    // 12) Return EventFlag
-    return collapse_now ? EventFlag::COLLAPSE : EventFlag::NORMAL;
+    return detail::affine_advance(params_, delta_max_, norm2, dt, current_, previous_, lifecycle_, k, jumped, tie);
 }
 
 } // namespace maxcore
@@ -0,0 +1,119 @@
+// ==============================
+// File: src/maxcore/predict.cpp
+// ==============================
+#include "maxcore/predict.h"
+
+#include <algorithm>
+
+namespace maxcore {
+
+namespace detail {
+
+struct PredictAccess {
+    static EventFlag AdvanceChained(
+        MaxCore& c,
+        const double* delta,
+        size_t delta_len,
+        double dt,
+        uint64_t k,
+        bool& jumped,
+        bool& tie
+    ) {
+        return c.AdvanceChained(delta, delta_len, dt, k, jumped, tie);
+    }
+};
+
+} // namespace detail
+
+namespace {
+
+// Plain Step() loop over the segments from `probe`: the exact answer.
+std::optional<uint64_t> step_segments(
+    MaxCore probe,
+    const DeltaSegment* segments,
+    size_t count,
+    size_t delta_len,
+    double dt,
+    uint64_t horizon
+) {
+    uint64_t index = 0;
+    for (size_t i = 0; i < count && index < horizon; ++i) {
+        const uint64_t n = std::min(segments[i].steps, horizon - index);
+        for (uint64_t j = 0; j < n; ++j, ++index) {
+            const EventFlag ev = probe.Step(segments[i].delta, delta_len, dt);
+            if (ev == EventFlag::COLLAPSE) return index;
+            if (ev == EventFlag::ERROR) return std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+// The closed form only brackets the collapse: segments are fast-forwarded with the
+// jump state chained across them, so exact steps taken from a jumped state in any
+// segment are checked for rounding-level ties. On a tie the whole query is re-run
+// from `core` with plain steps.
+std::optional<uint64_t> advance_segments(
+    const MaxCore& core,
+    const DeltaSegment* segments,
+    size_t count,
+    size_t delta_len,
+    double dt,
+    uint64_t horizon
+) {
+    MaxCore probe = core;
+    const uint64_t origin = probe.Lifecycle().step_counter;
+    bool jumped = false;
+
+    uint64_t remaining = horizon;
+    for (size_t i = 0; i < count && remaining > 0; ++i) {
+        const uint64_t n = std::min(segments[i].steps, remaining);
+        if (n == 0) continue;
+
+        bool tie = false;
+        const EventFlag ev =
+            detail::PredictAccess::AdvanceChained(probe, segments[i].delta, delta_len, dt, n, jumped, tie);
+        if (tie) return step_segments(core, segments, count, delta_len, dt, horizon);
+        if (ev == EventFlag::COLLAPSE) return probe.Lifecycle().step_counter - origin - 1u;
+        if (ev == EventFlag::ERROR) return std::nullopt;
+        remaining -= n;
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+std::optional<uint64_t> PredictCollapse(
+    const MaxCore& core,
+    const DeltaSource& source,
+    double dt,
+    uint64_t horizon
+) {
+    if (core.Lifecycle().terminal || horizon == 0) return std::nullopt;
+
+    switch (source.GetKind()) {
+        case DeltaSource::Kind::CONSTANT: {
+            const DeltaSegment whole{source.Rows(), horizon};
+            return advance_segments(core, &whole, 1, source.DeltaLen(), dt, horizon);
+        }
+
+        case DeltaSource::Kind::PIECEWISE:
+            if (source.Segments() == nullptr && source.SegmentCount() > 0) return std::nullopt;
+            return advance_segments(core, source.Segments(), source.SegmentCount(), source.DeltaLen(), dt, horizon);
+
+        case DeltaSource::Kind::STREAM: {
+            if (source.DeltaLen() != core.DeltaDim()) return std::nullopt;
+
+            MaxCore probe = core;
+            const uint64_t limit = std::min<uint64_t>(horizon, source.Steps());
+            const SequenceResult r = probe.StepSequence(
+                source.Rows(), static_cast<size_t>(limit), source.Stride(), dt);
+            if (r.event == EventFlag::COLLAPSE) return static_cast<uint64_t>(r.event_index);
+            return std::nullopt;
+        }
+
+        default:
+            return std::nullopt;
+    }
+}
+
+} // namespace maxcore
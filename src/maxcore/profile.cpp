@@ -0,0 +1,63 @@
+// ==============================
+// File: src/maxcore/profile.cpp
+// ==============================
+#include "maxcore/profile.h"
+
+#include <new>
+#include <utility>
+
+#include "kernel.h"
+
+namespace maxcore {
+
+std::optional<ParameterProfile> ParameterProfile::Create(
+    const ParameterSet& params,
+    size_t delta_dim,
+    std::optional<double> delta_max,
+    ReductionMode reduction
+) {
+    if (delta_dim == 0) return std::nullopt;
+    if (!detail::validate_params(params)) return std::nullopt;
+    if (!detail::validate_delta_max(delta_max)) return std::nullopt;
+    if (reduction != ReductionMode::SERIAL && reduction != ReductionMode::LANES4) return std::nullopt;
+
+    detail::ProfileData* data = new (std::nothrow)
+        detail::ProfileData{params, delta_dim, delta_max, reduction, detail::max_rate(params), {1u}};
+    if (data == nullptr) return std::nullopt;
+
+    return ParameterProfile(data);
+}
+
+ParameterProfile::ParameterProfile(const ParameterProfile& other) noexcept : data_(other.data_) {
+    data_->refs.fetch_add(1u, std::memory_order_relaxed);
+}
+
+// A moved-from profile keeps a reference, so data_ is never null.
+ParameterProfile::ParameterProfile(ParameterProfile&& other) noexcept : data_(other.data_) {
+    data_->refs.fetch_add(1u, std::memory_order_relaxed);
+}
+
+ParameterProfile& ParameterProfile::operator=(const ParameterProfile& other) noexcept {
+    if (data_ != other.data_) {
+        other.data_->refs.fetch_add(1u, std::memory_order_relaxed);
+        Release();
+        data_ = other.data_;
+    }
+    return *this;
+}
+
+ParameterProfile& ParameterProfile::operator=(ParameterProfile&& other) noexcept {
+    std::swap(data_, other.data_);
+    return *this;
+}
+
+ParameterProfile::~ParameterProfile() {
+    Release();
+}
+
+void ParameterProfile::Release() noexcept {
+    // Release/acquire pairing makes every use of the block happen before its deletion.
+    if (data_->refs.fetch_sub(1u, std::memory_order_acq_rel) == 1u) delete data_;
+}
+
+} // namespace maxcore
@@ -0,0 +1,79 @@
+// ==============================
+// File: src/maxcore/profiled_core.cpp
+// ==============================
+#include "maxcore/profiled_core.h"
+
+#include "kernel.h"
+
+namespace maxcore {
+
+using detail::is_zero;
+
+template <bool KeepPrevious>
+BasicProfiledCore<KeepPrevious>::BasicProfiledCore(
+    const ParameterProfile& profile,
+    const StructuralState& initial_state
+) noexcept
+    : profile_(profile),
+      current_(initial_state),
+      lifecycle_(is_zero(initial_state.kappa) ? kTerminalBit : 0u) {
+    if constexpr (KeepPrevious) this->previous_ = initial_state;
+}
+
+template <bool KeepPrevious>
+std::optional<BasicProfiledCore<KeepPrevious>> BasicProfiledCore<KeepPrevious>::Create(
+    const ParameterProfile& profile,
+    const StructuralState& initial_state
+) {
+    if (!detail::validate_initial_state(initial_state, profile.Params().kappa_max)) return std::nullopt;
+    return BasicProfiledCore(profile, initial_state);
+}
+
+template <bool KeepPrevious>
+bool BasicProfiledCore<KeepPrevious>::Genesis(const StructuralState& initial_state) noexcept {
+    if (!detail::validate_initial_state(initial_state, profile_.Params().kappa_max)) return false;
+
+    current_ = initial_state;
+    if constexpr (KeepPrevious) this->previous_ = initial_state;
+    lifecycle_ = is_zero(initial_state.kappa) ? kTerminalBit : 0u;
+    return true;
+}
+
+template <bool KeepPrevious>
+EventFlag BasicProfiledCore<KeepPrevious>::Step(
+    const double* delta_input,
+    size_t delta_len,
+    double dt
+) noexcept {
+    StepStatus status = StepStatus::OK;
+    return Step(delta_input, delta_len, dt, status);
+}
+
+template <bool KeepPrevious>
+EventFlag BasicProfiledCore<KeepPrevious>::Step(
+    const double* delta_input,
+    size_t delta_len,
+    double dt,
+    StepStatus& status
+) noexcept {
+    // The packed lifecycle word and the optional previous state are unpacked
+    // around the canonical step.
+    const detail::StepConfig<double> cfg{
+        profile_.Params(), profile_.MaxRate(), profile_.DeltaDim(), profile_.DeltaMax(), profile_.Reduction()
+    };
+    LifecycleContext lifecycle = Lifecycle();
+    StructuralState previous = current_;
+    const EventFlag ev = detail::canonical_step(cfg, delta_input, delta_len, dt, current_, previous, lifecycle, status);
+    if (status != StepStatus::OK) return ev;
+
+    if constexpr (KeepPrevious) this->previous_ = previous;
+    lifecycle_ = (lifecycle.step_counter << kCounterShift) | (lifecycle.terminal ? kTerminalBit : 0u) |
+                 (lifecycle.collapse_emitted ? kCollapseBit : 0u);
+    return ev;
+}
+
+// Both variants are compiled inside the library (strict FP flags apply).
+template class BasicProfiledCore<true>;
+template class BasicProfiledCore<false>;
+
+} // namespace maxcore
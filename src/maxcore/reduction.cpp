@@ -0,0 +1,159 @@
+// ==============================
+// File: src/maxcore/reduction.cpp
+// ==============================
+#include "maxcore/reduction.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define MAXCORE_REDUCTION_X86 1
+  #include <immintrin.h>
+  #if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+  #endif
+#endif
+
+#if defined(MAXCORE_REDUCTION_X86) && (defined(__GNUC__) || defined(__clang__))
+  #define MAXCORE_TARGET_AVX2 __attribute__((target("avx2")))
+  #define MAXCORE_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+  #define MAXCORE_TARGET_AVX2
+  #define MAXCORE_TARGET_SSE2
+#endif
+
+namespace maxcore {
+
+// Combine order shared by every kernel: (s0 + s1) + (s2 + s3)
+static inline double combine_lanes(const double s[4]) noexcept {
+    const double lo = s[0] + s[1];
+    const double hi = s[2] + s[3];
+    return lo + hi;
+}
+
+// Tail elements keep their lane (i mod 4) and are accumulated after the block loop,
+// which is the same per-lane order as the reference.
+static inline void accumulate_tail(const double* v, size_t begin, size_t n, double s[4]) noexcept {
+    for (size_t i = begin; i < n; ++i) {
+        const double term = v[i] * v[i];
+        s[i & 3u] += term;
+    }
+}
+
+double Norm2Lanes4Reference(const double* v, size_t n) noexcept {
+    double s[4] = {0.0, 0.0, 0.0, 0.0};
+    accumulate_tail(v, 0, n, s);
+    return combine_lanes(s);
+}
+
+#if defined(MAXCORE_REDUCTION_X86)
+
+MAXCORE_TARGET_SSE2
+static double norm2_lanes4_sse2(const double* v, size_t n) noexcept {
+    // Lanes 0-1 in acc01, lanes 2-3 in acc23 (no FMA: multiply then add)
+    __m128d acc01 = _mm_setzero_pd();
+    __m128d acc23 = _mm_setzero_pd();
+
+    const size_t blocks = n & ~static_cast<size_t>(3u);
+    for (size_t i = 0; i < blocks; i += 4) {
+        const __m128d x01 = _mm_loadu_pd(v + i);
+        const __m128d x23 = _mm_loadu_pd(v + i + 2);
+        acc01 = _mm_add_pd(acc01, _mm_mul_pd(x01, x01));
+        acc23 = _mm_add_pd(acc23, _mm_mul_pd(x23, x23));
+    }
+
+    double s[4];
+    _mm_storeu_pd(s, acc01);
+    _mm_storeu_pd(s + 2, acc23);
+    accumulate_tail(v, blocks, n, s);
+    return combine_lanes(s);
+}
+
+MAXCORE_TARGET_AVX2
+static double norm2_lanes4_avx2(const double* v, size_t n) noexcept {
+    // Lanes 0-3 in one register (no FMA: multiply then add)
+    __m256d acc = _mm256_setzero_pd();
+
+    const size_t blocks = n & ~static_cast<size_t>(3u);
+    for (size_t i = 0; i < blocks; i += 4) {
+        const __m256d x = _mm256_loadu_pd(v + i);
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(x, x));
+    }
+
+    double s[4];
+    _mm256_storeu_pd(s, acc);
+    accumulate_tail(v, blocks, n, s);
+    return combine_lanes(s);
+}
+
+static bool cpu_has_avx2() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#elif defined(_MSC_VER)
+    int regs[4] = {0, 0, 0, 0};
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    if ((_xgetbv(0) & 0x6u) != 0x6u) return false;
+
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif // MAXCORE_REDUCTION_X86
+
+bool ReductionIsaSupported(ReductionIsa isa) noexcept {
+    switch (isa) {
+        case ReductionIsa::SCALAR:
+            return true;
+#if defined(MAXCORE_REDUCTION_X86)
+        case ReductionIsa::SSE2:
+  #if defined(__x86_64__) || defined(_M_X64)
+            return true;
+  #elif defined(__GNUC__) || defined(__clang__)
+            return __builtin_cpu_supports("sse2") != 0;
+  #else
+            return false;
+  #endif
+        case ReductionIsa::AVX2: {
+            static const bool has_avx2 = cpu_has_avx2();
+            return has_avx2;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+ReductionIsa BestReductionIsa() noexcept {
+    static const ReductionIsa best =
+        ReductionIsaSupported(ReductionIsa::AVX2) ? ReductionIsa::AVX2 :
+        ReductionIsaSupported(ReductionIsa::SSE2) ? ReductionIsa::SSE2 :
+        ReductionIsa::SCALAR;
+    return best;
+}
+
+double Norm2Lanes4(const double* v, size_t n, ReductionIsa isa) noexcept {
+#if defined(MAXCORE_REDUCTION_X86)
+    if (isa == ReductionIsa::AVX2 && ReductionIsaSupported(ReductionIsa::AVX2)) {
+        return norm2_lanes4_avx2(v, n);
+    }
+    if (isa == ReductionIsa::SSE2 && ReductionIsaSupported(ReductionIsa::SSE2)) {
+        return norm2_lanes4_sse2(v, n);
+    }
+#else
+    (void)isa;
+#endif
+    return Norm2Lanes4Reference(v, n);
+}
+
+double Norm2Lanes4(const double* v, size_t n) noexcept {
+    return Norm2Lanes4(v, n, BestReductionIsa());
+}
+
+} // namespace maxcore
@@ -0,0 +1,77 @@
+// ==============================
+// File: src/maxcore/scalar_core.cpp
+// ==============================
+#include "maxcore/scalar_core.h"
+
+#include "kernel.h"
+
+namespace maxcore {
+
+using detail::is_zero;
+
+template <typename Scalar>
+MaxCoreT<Scalar>::MaxCoreT(
+    const Parameters& params,
+    size_t delta_dim,
+    const State& initial_state,
+    std::optional<Scalar> delta_max
+) noexcept
+    : params_(params),
+      delta_dim_(delta_dim),
+      delta_max_(delta_max),
+      current_(initial_state),
+      previous_(initial_state),
+      lifecycle_{0u, is_zero(initial_state.kappa), false} {}
+
+template <typename Scalar>
+std::optional<MaxCoreT<Scalar>> MaxCoreT<Scalar>::Create(
+    const Parameters& params,
+    size_t delta_dim,
+    const State& initial_state,
+    std::optional<Scalar> delta_max
+) {
+    if (delta_dim == 0) return std::nullopt;
+    if (!detail::validate_params(params)) return std::nullopt;
+    if (!detail::validate_initial_state(initial_state, params.kappa_max)) return std::nullopt;
+    if (!detail::validate_delta_max(delta_max)) return std::nullopt;
+
+    return MaxCoreT(params, delta_dim, initial_state, delta_max);
+}
+
+template <typename Scalar>
+bool MaxCoreT<Scalar>::Genesis(const State& initial_state) noexcept {
+    if (!detail::validate_initial_state(initial_state, params_.kappa_max)) return false;
+
+    current_ = initial_state;
+    previous_ = initial_state;
+    lifecycle_ = LifecycleContext{0u, is_zero(initial_state.kappa), false};
+    return true;
+}
+
+template <typename Scalar>
+EventFlag MaxCoreT<Scalar>::Step(
+    const Scalar* delta_input,
+    size_t delta_len,
+    Scalar dt
+) noexcept {
+    StepStatus status = StepStatus::OK;
+    return Step(delta_input, delta_len, dt, status);
+}
+
+template <typename Scalar>
+EventFlag MaxCoreT<Scalar>::Step(
+    const Scalar* delta_input,
+    size_t delta_len,
+    Scalar dt,
+    StepStatus& status
+) noexcept {
+    // MaxCoreT runs the canonical serial reduction order.
+    const detail::StepConfig<Scalar> cfg{params_, detail::max_rate(params_), delta_dim_, delta_max_, ReductionMode::SERIAL};
+    return detail::canonical_step(cfg, delta_input, delta_len, dt, current_, previous_, lifecycle_, status);
+}
+
+// Both precisions are compiled inside the library (strict FP flags apply).
+template class MaxCoreT<double>;
+template class MaxCoreT<float>;
+
+} // namespace maxcore
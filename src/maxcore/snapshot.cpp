@@ -0,0 +1,449 @@
+// ==============================
+// File: src/maxcore/snapshot.cpp
+// ==============================
+#include "maxcore/snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "kernel.h"
+
+namespace maxcore {
+namespace detail {
+
+namespace {
+
+constexpr char kMagic[8] = {'M', 'A', 'X', 'C', 'S', 'N', 'A', 'P'};
+constexpr uint64_t kEndianTag = 0x0102030405060708ull;
+
+constexpr uint64_t kFlagTerminal = 1u;
+constexpr uint64_t kFlagCollapse = 2u;
+
+// Header word indices
+enum : size_t {
+    H_MAGIC = 0,
+    H_ENDIAN = 1,
+    H_VERSION = 2,
+    H_KIND = 3,
+    H_COUNT = 4,
+    H_PAYLOAD = 5,
+    H_CHECKSUM = 6,
+    H_CONFIGS = 7
+};
+
+// Configuration entry word indices (after the 8 parameter doubles).
+enum : size_t {
+    C_DELTA_DIM = 8,
+    C_HAS_DELTA_MAX = 9,
+    C_DELTA_MAX = 10,
+    C_REDUCTION = 11
+};
+
+// A CORES record reuses any of this many most recent configuration entries
+// (bounded, allocation-free deduplication).
+constexpr size_t kConfigScan = 64;
+
+constexpr size_t kConfigBytes = kSnapshotConfigWords * 8u;
+constexpr size_t kCoreBytes = kSnapshotCoreWords * 8u;
+
+// Unaligned 8-byte accessors: snapshot buffers carry no alignment guarantee.
+inline uint64_t load_u64(const uint8_t* p) noexcept {
+    uint64_t v = 0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline double load_f64(const uint8_t* p) noexcept {
+    double v = 0.0;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void store_u64(uint8_t* p, uint64_t v) noexcept {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+inline void store_f64(uint8_t* p, double v) noexcept {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+// Word-wise FNV-1a with a final avalanche; detects truncation and corruption,
+// not tampering.
+uint64_t checksum(const uint8_t* p, size_t bytes) noexcept {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t off = 0; off < bytes; off += 8u) {
+        h ^= load_u64(p + off);
+        h *= 0x100000001b3ull;
+    }
+    h ^= static_cast<uint64_t>(bytes);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+bool mul_overflows(size_t a, size_t b) noexcept {
+    return b != 0 && a > std::numeric_limits<size_t>::max() / b;
+}
+
+// Payload bytes of `configs` configuration entries followed by the body (0 on overflow).
+size_t payload_bytes(size_t configs, size_t count, size_t record_bytes) noexcept {
+    if (mul_overflows(configs, kConfigBytes) || mul_overflows(count, record_bytes)) return 0;
+    const size_t table = configs * kConfigBytes;
+    const size_t body = count * record_bytes;
+    if (table > std::numeric_limits<size_t>::max() - body) return 0;
+    return table + body;
+}
+
+void write_header(uint8_t* out, SnapshotKind kind, size_t count, size_t configs, size_t payload) noexcept {
+    std::memcpy(out + H_MAGIC * 8u, kMagic, sizeof(kMagic));
+    store_u64(out + H_ENDIAN * 8u, kEndianTag);
+    store_u64(out + H_VERSION * 8u, kSnapshotVersion);
+    store_u64(out + H_KIND * 8u, static_cast<uint64_t>(kind));
+    store_u64(out + H_COUNT * 8u, static_cast<uint64_t>(count));
+    store_u64(out + H_PAYLOAD * 8u, static_cast<uint64_t>(payload));
+    store_u64(out + H_CHECKSUM * 8u, checksum(out + kSnapshotHeaderBytes, payload));
+    store_u64(out + H_CONFIGS * 8u, static_cast<uint64_t>(configs));
+}
+
+// The structural validation pass of a restore: header fields, exact size, checksum.
+// Returns the configuration table (the body follows it) and the record and
+// configuration counts, or nullptr.
+const uint8_t* open_snapshot(
+    const void* data,
+    size_t len,
+    SnapshotKind kind,
+    size_t& count,
+    size_t& configs
+) noexcept {
+    if (data == nullptr || len < kSnapshotHeaderBytes) return nullptr;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+
+    if (std::memcmp(p + H_MAGIC * 8u, kMagic, sizeof(kMagic)) != 0) return nullptr;
+    if (load_u64(p + H_ENDIAN * 8u) != kEndianTag) return nullptr;  // foreign byte order
+    if (load_u64(p + H_VERSION * 8u) != kSnapshotVersion) return nullptr;
+    if (load_u64(p + H_KIND * 8u) != static_cast<uint64_t>(kind)) return nullptr;
+
+    const uint64_t n = load_u64(p + H_COUNT * 8u);
+    if (n == 0 || n > std::numeric_limits<size_t>::max()) return nullptr;
+    count = static_cast<size_t>(n);
+
+    // CORES: 1..count entries; BATCH: exactly one (the shared configuration).
+    const uint64_t c = load_u64(p + H_CONFIGS * 8u);
+    if (c == 0 || c > n || (kind == SnapshotKind::BATCH && c != 1u)) return nullptr;
+    configs = static_cast<size_t>(c);
+
+    const size_t record = (kind == SnapshotKind::CORES) ? kCoreBytes : kSnapshotBatchColumns * 8u;
+    const size_t payload = payload_bytes(configs, count, record);
+    if (payload == 0) return nullptr;
+    if (load_u64(p + H_PAYLOAD * 8u) != static_cast<uint64_t>(payload)) return nullptr;
+    if (len != kSnapshotHeaderBytes + payload) return nullptr;
+
+    const uint8_t* table = p + kSnapshotHeaderBytes;
+    if (load_u64(p + H_CHECKSUM * 8u) != checksum(table, payload)) return nullptr;
+    return table;
+}
+
+void write_config(
+    uint8_t* w,
+    const ParameterSet& p,
+    size_t delta_dim,
+    const std::optional<double>& delta_max,
+    ReductionMode reduction
+) noexcept {
+    store_f64(w + 0u * 8u, p.alpha);
+    store_f64(w + 1u * 8u, p.eta);
+    store_f64(w + 2u * 8u, p.beta);
+    store_f64(w + 3u * 8u, p.gamma);
+    store_f64(w + 4u * 8u, p.rho);
+    store_f64(w + 5u * 8u, p.lambda_phi);
+    store_f64(w + 6u * 8u, p.lambda_m);
+    store_f64(w + 7u * 8u, p.kappa_max);
+    store_u64(w + C_DELTA_DIM * 8u, static_cast<uint64_t>(delta_dim));
+    store_u64(w + C_HAS_DELTA_MAX * 8u, delta_max.has_value() ? 1u : 0u);
+    store_f64(w + C_DELTA_MAX * 8u, delta_max.value_or(0.0));
+    store_u64(w + C_REDUCTION * 8u, static_cast<uint64_t>(reduction));
+}
+
+// One validated configuration entry.
+struct Config {
+    ParameterSet params;
+    size_t delta_dim;
+    std::optional<double> delta_max;
+    ReductionMode reduction;
+};
+
+// Semantic checks of a configuration entry, the same ones Create() applies: the
+// checksum only proves the bytes are intact, not that they describe a valid engine.
+bool read_config(const uint8_t* r, Config& out) noexcept {
+    out.params = ParameterSet{
+        load_f64(r + 0u * 8u), load_f64(r + 1u * 8u), load_f64(r + 2u * 8u), load_f64(r + 3u * 8u),
+        load_f64(r + 4u * 8u), load_f64(r + 5u * 8u), load_f64(r + 6u * 8u), load_f64(r + 7u * 8u)
+    };
+    if (!validate_params(out.params)) return false;
+
+    const uint64_t dim = load_u64(r + C_DELTA_DIM * 8u);
+    if (dim == 0u || dim > std::numeric_limits<size_t>::max()) return false;
+    out.delta_dim = static_cast<size_t>(dim);
+
+    const uint64_t has_delta_max = load_u64(r + C_HAS_DELTA_MAX * 8u);
+    if (has_delta_max > 1u) return false;
+    out.delta_max = std::nullopt;
+    if (has_delta_max != 0u) out.delta_max = load_f64(r + C_DELTA_MAX * 8u);
+    if (!validate_delta_max(out.delta_max)) return false;
+
+    const uint64_t reduction = load_u64(r + C_REDUCTION * 8u);
+    if (reduction > static_cast<uint64_t>(ReductionMode::LANES4)) return false;
+    out.reduction = static_cast<ReductionMode>(reduction);
+    return true;
+}
+
+// Per-entity checks: both states as Create() checks a genesis state, the terminal
+// flag equal to Kappa == 0, and a collapse only on a terminal entity.
+bool valid_entity(
+    const StructuralState& current,
+    const StructuralState& previous,
+    uint64_t flags,
+    double kappa_max
+) noexcept {
+    if (!validate_initial_state(current, kappa_max) || !validate_initial_state(previous, kappa_max)) return false;
+    if (flags > (kFlagTerminal | kFlagCollapse)) return false;
+
+    const bool terminal = (flags & kFlagTerminal) != 0u;
+    if (terminal != is_zero(current.kappa)) return false;
+    return terminal || (flags & kFlagCollapse) == 0u;
+}
+
+} // namespace
+
+struct SnapshotAccess {
+    // Writes cores [0, count) (core_at(i) yields the i-th) into `out`, which MUST
+    // hold SnapshotSize(count) bytes. Returns the snapshot's exact size.
+    template <class CoreAt>
+    static size_t WriteCores(uint8_t* out, size_t count, CoreAt&& core_at) noexcept {
+        uint8_t* table = out + kSnapshotHeaderBytes;
+
+        // Records are staged past the largest possible table and moved down once
+        // the number of distinct configurations is known.
+        uint8_t* staged = table + count * kConfigBytes;
+        size_t configs = 0;
+
+        uint8_t entry[kConfigBytes];
+        for (size_t i = 0; i < count; ++i) {
+            const MaxCore& c = core_at(i);
+            write_config(entry, c.params_, c.delta_dim_, c.delta_max_, c.reduction_);
+
+            size_t index = configs;
+            const size_t scan = std::min(configs, kConfigScan);
+            for (size_t k = 1; k <= scan; ++k) {
+                if (std::memcmp(table + (configs - k) * kConfigBytes, entry, kConfigBytes) == 0) {
+                    index = configs - k;
+                    break;
+                }
+            }
+            if (index == configs) {
+                std::memcpy(table + configs * kConfigBytes, entry, kConfigBytes);
+                configs += 1u;
+            }
+
+            uint8_t* w = staged + i * kCoreBytes;
+            store_u64(w + 0u * 8u, static_cast<uint64_t>(index));
+            store_f64(w + 1u * 8u, c.current_.phi);
+            store_f64(w + 2u * 8u, c.current_.memory);
+            store_f64(w + 3u * 8u, c.current_.kappa);
+            store_f64(w + 4u * 8u, c.previous_.phi);
+            store_f64(w + 5u * 8u, c.previous_.memory);
+            store_f64(w + 6u * 8u, c.previous_.kappa);
+            store_u64(w + 7u * 8u, c.lifecycle_.step_counter);
+            store_u64(w + 8u * 8u, (c.lifecycle_.terminal ? kFlagTerminal : 0u) |
+                                   (c.lifecycle_.collapse_emitted ? kFlagCollapse : 0u));
+        }
+
+        std::memmove(table + configs * kConfigBytes, staged, count * kCoreBytes);
+
+        // Header last: the checksum covers the table and the records written above.
+        const size_t payload = configs * kConfigBytes + count * kCoreBytes;
+        write_header(out, SnapshotKind::CORES, count, configs, payload);
+        return kSnapshotHeaderBytes + payload;
+    }
+
+    // Returns std::nullopt if the record's state does not describe a valid core.
+    static std::optional<MaxCore> ReadCore(const uint8_t* r, const Config& cfg) noexcept {
+        const StructuralState current{load_f64(r + 1u * 8u), load_f64(r + 2u * 8u), load_f64(r + 3u * 8u)};
+        const StructuralState previous{load_f64(r + 4u * 8u), load_f64(r + 5u * 8u), load_f64(r + 6u * 8u)};
+        const uint64_t flags = load_u64(r + 8u * 8u);
+        if (!valid_entity(current, previous, flags, cfg.params.kappa_max)) return std::nullopt;
+
+        MaxCore c(cfg.params, cfg.delta_dim, current, cfg.delta_max, cfg.reduction);
+        c.previous_ = previous;
+        c.lifecycle_ = LifecycleContext{
+            load_u64(r + 7u * 8u), (flags & kFlagTerminal) != 0u, (flags & kFlagCollapse) != 0u
+        };
+        return c;
+    }
+
+    static void WriteBatch(uint8_t* w, const MaxCoreBatch& b) noexcept {
+        const size_t lanes = b.Lanes();
+        write_config(w, b.params_, b.delta_dim_, b.delta_max_, ReductionMode::SERIAL);
+
+        uint8_t* col = w + kConfigBytes;
+        const size_t col_bytes = lanes * 8u;
+
+        for (const std::vector<double>* v :
+             {&b.phi_, &b.memory_, &b.kappa_, &b.prev_phi_, &b.prev_memory_, &b.prev_kappa_}) {
+            std::memcpy(col, v->data(), col_bytes);
+            col += col_bytes;
+        }
+        std::memcpy(col, b.step_counter_.data(), col_bytes);
+        col += col_bytes;
+
+        for (const std::vector<uint8_t>* v : {&b.terminal_, &b.collapse_emitted_}) {
+            for (size_t i = 0; i < lanes; ++i) {
+                store_u64(col + i * 8u, (*v)[i]);
+            }
+            col += col_bytes;
+        }
+    }
+
+    // Returns std::nullopt if the shared configuration or any lane is invalid.
+    static std::optional<MaxCoreBatch> ReadBatch(const uint8_t* r, size_t lanes) {
+        Config cfg{};
+        if (!read_config(r, cfg) || cfg.reduction != ReductionMode::SERIAL) return std::nullopt;
+
+        MaxCoreBatch b(cfg.params, cfg.delta_dim, lanes, cfg.delta_max);
+
+        const uint8_t* col = r + kConfigBytes;
+        const size_t col_bytes = lanes * 8u;
+
+        for (std::vector<double>* v :
+             {&b.phi_, &b.memory_, &b.kappa_, &b.prev_phi_, &b.prev_memory_, &b.prev_kappa_}) {
+            std::memcpy(v->data(), col, col_bytes);
+            col += col_bytes;
+        }
+        std::memcpy(b.step_counter_.data(), col, col_bytes);
+        col += col_bytes;
+
+        const uint8_t* terminal = col;
+        const uint8_t* collapse = col + col_bytes;
+        for (size_t i = 0; i < lanes; ++i) {
+            const uint64_t t = load_u64(terminal + i * 8u);
+            const uint64_t c = load_u64(collapse + i * 8u);
+            if (t > 1u || c > 1u) return std::nullopt;
+
+            const StructuralState current{b.phi_[i], b.memory_[i], b.kappa_[i]};
+            const StructuralState previous{b.prev_phi_[i], b.prev_memory_[i], b.prev_kappa_[i]};
+            const uint64_t flags = (t != 0u ? kFlagTerminal : 0u) | (c != 0u ? kFlagCollapse : 0u);
+            if (!valid_entity(current, previous, flags, cfg.params.kappa_max)) return std::nullopt;
+
+            b.terminal_[i] = static_cast<uint8_t>(t);
+            b.collapse_emitted_[i] = static_cast<uint8_t>(c);
+        }
+        b.RebuildLive();
+        return b;
+    }
+};
+
+} // namespace detail
+
+size_t SnapshotSize(size_t count) noexcept {
+    if (count == 0) return 0;
+    const size_t payload = detail::payload_bytes(count, count, detail::kCoreBytes);
+    if (payload == 0 || payload > std::numeric_limits<size_t>::max() - kSnapshotHeaderBytes) return 0;
+    return kSnapshotHeaderBytes + payload;
+}
+
+size_t BatchSnapshotSize(size_t lanes) noexcept {
+    if (lanes == 0) return 0;
+    const size_t payload = detail::payload_bytes(1, lanes, kSnapshotBatchColumns * 8u);
+    if (payload == 0 || payload > std::numeric_limits<size_t>::max() - kSnapshotHeaderBytes) return 0;
+    return kSnapshotHeaderBytes + payload;
+}
+
+size_t WriteSnapshot(const MaxCore* cores, size_t count, void* out, size_t out_len) noexcept {
+    if (cores == nullptr || out == nullptr || count == 0) return 0;
+    const size_t bound = SnapshotSize(count);
+    if (bound == 0 || out_len < bound) return 0;
+
+    return detail::SnapshotAccess::WriteCores(static_cast<uint8_t*>(out), count,
+                                              [cores](size_t i) -> const MaxCore& { return cores[i]; });
+}
+
+std::vector<uint8_t> Snapshot(const MaxCore& core) {
+    return SnapshotBulk(&core, 1);
+}
+
+std::vector<uint8_t> SnapshotBulk(const MaxCore* cores, size_t count) {
+    std::vector<uint8_t> out(SnapshotSize(count));
+    out.resize(WriteSnapshot(cores, count, out.data(), out.size()));
+    return out;
+}
+
+std::vector<uint8_t> SnapshotEnsemble(const EnsembleRunner& runner) {
+    const size_t count = runner.Size();
+    std::vector<uint8_t> out(SnapshotSize(count));
+    if (out.empty()) return out;
+
+    out.resize(detail::SnapshotAccess::WriteCores(out.data(), count,
+                                                  [&runner](size_t i) -> const MaxCore& { return runner.Core(i); }));
+    return out;
+}
+
+std::vector<uint8_t> SnapshotBatch(const MaxCoreBatch& batch) {
+    std::vector<uint8_t> out(BatchSnapshotSize(batch.Lanes()));
+    if (out.empty()) return out;
+
+    detail::SnapshotAccess::WriteBatch(out.data() + kSnapshotHeaderBytes, batch);
+    detail::write_header(out.data(), SnapshotKind::BATCH, batch.Lanes(), 1u, out.size() - kSnapshotHeaderBytes);
+    return out;
+}
+
+std::optional<std::vector<MaxCore>> RestoreBulk(const void* data, size_t len) {
+    size_t count = 0;
+    size_t configs = 0;
+    const uint8_t* table = detail::open_snapshot(data, len, SnapshotKind::CORES, count, configs);
+    if (table == nullptr) return std::nullopt;
+
+    // Each configuration entry is validated once, whatever the number of records using it.
+    std::vector<detail::Config> cfg(configs);
+    for (size_t k = 0; k < configs; ++k) {
+        if (!detail::read_config(table + k * detail::kConfigBytes, cfg[k])) return std::nullopt;
+    }
+
+    const uint8_t* body = table + configs * detail::kConfigBytes;
+    std::vector<MaxCore> cores;
+    cores.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* r = body + i * detail::kCoreBytes;
+        const uint64_t index = detail::load_u64(r);
+        if (index >= configs) return std::nullopt;
+
+        std::optional<MaxCore> c = detail::SnapshotAccess::ReadCore(r, cfg[static_cast<size_t>(index)]);
+        if (!c) return std::nullopt;
+        cores.push_back(std::move(*c));
+    }
+    return cores;
+}
+
+std::optional<MaxCore> Restore(const void* data, size_t len) {
+    std::optional<std::vector<MaxCore>> cores = RestoreBulk(data, len);
+    if (!cores || cores->size() != 1u) return std::nullopt;
+    return std::move(cores->front());
+}
+
+std::optional<EnsembleRunner> RestoreEnsemble(const void* data, size_t len, size_t workers) {
+    std::optional<std::vector<MaxCore>> cores = RestoreBulk(data, len);
+    if (!cores) return std::nullopt;
+    return EnsembleRunner::Create(std::move(*cores), workers);
+}
+
+std::optional<MaxCoreBatch> RestoreBatch(const void* data, size_t len) {
+    size_t lanes = 0;
+    size_t configs = 0;
+    const uint8_t* table = detail::open_snapshot(data, len, SnapshotKind::BATCH, lanes, configs);
+    if (table == nullptr) return std::nullopt;
+    return detail::SnapshotAccess::ReadBatch(table, lanes);
+}
+
+} // namespace maxcore
@@ -0,0 +1,247 @@
+// ==============================
+// File: src/maxcore/sweep.cpp
+// ==============================
+#include "maxcore/sweep.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "kernel.h"
+#include "thread_pool.h"
+
+namespace maxcore {
+
+using detail::is_zero;
+
+namespace {
+
+// Grid points advanced together by one task (one SoA block per task).
+constexpr size_t kSweepLanes = 64;
+
+// Per-row norm2 after the norm guard, computed once and shared by every point.
+// delta_max is shared, so a row is either valid for every point or for none.
+struct RowTable {
+    std::vector<double> norm2;
+    std::vector<uint8_t> ok;
+};
+
+RowTable build_rows(
+    const double* deltas,
+    size_t steps,
+    size_t stride,
+    size_t delta_dim,
+    const std::optional<double>& delta_max
+) {
+    RowTable rows;
+    rows.norm2.assign(steps, 0.0);
+    rows.ok.assign(steps, 0u);
+
+    for (size_t i = 0; i < steps; ++i) {
+        double norm2 = 0.0;
+        if (detail::accumulate_norm2(deltas + i * stride, delta_dim, norm2) &&
+            detail::apply_norm_guard(delta_max, norm2)) {
+            rows.norm2[i] = norm2;
+            rows.ok[i] = 1u;
+        }
+    }
+    return rows;
+}
+
+} // namespace
+
+ParameterSweep::ParameterSweep(
+    const ParameterSet& base,
+    std::vector<SweepAxis> axes,
+    size_t points,
+    size_t delta_dim,
+    const StructuralState& initial_state,
+    std::optional<double> delta_max
+)
+    : base_(base),
+      axes_(std::move(axes)),
+      points_(points),
+      delta_dim_(delta_dim),
+      init_(initial_state),
+      delta_max_(delta_max),
+      strides_(axes_.size(), 1u) {
+    // Row-major: the last axis varies fastest.
+    for (size_t k = axes_.size(); k-- > 1;) {
+        strides_[k - 1] = strides_[k] * axes_[k].values.size();
+    }
+}
+
+std::optional<ParameterSweep> ParameterSweep::Create(
+    const ParameterSet& base,
+    std::vector<SweepAxis> axes,
+    size_t delta_dim,
+    const StructuralState& initial_state,
+    std::optional<double> delta_max
+) {
+    if (delta_dim == 0 || axes.empty()) return std::nullopt;
+    if (!detail::validate_params(base)) return std::nullopt;
+    if (!detail::validate_initial_state(initial_state, base.kappa_max)) return std::nullopt;
+    if (!detail::validate_delta_max(delta_max)) return std::nullopt;
+
+    // Parameter checks are per field, so checking every value of every axis
+    // against the base covers every combination on the grid.
+    size_t points = 1;
+    for (const SweepAxis& axis : axes) {
+        if (axis.field == nullptr || axis.values.empty()) return std::nullopt;
+        if (points > std::numeric_limits<size_t>::max() / axis.values.size()) return std::nullopt;
+        points *= axis.values.size();
+
+        for (double v : axis.values) {
+            ParameterSet p = base;
+            p.*(axis.field) = v;
+            if (!detail::validate_params(p)) return std::nullopt;
+            if (!detail::validate_initial_state(initial_state, p.kappa_max)) return std::nullopt;
+        }
+    }
+
+    return ParameterSweep(base, std::move(axes), points, delta_dim, initial_state, delta_max);
+}
+
+std::vector<size_t> ParameterSweep::Shape() const {
+    std::vector<size_t> shape;
+    shape.reserve(axes_.size());
+    for (const SweepAxis& axis : axes_) {
+        shape.push_back(axis.values.size());
+    }
+    return shape;
+}
+
+ParameterSet ParameterSweep::PointParams(size_t index) const noexcept {
+    ParameterSet p = base_;
+    // Axes sharing a field: the later one wins.
+    for (size_t k = 0; k < axes_.size(); ++k) {
+        const size_t c = (index / strides_[k]) % axes_[k].values.size();
+        p.*(axes_[k].field) = axes_[k].values[c];
+    }
+    return p;
+}
+
+std::optional<SweepResult> ParameterSweep::Run(
+    const double* deltas,
+    size_t steps,
+    size_t stride,
+    double dt,
+    size_t threads
+) const {
+    if (steps > 0 && deltas == nullptr) return std::nullopt;
+    if (stride < delta_dim_) return std::nullopt;
+
+    const RowTable rows = build_rows(deltas, steps, stride, delta_dim_, delta_max_);
+    const std::optional<double> no_guard;
+
+    SweepResult out;
+    out.shape = Shape();
+    out.collapse_step.assign(points_, -1);
+    out.stop_event.assign(points_, EventFlag::NORMAL);
+    out.final_phi.assign(points_, 0.0);
+    out.final_memory.assign(points_, 0.0);
+    out.final_kappa.assign(points_, 0.0);
+    out.min_kappa.assign(points_, 0.0);
+
+    auto run_block = [&](size_t task, size_t /*worker*/) {
+        const size_t first = task * kSweepLanes;
+        const size_t count = std::min(kSweepLanes, points_ - first);
+
+        ParameterSet params[kSweepLanes];
+        double phi[kSweepLanes];
+        double memory[kSweepLanes];
+        double kappa[kSweepLanes];
+        double kmin[kSweepLanes];
+        int64_t cstep[kSweepLanes];
+        EventFlag event[kSweepLanes];
+        uint8_t live[kSweepLanes];
+
+        size_t n_live = 0;
+        for (size_t j = 0; j < count; ++j) {
+            params[j] = PointParams(first + j);
+            phi[j] = init_.phi;
+            memory[j] = init_.memory;
+            kappa[j] = init_.kappa;
+            kmin[j] = init_.kappa;
+            cstep[j] = -1;
+            event[j] = EventFlag::NORMAL;
+            live[j] = 0u;
+
+            // 1) Terminal short-circuit before validation; 2-3) per-point stability bound
+            if (is_zero(init_.kappa)) continue;
+            if (!detail::admit_dt(params[j], dt)) {
+                event[j] = EventFlag::ERROR;
+                continue;
+            }
+            live[j] = 1u;
+            n_live += 1u;
+        }
+
+        for (size_t i = 0; i < steps && n_live > 0; ++i) {
+            // 5) Invalid row: every live point stops with ERROR, uncommitted
+            if (rows.ok[i] == 0u) {
+                for (size_t j = 0; j < count; ++j) {
+                    if (live[j] != 0u) event[j] = EventFlag::ERROR;
+                }
+                break;
+            }
+
+            const double norm2 = rows.norm2[i];
+            for (size_t j = 0; j < count; ++j) {
+                if (live[j] == 0u) continue;
+
+                // 4-12) The MaxCore commit path. The row's norm2 is already guarded,
+                // so no delta_max is passed (the guard would be the identity).
+                StructuralState cur{phi[j], memory[j], kappa[j]};
+                StructuralState prev = cur;
+                LifecycleContext lc{};
+                StepStatus status = StepStatus::OK;
+                double load_phi = 0.0;
+                double load_m = 0.0;
+                const EventFlag ev = detail::commit_norm2(params[j], no_guard, norm2, dt, cur, prev, lc, status,
+                                                          load_phi, load_m);
+                if (ev == EventFlag::ERROR) {
+                    event[j] = EventFlag::ERROR;
+                    live[j] = 0u;
+                    n_live -= 1u;
+                    continue;
+                }
+
+                phi[j] = cur.phi;
+                memory[j] = cur.memory;
+                kappa[j] = cur.kappa;
+                kmin[j] = std::min(kmin[j], cur.kappa);
+
+                if (ev == EventFlag::COLLAPSE) {
+                    event[j] = EventFlag::COLLAPSE;
+                    cstep[j] = static_cast<int64_t>(i);
+                    live[j] = 0u;
+                    n_live -= 1u;
+                }
+            }
+        }
+
+        for (size_t j = 0; j < count; ++j) {
+            const size_t k = first + j;
+            out.collapse_step[k] = cstep[j];
+            out.stop_event[k] = event[j];
+            out.final_phi[k] = phi[j];
+            out.final_memory[k] = memory[j];
+            out.final_kappa[k] = kappa[j];
+            out.min_kappa[k] = kmin[j];
+        }
+    };
+
+    const size_t tasks = (points_ + kSweepLanes - 1u) / kSweepLanes;
+    const size_t workers = std::min(detail::resolve_workers(threads), tasks);
+    if (workers <= 1u) {
+        for (size_t t = 0; t < tasks; ++t) run_block(t, 0);
+        return out;
+    }
+
+    detail::WorkStealingPool pool(workers);
+    pool.Run(tasks, run_block);
+    return out;
+}
+
+} // namespace maxcore
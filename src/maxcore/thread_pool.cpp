@@ -0,0 +1,137 @@
+// ==============================
+// File: src/maxcore/thread_pool.cpp
+// ==============================
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace maxcore {
+namespace detail {
+
+size_t resolve_workers(size_t requested) noexcept {
+    if (requested > 0) return requested;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? static_cast<size_t>(hw) : 1u;
+}
+
+WorkStealingPool::WorkStealingPool(size_t workers) {
+    const size_t n = std::max<size_t>(workers, 1u);
+    ranges_.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        ranges_.push_back(std::make_unique<Range>());
+    }
+
+    threads_.reserve(n - 1u);
+    for (size_t i = 1; i < n; ++i) {
+        threads_.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : threads_) {
+        t.join();
+    }
+}
+
+void WorkStealingPool::Run(size_t count, const Task& task) {
+    if (count == 0) return;
+
+    // Initial partition: contiguous, near-equal ranges
+    const size_t n = ranges_.size();
+    for (size_t w = 0; w < n; ++w) {
+        Range& r = *ranges_[w];
+        std::lock_guard<std::mutex> lock(r.m);
+        r.begin = (count * w) / n;
+        r.end = (count * (w + 1u)) / n;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        task_ = &task;
+        pending_ = threads_.size();
+        generation_ += 1u;
+    }
+    wake_.notify_all();
+
+    Drain(0);
+
+    std::unique_lock<std::mutex> lock(m_);
+    done_.wait(lock, [this]() { return pending_ == 0; });
+    task_ = nullptr;
+}
+
+void WorkStealingPool::WorkerLoop(size_t worker) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_);
+            wake_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+
+        Drain(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            pending_ -= 1u;
+            if (pending_ == 0) done_.notify_all();
+        }
+    }
+}
+
+void WorkStealingPool::Drain(size_t worker) {
+    for (;;) {
+        size_t index = 0;
+        if (PopOwn(worker, index)) {
+            (*task_)(index, worker);
+            continue;
+        }
+        if (!Steal(worker)) return;
+    }
+}
+
+bool WorkStealingPool::PopOwn(size_t worker, size_t& index) {
+    Range& r = *ranges_[worker];
+    std::lock_guard<std::mutex> lock(r.m);
+    if (r.begin >= r.end) return false;
+    index = r.begin;
+    r.begin += 1u;
+    return true;
+}
+
+bool WorkStealingPool::Steal(size_t worker) {
+    // No task is ever added after Run() starts, so one full scan finding every
+    // range empty means this worker is done.
+    const size_t n = ranges_.size();
+    for (size_t k = 1; k < n; ++k) {
+        Range& victim = *ranges_[(worker + k) % n];
+
+        size_t lo = 0;
+        size_t hi = 0;
+        {
+            std::lock_guard<std::mutex> lock(victim.m);
+            if (victim.begin >= victim.end) continue;
+            // Take the upper half (the whole range if only one index is left)
+            const size_t mid = victim.begin + (victim.end - victim.begin) / 2u;
+            lo = mid;
+            hi = victim.end;
+            victim.end = mid;
+        }
+
+        Range& own = *ranges_[worker];
+        std::lock_guard<std::mutex> lock(own.m);
+        own.begin = lo;
+        own.end = hi;
+        return true;
+    }
+    return false;
+}
+
+} // namespace detail
+} // namespace maxcore
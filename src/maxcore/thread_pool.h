@@ -0,0 +1,73 @@
+// ==============================
+// File: src/maxcore/thread_pool.h
+// ==============================
+#ifndef MAXCORE_THREAD_POOL_H
+#define MAXCORE_THREAD_POOL_H
+
+// Private work-stealing pool shared by the multi-core front-ends.
+// Results never depend on which worker ran a task: callers write each task's
+// output to a slot owned by that task index.
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace maxcore {
+namespace detail {
+
+class WorkStealingPool final {
+public:
+    // Task signature: (task_index, worker_index).
+    using Task = std::function<void(size_t, size_t)>;
+
+    // workers >= 1; the calling thread acts as worker 0, workers - 1 threads are spawned.
+    explicit WorkStealingPool(size_t workers);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t Workers() const noexcept { return ranges_.size(); }
+
+    // Runs task(i, worker) for every i in [0, count) and blocks until all are done.
+    // Indices start as one contiguous range per worker; a worker whose range is
+    // drained steals the upper half of another worker's remaining range.
+    // Task MUST NOT throw and MUST NOT call Run() on the same pool.
+    void Run(size_t count, const Task& task);
+
+private:
+    struct alignas(64) Range {
+        std::mutex m;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    void WorkerLoop(size_t worker);
+    void Drain(size_t worker);
+    bool PopOwn(size_t worker, size_t& index);
+    bool Steal(size_t worker);
+
+    std::vector<std::unique_ptr<Range>> ranges_;
+    std::vector<std::thread> threads_;
+
+    std::mutex m_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    uint64_t generation_ = 0;
+    size_t pending_ = 0;
+    bool stop_ = false;
+    const Task* task_ = nullptr;
+};
+
+// Resolves a requested worker count (0 = hardware concurrency, at least 1).
+size_t resolve_workers(size_t requested) noexcept;
+
+} // namespace detail
+} // namespace maxcore
+
+#endif // MAXCORE_THREAD_POOL_H
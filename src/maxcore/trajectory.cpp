@@ -0,0 +1,58 @@
+// ==============================
+// File: src/maxcore/trajectory.cpp
+// ==============================
+#include "maxcore/trajectory.h"
+
+namespace maxcore {
+
+TrajectoryRecorder::TrajectoryRecorder(size_t capacity, RecorderMode mode)
+    : capacity_(capacity),
+      mode_(mode),
+      phi_(capacity),
+      memory_(capacity),
+      kappa_(capacity),
+      event_(capacity, EventFlag::NORMAL),
+      step_counter_(capacity, 0u) {}
+
+std::optional<TrajectoryRecorder> TrajectoryRecorder::Create(size_t capacity, RecorderMode mode) {
+    if (capacity == 0) return std::nullopt;
+    if (mode != RecorderMode::LINEAR && mode != RecorderMode::RING) return std::nullopt;
+    return TrajectoryRecorder(capacity, mode);
+}
+
+bool TrajectoryRecorder::Record(const MaxCore& core, EventFlag event) noexcept {
+    total_ += 1u;
+
+    if (size_ == capacity_ && mode_ == RecorderMode::LINEAR) {
+        dropped_ += 1u;
+        return false;
+    }
+
+    const size_t i = next_;
+    const StructuralState& s = core.Current();
+    phi_[i] = s.phi;
+    memory_[i] = s.memory;
+    kappa_[i] = s.kappa;
+    event_[i] = event;
+    step_counter_[i] = core.Lifecycle().step_counter;
+
+    // Wrap without a division; a full LINEAR recorder never gets here.
+    next_ = (i + 1u == capacity_) ? 0u : i + 1u;
+    if (size_ < capacity_) size_ += 1u;
+    return true;
+}
+
+EventFlag TrajectoryRecorder::Step(MaxCore& core, const double* delta_input, size_t delta_len, double dt) {
+    const EventFlag ev = core.Step(delta_input, delta_len, dt);
+    Record(core, ev);
+    return ev;
+}
+
+void TrajectoryRecorder::Clear() noexcept {
+    next_ = 0;
+    size_ = 0;
+    total_ = 0;
+    dropped_ = 0;
+}
+
+} // namespace maxcore
@@ -0,0 +1,386 @@
+// ==============================
+// File: src/maxcore/trajectory_file.cpp
+// ==============================
+#include "maxcore/trajectory_file.h"
+
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#if defined(_WIN32)
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "kernel.h"
+
+namespace maxcore {
+
+namespace {
+
+constexpr char kMagic[8] = {'M', 'A', 'X', 'C', 'T', 'R', 'A', 'J'};
+constexpr uint64_t kEndianTag = 0x0102030405060708ull;
+constexpr size_t kColumns = static_cast<size_t>(TrajectoryColumn::COUNT);
+
+constexpr uint8_t kFlagTerminal = 1u;
+constexpr uint8_t kFlagCollapse = 2u;
+
+// Header word indices
+enum : size_t {
+    H_MAGIC = 0,
+    H_ENDIAN = 1,
+    H_VERSION = 2,
+    H_PARAMS = 3,  // 8 words
+    H_DT = 11,
+    H_DELTA_DIM = 12,
+    H_COLUMNS = 13,
+    H_CHUNK_ROWS = 14,
+    H_ROWS = 15,
+    H_WORDS = kTrajectoryHeaderBytes / 8u
+};
+
+constexpr size_t column_width(size_t column) noexcept {
+    return (column == static_cast<size_t>(TrajectoryColumn::EVENT) ||
+            column == static_cast<size_t>(TrajectoryColumn::FLAGS)) ? 1u : 8u;
+}
+
+constexpr size_t pad8(size_t bytes) noexcept {
+    return (bytes + 7u) & ~static_cast<size_t>(7u);
+}
+
+// Byte offset of `column` inside a chunk of `n` rows (column == COUNT: chunk size).
+size_t block_offset(size_t n, size_t column) noexcept {
+    size_t off = 0;
+    for (size_t c = 0; c < column; ++c) {
+        off += pad8(n * column_width(c));
+    }
+    return off;
+}
+
+bool chunk_bytes_overflow(size_t n) noexcept {
+    // Widest row: 8 columns of 8 bytes + 2 of 1 byte (+ padding), at most 8 * 9 bytes.
+    return n > std::numeric_limits<size_t>::max() / 128u;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------- Writer
+
+void TrajectoryFileWriter::FileCloser::operator()(std::FILE* f) const noexcept {
+    if (f != nullptr) std::fclose(f);
+}
+
+TrajectoryFileWriter::TrajectoryFileWriter(
+    std::FILE* file,
+    const ParameterSet& params,
+    double dt,
+    size_t delta_dim,
+    size_t chunk_rows
+)
+    : file_(file),
+      params_(params),
+      dt_(dt),
+      delta_dim_(delta_dim),
+      chunk_rows_(chunk_rows),
+      lifecycle_(chunk_rows),
+      step_counter_(chunk_rows),
+      event_(chunk_rows),
+      flags_(chunk_rows) {
+    for (std::vector<double>& col : state_) {
+        col.resize(chunk_rows);
+    }
+}
+
+TrajectoryFileWriter& TrajectoryFileWriter::operator=(TrajectoryFileWriter&& other) noexcept {
+    if (this == &other) return *this;
+    Close();
+
+    file_ = std::move(other.file_);
+    params_ = other.params_;
+    dt_ = other.dt_;
+    delta_dim_ = other.delta_dim_;
+    chunk_rows_ = other.chunk_rows_;
+    rows_ = other.rows_;
+    pending_ = other.pending_;
+    ok_ = other.ok_;
+
+    lifecycle_ = std::move(other.lifecycle_);
+    step_counter_ = std::move(other.step_counter_);
+    event_ = std::move(other.event_);
+    flags_ = std::move(other.flags_);
+    for (size_t c = 0; c < 6u; ++c) {
+        state_[c] = std::move(other.state_[c]);
+    }
+    return *this;
+}
+
+TrajectoryFileWriter::~TrajectoryFileWriter() {
+    Close();
+}
+
+std::optional<TrajectoryFileWriter> TrajectoryFileWriter::Create(
+    const std::string& path,
+    const ParameterSet& params,
+    double dt,
+    size_t delta_dim,
+    size_t chunk_rows
+) {
+    if (delta_dim == 0 || chunk_rows == 0 || chunk_bytes_overflow(chunk_rows)) return std::nullopt;
+    if (!detail::validate_params(params)) return std::nullopt;
+    if (!detail::admit_dt(params, dt)) return std::nullopt;
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr) return std::nullopt;
+
+    TrajectoryFileWriter w(f, params, dt, delta_dim, chunk_rows);
+    if (!w.WriteHeader()) return std::nullopt;
+    return w;
+}
+
+bool TrajectoryFileWriter::WriteHeader() noexcept {
+    uint64_t words[H_WORDS] = {};
+    std::memcpy(&words[H_MAGIC], kMagic, sizeof(kMagic));
+    words[H_ENDIAN] = kEndianTag;
+    words[H_VERSION] = kTrajectoryVersion;
+
+    const double p[8] = {
+        params_.alpha, params_.eta, params_.beta, params_.gamma,
+        params_.rho, params_.lambda_phi, params_.lambda_m, params_.kappa_max
+    };
+    std::memcpy(&words[H_PARAMS], p, sizeof(p));
+    std::memcpy(&words[H_DT], &dt_, sizeof(dt_));
+    words[H_DELTA_DIM] = static_cast<uint64_t>(delta_dim_);
+    words[H_COLUMNS] = static_cast<uint64_t>(kColumns);
+    words[H_CHUNK_ROWS] = static_cast<uint64_t>(chunk_rows_);
+    words[H_ROWS] = rows_;
+
+    if (std::fseek(file_.get(), 0, SEEK_SET) != 0) return false;
+    return std::fwrite(words, sizeof(words), 1, file_.get()) == 1u;
+}
+
+bool TrajectoryFileWriter::FlushChunk() noexcept {
+    if (pending_ == 0) return true;
+
+    static const uint8_t zeros[8] = {};
+    auto write_block = [&](const void* data, size_t width) {
+        const size_t bytes = pending_ * width;
+        if (std::fwrite(data, 1, bytes, file_.get()) != bytes) return false;
+        const size_t pad = pad8(bytes) - bytes;
+        return pad == 0 || std::fwrite(zeros, 1, pad, file_.get()) == pad;
+    };
+
+    bool ok = write_block(lifecycle_.data(), 8u) &&
+              write_block(step_counter_.data(), 8u) &&
+              write_block(event_.data(), 1u) &&
+              write_block(flags_.data(), 1u);
+    for (const std::vector<double>& col : state_) {
+        ok = ok && write_block(col.data(), 8u);
+    }
+
+    pending_ = 0;
+    return ok;
+}
+
+bool TrajectoryFileWriter::Append(const TrajectoryRow& row) noexcept {
+    if (!ok_ || !file_) return false;
+
+    const size_t i = pending_;
+    lifecycle_[i] = row.lifecycle_id;
+    step_counter_[i] = row.lifecycle.step_counter;
+    event_[i] = static_cast<uint8_t>(row.event);
+    flags_[i] = static_cast<uint8_t>((row.lifecycle.terminal ? kFlagTerminal : 0u) |
+                                     (row.lifecycle.collapse_emitted ? kFlagCollapse : 0u));
+    state_[0][i] = row.current.phi;
+    state_[1][i] = row.current.memory;
+    state_[2][i] = row.current.kappa;
+    state_[3][i] = row.previous.phi;
+    state_[4][i] = row.previous.memory;
+    state_[5][i] = row.previous.kappa;
+
+    pending_ += 1u;
+    rows_ += 1u;
+    if (pending_ == chunk_rows_) {
+        // Publish the completed chunk in the header, then return to the end.
+        ok_ = FlushChunk() && WriteHeader() && std::fseek(file_.get(), 0, SEEK_END) == 0;
+    }
+    return ok_;
+}
+
+bool TrajectoryFileWriter::Append(const MaxCore& core, EventFlag event, uint64_t lifecycle_id) noexcept {
+    return Append(TrajectoryRow{lifecycle_id, event, core.Current(), core.Previous(), core.Lifecycle()});
+}
+
+bool TrajectoryFileWriter::Close() noexcept {
+    if (!file_) return ok_;
+
+    ok_ = ok_ && FlushChunk();
+    // The final header adds the rows of the last, partial chunk. Before this the
+    // header counts the full chunks flushed so far, which is what the file holds.
+    ok_ = ok_ && WriteHeader();
+    ok_ = (std::fclose(file_.release()) == 0) && ok_;
+    return ok_;
+}
+
+// ---------------------------------------------------------------- Reader
+
+TrajectoryFileReader::TrajectoryFileReader(TrajectoryFileReader&& other) noexcept {
+    *this = std::move(other);
+}
+
+TrajectoryFileReader& TrajectoryFileReader::operator=(TrajectoryFileReader&& other) noexcept {
+    if (this == &other) return *this;
+    Unmap();
+
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0u);
+#if defined(_WIN32)
+    file_handle_ = std::exchange(other.file_handle_, nullptr);
+    mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+    params_ = other.params_;
+    dt_ = other.dt_;
+    delta_dim_ = other.delta_dim_;
+    rows_ = other.rows_;
+    chunk_rows_ = other.chunk_rows_;
+    chunks_ = other.chunks_;
+    chunk_bytes_ = other.chunk_bytes_;
+    return *this;
+}
+
+TrajectoryFileReader::~TrajectoryFileReader() {
+    Unmap();
+}
+
+void TrajectoryFileReader::Unmap() noexcept {
+#if defined(_WIN32)
+    if (data_ != nullptr) UnmapViewOfFile(data_);
+    if (mapping_handle_ != nullptr) CloseHandle(static_cast<HANDLE>(mapping_handle_));
+    if (file_handle_ != nullptr) CloseHandle(static_cast<HANDLE>(file_handle_));
+    mapping_handle_ = nullptr;
+    file_handle_ = nullptr;
+#else
+    if (data_ != nullptr) munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+std::optional<TrajectoryFileReader> TrajectoryFileReader::Open(const std::string& path) {
+    TrajectoryFileReader r;
+
+#if defined(_WIN32)
+    HANDLE fh = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fh == INVALID_HANDLE_VALUE) return std::nullopt;
+    r.file_handle_ = fh;
+
+    LARGE_INTEGER fsize;
+    if (!GetFileSizeEx(fh, &fsize) || fsize.QuadPart < static_cast<LONGLONG>(kTrajectoryHeaderBytes)) {
+        return std::nullopt;
+    }
+    HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mh == nullptr) return std::nullopt;
+    r.mapping_handle_ = mh;
+
+    void* view = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) return std::nullopt;
+    r.data_ = static_cast<const uint8_t*>(view);
+    r.size_ = static_cast<size_t>(fsize.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return std::nullopt;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kTrajectoryHeaderBytes)) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    const size_t fsize = static_cast<size_t>(st.st_size);
+    void* view = ::mmap(nullptr, fsize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return std::nullopt;
+    r.data_ = static_cast<const uint8_t*>(view);
+    r.size_ = fsize;
+#endif
+
+    // Single validation pass: header fields and body size.
+    uint64_t words[H_WORDS];
+    std::memcpy(words, r.data_, sizeof(words));
+
+    if (std::memcmp(&words[H_MAGIC], kMagic, sizeof(kMagic)) != 0) return std::nullopt;
+    if (words[H_ENDIAN] != kEndianTag) return std::nullopt;  // foreign byte order
+    if (words[H_VERSION] != kTrajectoryVersion) return std::nullopt;
+    if (words[H_COLUMNS] != static_cast<uint64_t>(kColumns)) return std::nullopt;
+
+    double p[8];
+    std::memcpy(p, &words[H_PARAMS], sizeof(p));
+    r.params_ = ParameterSet{p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]};
+    std::memcpy(&r.dt_, &words[H_DT], sizeof(r.dt_));
+    if (!detail::validate_params(r.params_)) return std::nullopt;
+    if (!detail::admit_dt(r.params_, r.dt_)) return std::nullopt;
+    if (words[H_DELTA_DIM] == 0 || words[H_DELTA_DIM] > std::numeric_limits<size_t>::max()) return std::nullopt;
+
+    const uint64_t chunk_rows = words[H_CHUNK_ROWS];
+    const uint64_t rows = words[H_ROWS];
+    if (chunk_rows == 0 || chunk_rows > std::numeric_limits<size_t>::max()) return std::nullopt;
+    if (chunk_bytes_overflow(static_cast<size_t>(chunk_rows))) return std::nullopt;
+
+    r.delta_dim_ = static_cast<size_t>(words[H_DELTA_DIM]);
+    r.rows_ = rows;
+    r.chunk_rows_ = static_cast<size_t>(chunk_rows);
+    r.chunk_bytes_ = block_offset(r.chunk_rows_, kColumns);
+
+    const uint64_t full = rows / chunk_rows;
+    const size_t tail = static_cast<size_t>(rows % chunk_rows);
+    const size_t body = r.size_ - kTrajectoryHeaderBytes;
+    if (full > body / r.chunk_bytes_) return std::nullopt;
+
+    // Bytes past the published rows are a chunk torn by an interrupted flush.
+    const size_t expected = static_cast<size_t>(full) * r.chunk_bytes_ + block_offset(tail, kColumns);
+    if (body < expected) return std::nullopt;
+
+    r.chunks_ = static_cast<size_t>(full) + (tail > 0 ? 1u : 0u);
+    return std::optional<TrajectoryFileReader>(std::move(r));
+}
+
+size_t TrajectoryFileReader::ChunkSize(size_t chunk) const noexcept {
+    if (chunk + 1u < chunks_) return chunk_rows_;
+    const size_t tail = static_cast<size_t>(rows_ % chunk_rows_);
+    return tail == 0 ? chunk_rows_ : tail;
+}
+
+const uint8_t* TrajectoryFileReader::ColumnBase(TrajectoryColumn column, size_t chunk) const noexcept {
+    return data_ + kTrajectoryHeaderBytes + chunk * chunk_bytes_ +
+           block_offset(ChunkSize(chunk), static_cast<size_t>(column));
+}
+
+TrajectoryRow TrajectoryFileReader::Row(uint64_t row) const noexcept {
+    const size_t chunk = static_cast<size_t>(row / chunk_rows_);
+    const size_t i = static_cast<size_t>(row % chunk_rows_);
+    const uint8_t flags = Flags(chunk)[i];
+
+    return TrajectoryRow{
+        LifecycleIds(chunk)[i],
+        Events(chunk)[i],
+        StructuralState{Phi(chunk)[i], Memory(chunk)[i], Kappa(chunk)[i]},
+        StructuralState{PrevPhi(chunk)[i], PrevMemory(chunk)[i], PrevKappa(chunk)[i]},
+        LifecycleContext{StepCounter(chunk)[i], (flags & kFlagTerminal) != 0u, (flags & kFlagCollapse) != 0u}
+    };
+}
+
+std::optional<DerivedFrame> TrajectoryFileReader::Derived(uint64_t row) const {
+    const TrajectoryRow r = Row(row);
+    return ComputeDerived(r.current, r.previous, r.lifecycle, params_, dt_);
+}
+
+} // namespace maxcore
@@ -0,0 +1,52 @@
+# ==============================
+# File: tests/maxcore_run_roundtrip.cmake
+# ==============================
+# Runs maxcore_run over one --demo-input stream twice, through the mapped-file
+# path and through the streamed (stdin) path; the event and trajectory files
+# must be byte-identical.
+#
+# cmake -DMAXCORE_RUN=<maxcore_run> -DWORK_DIR=<dir> -P maxcore_run_roundtrip.cmake
+
+set(demo "${WORK_DIR}/maxcore_run_demo.bin")
+
+function(run_checked)
+  execute_process(COMMAND ${ARGN} RESULT_VARIABLE rc)
+  if (NOT rc EQUAL 0)
+    message(FATAL_ERROR "failed (${rc}): ${ARGN}")
+  endif()
+endfunction()
+
+run_checked("${MAXCORE_RUN}" --demo-input "${demo}" 1000 64)
+
+# A block size that does not divide the tick count exercises the short last block.
+run_checked("${MAXCORE_RUN}" --events "${WORK_DIR}/maxcore_run_file.ev"
+            --trajectory "${WORK_DIR}/maxcore_run_file.mctraj" --block-rows 7 "${demo}")
+
+execute_process(
+  COMMAND "${MAXCORE_RUN}" --events "${WORK_DIR}/maxcore_run_pipe.ev"
+          --trajectory "${WORK_DIR}/maxcore_run_pipe.mctraj" --block-rows 7 -
+  INPUT_FILE "${demo}"
+  RESULT_VARIABLE rc)
+if (NOT rc EQUAL 0)
+  message(FATAL_ERROR "streamed run failed (${rc})")
+endif()
+
+file(SIZE "${WORK_DIR}/maxcore_run_file.ev" events_bytes)
+if (events_bytes LESS_EQUAL 32)
+  message(FATAL_ERROR "demo run wrote no events")
+endif()
+
+foreach (ext ev mctraj)
+  execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E compare_files
+            "${WORK_DIR}/maxcore_run_file.${ext}" "${WORK_DIR}/maxcore_run_pipe.${ext}"
+    RESULT_VARIABLE rc)
+  if (NOT rc EQUAL 0)
+    message(FATAL_ERROR "file and stdin runs differ: *.${ext}")
+  endif()
+endforeach()
+
+file(REMOVE "${demo}"
+     "${WORK_DIR}/maxcore_run_file.ev" "${WORK_DIR}/maxcore_run_file.mctraj"
+     "${WORK_DIR}/maxcore_run_pipe.ev" "${WORK_DIR}/maxcore_run_pipe.mctraj")
+message(STATUS "[OK] maxcore_run file and stdin round trip")
@@ -0,0 +1,233 @@
+// ==============================
+// File: tests/test_active_set.cpp
+// ==============================
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "maxcore/batch.h"
+#include "maxcore/ensemble.h"
+#include "maxcore/maxcore.h"
+#include "maxcore/snapshot.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+static bool same_lifecycle(const maxcore::LifecycleContext& a, const maxcore::LifecycleContext& b) {
+    return a.step_counter == b.step_counter && a.terminal == b.terminal && a.collapse_emitted == b.collapse_emitted;
+}
+
+static bool same_core(const maxcore::MaxCore& a, const maxcore::MaxCore& b) {
+    return same_state(a.Current(), b.Current()) && same_state(a.Previous(), b.Previous()) &&
+           same_lifecycle(a.Lifecycle(), b.Lifecycle());
+}
+
+// Reference for one ensemble entity: serial stepping with an explicit cursor.
+struct RefEntity {
+    maxcore::MaxCore core;
+    const double* rows;
+    size_t steps;
+    size_t cursor;
+    maxcore::EventFlag last;
+};
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_active_set\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const size_t dim = 2;
+    const double dt = 0.01;
+
+    // ---- Batch: live lanes only, compaction on collapse, all-terminal early exit
+    {
+        const size_t lanes = 40;
+        std::vector<StructuralState> inits(lanes);
+        std::vector<MaxCore> ref;
+        for (size_t i = 0; i < lanes; ++i) {
+            // Lane 7 starts terminal; the others collapse at different steps.
+            inits[i] = StructuralState{0.0, 0.0, (i == 7) ? 0.0 : 1.0 + 0.2 * static_cast<double>(i)};
+            ref.push_back(MaxCore::Create(p, dim, inits[i]).value());
+        }
+        auto batch = MaxCoreBatch::Create(p, dim, inits.data(), lanes);
+        expect_true(batch.has_value(), "batch Create must succeed");
+        if (!batch) return 2;
+        expect_true(batch->Live() == lanes - 1u, "a lane created terminal is not live");
+
+        std::vector<double> deltas(lanes * dim);
+        bool ok = true;
+        bool live_ok = true;
+        bool shrinking = true;
+        size_t last_live = batch->Live();
+        size_t t = 0;
+        for (; t < 5000 && batch->Live() > 0; ++t) {
+            for (size_t i = 0; i < lanes; ++i) {
+                deltas[i * dim + 0] = 3.0 + 0.1 * static_cast<double>(i % 5);
+                deltas[i * dim + 1] = ((t + i) % 23 == 0) ? std::numeric_limits<double>::quiet_NaN() : 2.0;
+            }
+            const double step_dt = (t % 37 == 0) ? -1.0 : dt;
+            const std::vector<EventFlag>& ev = batch->StepAll(deltas.data(), step_dt);
+
+            size_t live = 0;
+            for (size_t i = 0; i < lanes; ++i) {
+                const EventFlag e = ref[i].Step(deltas.data() + i * dim, dim, step_dt);
+                ok = ok && e == ev[i] && same_state(ref[i].Current(), batch->Current(i)) &&
+                     same_state(ref[i].Previous(), batch->Previous(i)) &&
+                     same_lifecycle(ref[i].Lifecycle(), batch->Lifecycle(i));
+                live += ref[i].Lifecycle().terminal ? 0u : 1u;
+            }
+            live_ok = live_ok && batch->Live() == live;
+            shrinking = shrinking && batch->Live() <= last_live;
+            last_live = batch->Live();
+        }
+        expect_true(ok, "compacted batch must match scalar MaxCore bitwise");
+        expect_true(live_ok && shrinking, "Live() must count non-terminal lanes after every call");
+        expect_true(batch->Live() == 0u, "every lane must collapse");
+
+        // All terminal: immediate return, every lane NORMAL, deltas never read.
+        const std::vector<EventFlag>& ev = batch->StepAll(nullptr, -1.0);
+        bool all_normal = true;
+        for (size_t i = 0; i < lanes; ++i) all_normal = all_normal && ev[i] == EventFlag::NORMAL;
+        expect_true(all_normal, "all-terminal batch must short-circuit every lane to NORMAL");
+
+        // A restored batch rebuilds its active set.
+        const std::vector<uint8_t> snap = SnapshotBatch(*batch);
+        auto restored = RestoreBatch(snap.data(), snap.size());
+        expect_true(restored.has_value() && restored->Live() == 0u, "restored batch keeps no live lane");
+    }
+
+    // ---- Ensemble: live entities only, coasting terminal entities, live count per tick
+    {
+        const size_t n = 150;
+        const size_t max_steps = 400;
+        std::vector<std::vector<double>> inputs(n);
+        std::vector<MaxCore> cores;
+        std::vector<RefEntity> ref;
+        for (size_t e = 0; e < n; ++e) {
+            const size_t steps = 50 + (e * 37) % 350;
+            inputs[e].resize(steps * dim);
+            for (size_t i = 0; i < steps; ++i) {
+                inputs[e][i * dim + 0] = 2.0 + 0.02 * static_cast<double>(e % 9);
+                inputs[e][i * dim + 1] = (e % 4 == 0) ? 0.5 : 2.5;
+            }
+            if (e % 13 == 3) inputs[e][(steps / 2) * dim] = std::numeric_limits<double>::quiet_NaN();
+            const double kappa0 = (e == 11) ? 0.0 : 1.0 + 0.05 * static_cast<double>(e);
+            cores.push_back(MaxCore::Create(p, dim, StructuralState{0.0, 0.0, kappa0}).value());
+            ref.push_back(RefEntity{cores.back(), inputs[e].data(), steps, 0, EventFlag::NORMAL});
+        }
+
+        for (size_t workers : {1u, 3u}) {
+            auto runner = EnsembleRunner::Create(cores, workers);
+            expect_true(runner.has_value(), "Create must succeed");
+            if (!runner) continue;
+            std::vector<RefEntity> r = ref;
+            for (size_t e = 0; e < n; ++e) {
+                runner->SetInput(e, EntityInput{inputs[e].data(), r[e].steps, dim, dt});
+            }
+            expect_true(runner->Live() == n - 1u, "an entity created terminal is not live");
+
+            bool parity = true;
+            bool stats_ok = true;
+            size_t min_live = n;
+            for (size_t t = 0; t < max_steps + 10; ++t) {
+                // Mostly ticks, with a free-running burst now and then.
+                const bool burst = (t % 50 == 25);
+                const size_t budget = burst ? 7u : 1u;
+                const EnsembleStats s = burst ? runner->RunFree(budget) : runner->Tick();
+
+                size_t rows = 0;
+                size_t collapsed = 0;
+                size_t errors = 0;
+                size_t live = 0;
+                for (size_t e = 0; e < n; ++e) {
+                    RefEntity& x = r[e];
+                    const size_t avail = std::min(budget, x.steps - x.cursor);
+                    for (size_t k = 0; k < avail; ++k) {
+                        const EventFlag ev = x.core.Step(x.rows + x.cursor * dim, dim, dt);
+                        x.cursor += 1u;
+                        x.last = ev;
+                        rows += 1u;
+                        if (ev == EventFlag::COLLAPSE) collapsed += 1u;
+                        if (ev == EventFlag::ERROR) errors += 1u;
+                        if (burst && ev != EventFlag::NORMAL) break;
+                    }
+                    live += x.core.Lifecycle().terminal ? 0u : 1u;
+                    parity = parity && same_core(runner->Core(e), x.core) && runner->Cursor(e) == x.cursor &&
+                             runner->Remaining(e) == x.steps - x.cursor && runner->LastEvent(e) == x.last;
+                }
+                stats_ok = stats_ok && s.rows == rows && s.collapsed == collapsed && s.errors == errors &&
+                           s.live == live && runner->Live() == live;
+                min_live = std::min(min_live, live);
+
+                // Rebinding a coasting entity restarts its cursor.
+                if (t == 300) {
+                    for (size_t e = 0; e < n; ++e) {
+                        if (r[e].core.Lifecycle().terminal && r[e].cursor < r[e].steps) {
+                            expect_true(runner->SetInput(e, EntityInput{inputs[e].data(), 20, dim, dt}),
+                                        "SetInput on a terminal entity");
+                            r[e].steps = 20;
+                            r[e].cursor = 0;
+                            r[e].last = EventFlag::NORMAL;
+                            break;
+                        }
+                    }
+                }
+            }
+            expect_true(parity, "compacted ensemble must match serial stepping (core, cursor, last event)");
+            expect_true(stats_ok, "rows, events and live count must match serial stepping every call");
+            expect_true(min_live < n / 2u, "most entities must collapse");
+
+            // Exhausted buffers: ticks consume nothing.
+            const EnsembleStats idle = runner->RunFree();
+            expect_true(idle.rows == 0u, "exhausted buffers consume nothing");
+        }
+
+        // All terminal: calls return without stepping.
+        {
+            std::vector<MaxCore> dead(5, MaxCore::Create(p, dim, StructuralState{1.0, 1.0, 0.0}).value());
+            auto runner = EnsembleRunner::Create(dead, 2).value();
+            const double row[2] = {1.0, 1.0};
+            for (size_t e = 0; e < 5; ++e) runner.SetInput(e, EntityInput{row, 1, dim, dt});
+            const EnsembleStats s = runner.Tick();
+            expect_true(runner.Live() == 0u && s.live == 0u && s.rows == 5u && s.collapsed == 0u,
+                        "all-terminal tick consumes rows without stepping");
+            bool done = true;
+            for (size_t e = 0; e < 5; ++e) {
+                done = done && runner.Remaining(e) == 0u && runner.LastEvent(e) == EventFlag::NORMAL &&
+                       runner.Core(e).Lifecycle().step_counter == 0u;
+            }
+            expect_true(done, "terminal entities short-circuit their rows");
+        }
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_active_set\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_active_set: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,235 @@
+// ==============================
+// File: tests/test_advance.cpp
+// ==============================
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+
+#include "maxcore/maxcore.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool almost_equal(double a, double b, double rel_eps = 1e-9, double abs_eps = 1e-12) {
+    const double diff = std::fabs(a - b);
+    if (diff <= abs_eps) return true;
+    const double scale = std::max(std::fabs(a), std::fabs(b));
+    return diff <= rel_eps * scale;
+}
+
+static void expect_near(double a, double b, const char* msg) {
+    if (!almost_equal(a, b)) {
+        std::cout << "[FAIL] " << msg << " (a=" << a << " b=" << b << ")\n";
+        g_fail += 1;
+    }
+}
+
+static maxcore::ParameterSet make_params() {
+    return maxcore::ParameterSet{
+        1e-3,   // alpha
+        0.05,   // eta
+        0.02,   // beta
+        0.01,   // gamma
+        0.002,  // rho
+        0.01,   // lambda_phi
+        0.004,  // lambda_m
+        10.0    // kappa_max
+    };
+}
+
+// Compares Advance(k) against k Step() calls.
+static void check_against_steps(double scale, uint64_t k, const char* label) {
+    using namespace maxcore;
+
+    const ParameterSet p = make_params();
+    const StructuralState init{0.0, 0.0, p.kappa_max};
+    const double dt = 0.1;
+    const double delta[2] = {0.3 * scale, 0.4 * scale};
+
+    MaxCore stepped = MaxCore::Create(p, 2, init).value();
+    MaxCore jumped = stepped;
+
+    EventFlag ev_steps = EventFlag::NORMAL;
+    for (uint64_t i = 0; i < k; ++i) {
+        const EventFlag ev = stepped.Step(delta, 2, dt);
+        if (ev != EventFlag::NORMAL) {
+            ev_steps = ev;
+            break;
+        }
+    }
+
+    const EventFlag ev_adv = jumped.Advance(delta, 2, dt, k);
+
+    std::cout << label << ": event=" << static_cast<int>(ev_adv)
+              << " step_counter=" << jumped.Lifecycle().step_counter << "\n";
+
+    expect_true(ev_adv == ev_steps, "Advance event must match Step loop");
+    expect_true(jumped.Lifecycle().step_counter == stepped.Lifecycle().step_counter,
+                "Advance step_counter must match Step loop exactly");
+    expect_true(jumped.Lifecycle().terminal == stepped.Lifecycle().terminal, "terminal must match");
+    expect_true(jumped.Lifecycle().collapse_emitted == stepped.Lifecycle().collapse_emitted,
+                "collapse_emitted must match");
+
+    expect_near(jumped.Current().phi, stepped.Current().phi, "current.phi must match");
+    expect_near(jumped.Current().memory, stepped.Current().memory, "current.memory must match");
+    expect_near(jumped.Current().kappa, stepped.Current().kappa, "current.kappa must match");
+    expect_near(jumped.Previous().phi, stepped.Previous().phi, "previous.phi must match");
+    expect_near(jumped.Previous().memory, stepped.Previous().memory, "previous.memory must match");
+    expect_near(jumped.Previous().kappa, stepped.Previous().kappa, "previous.kappa must match");
+}
+
+// Event and step_counter of k Step() calls (stepping) or of Advance(k).
+static uint64_t run_counter(double scale, uint64_t k, bool advance, maxcore::EventFlag& ev) {
+    using namespace maxcore;
+
+    const ParameterSet p = make_params();
+    MaxCore core = MaxCore::Create(p, 2, StructuralState{0.0, 0.0, p.kappa_max}).value();
+    const double delta[2] = {0.3 * scale, 0.4 * scale};
+
+    ev = EventFlag::NORMAL;
+    if (advance) {
+        ev = core.Advance(delta, 2, 0.1, k);
+    } else {
+        for (uint64_t i = 0; i < k && ev == EventFlag::NORMAL; ++i) ev = core.Step(delta, 2, 0.1);
+    }
+    return core.Lifecycle().step_counter;
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_advance\n";
+
+    // ---- Collapse-free segments (jumped almost entirely)
+    check_against_steps(1.0, 1, "no-collapse k=1");
+    check_against_steps(1.0, 17, "no-collapse k=17");
+    check_against_steps(2.0, 100000, "no-collapse k=1e5");
+    check_against_steps(4.5, 2000000, "near-critical k=2e6");
+
+    // ---- Collapsing segments: collapse step must be exact
+    check_against_steps(4.9, 2000000, "slow collapse");
+    check_against_steps(6.0, 2000000, "medium collapse");
+    check_against_steps(20.0, 2000000, "fast collapse");
+
+    // ---- Exact event and counter parity over a range of collapsing inputs
+    {
+        bool ok = true;
+        for (int i = 0; i < 40; ++i) {
+            const double scale = 4.72 + 0.11 * static_cast<double>(i);
+            EventFlag ev_s = EventFlag::NORMAL;
+            EventFlag ev_a = EventFlag::NORMAL;
+            const uint64_t c_s = run_counter(scale, 200000, false, ev_s);
+            const uint64_t c_a = run_counter(scale, 200000, true, ev_a);
+            ok = ok && ev_s == ev_a && c_s == c_a;
+        }
+        expect_true(ok, "sweep: Advance event and step_counter must equal the Step loop exactly");
+    }
+
+    // ---- Rounding-level tie: adjacent scales on both sides of a collapse-step boundary
+    {
+        EventFlag ev = EventFlag::NORMAL;
+        double lo = 5.0;
+        double hi = 8.0;
+        const uint64_t c_lo = run_counter(lo, 2000000, false, ev);
+        while (true) {
+            const double mid = lo + (hi - lo) / 2.0;
+            if (!(mid > lo && mid < hi)) break;
+            if (run_counter(mid, 2000000, false, ev) == c_lo) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        const uint64_t at_lo = run_counter(lo, 2000000, false, ev);
+        const uint64_t at_hi = run_counter(hi, 2000000, false, ev);
+        std::cout << "tie: scale=" << lo << " collapse steps " << at_lo << " / " << at_hi << "\n";
+        expect_true(at_lo != at_hi, "tie: bisection must end on a collapse-step boundary");
+
+        for (double scale : {lo, hi}) {
+            EventFlag ev_s = EventFlag::NORMAL;
+            EventFlag ev_a = EventFlag::NORMAL;
+            const uint64_t c_s = run_counter(scale, 2000000, false, ev_s);
+            const uint64_t c_a = run_counter(scale, 2000000, true, ev_a);
+            expect_true(ev_a == EventFlag::COLLAPSE && ev_a == ev_s, "tie: Advance must COLLAPSE like the Step loop");
+            expect_true(c_a == c_s, "tie: collapse step must equal the Step loop exactly");
+        }
+    }
+
+    // ---- Kappa settling within the collapse margin of 0 (no certified jumps near the end)
+    {
+        const ParameterSet p = make_params();
+        MaxCore stepped = MaxCore::Create(p, 1, StructuralState{0.0, 0.0, p.kappa_max}).value();
+        MaxCore jumped = stepped;
+
+        // Steady Kappa = kappa_max - 1.8 * norm2 for these params and dt = 0.1.
+        const double delta[1] = {std::sqrt((p.kappa_max - 1e-7) / 1.8)};
+        EventFlag ev_s = EventFlag::NORMAL;
+        for (int i = 0; i < 300000 && ev_s == EventFlag::NORMAL; ++i) ev_s = stepped.Step(delta, 1, 0.1);
+        const EventFlag ev_a = jumped.Advance(delta, 1, 0.1, 300000);
+
+        std::cout << "small kappa: event=" << static_cast<int>(ev_a) << " kappa=" << jumped.Current().kappa << "\n";
+        expect_true(ev_a == ev_s, "small kappa: event must match");
+        expect_true(jumped.Lifecycle().step_counter == stepped.Lifecycle().step_counter,
+                    "small kappa: step_counter must match exactly");
+        expect_true(ev_s != EventFlag::NORMAL || stepped.Current().kappa < p.kappa_max * 1e-6,
+                    "small kappa: fixture must settle within the collapse margin");
+        expect_near(jumped.Current().kappa, stepped.Current().kappa, "small kappa: kappa must match");
+    }
+
+    // ---- Zero-delta decay from an excited state
+    {
+        const ParameterSet p = make_params();
+        const StructuralState excited{3.0, 2.0, 4.0};
+        MaxCore stepped = MaxCore::Create(p, 2, excited).value();
+        MaxCore jumped = stepped;
+
+        const double zero[2] = {0.0, 0.0};
+        for (int i = 0; i < 50000; ++i) stepped.Step(zero, 2, 0.1);
+        const EventFlag ev = jumped.Advance(zero, 2, 0.1, 50000);
+
+        expect_true(ev == EventFlag::NORMAL, "decay: NORMAL");
+        expect_true(jumped.Lifecycle().step_counter == 50000u, "decay: step_counter");
+        expect_near(jumped.Current().kappa, stepped.Current().kappa, "decay: kappa must match");
+        expect_near(jumped.Current().phi, stepped.Current().phi, "decay: phi must match");
+    }
+
+    // ---- Contract: k == 0, terminal, invalid input
+    {
+        const ParameterSet p = make_params();
+        const StructuralState init{0.0, 0.0, p.kappa_max};
+        MaxCore core = MaxCore::Create(p, 2, init).value();
+        const double delta[2] = {1.0, 1.0};
+
+        expect_true(core.Advance(delta, 2, 0.1, 0) == EventFlag::NORMAL, "k==0: NORMAL");
+        expect_true(core.Advance(nullptr, 2, 0.1, 10) == EventFlag::ERROR, "null delta: ERROR");
+        expect_true(core.Advance(delta, 3, 0.1, 10) == EventFlag::ERROR, "len mismatch: ERROR");
+        expect_true(core.Advance(delta, 2, 0.0, 10) == EventFlag::ERROR, "dt==0: ERROR");
+        expect_true(core.Advance(delta, 2, 1000.0, 10) == EventFlag::ERROR, "unstable dt: ERROR");
+
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const double bad[2] = {nan, 1.0};
+        expect_true(core.Advance(bad, 2, 0.1, 10) == EventFlag::ERROR, "non-finite delta: ERROR");
+        expect_true(core.Lifecycle().step_counter == 0u, "ERROR must not mutate");
+
+        const StructuralState dead{0.0, 0.0, 0.0};
+        MaxCore terminal = MaxCore::Create(p, 2, dead).value();
+        expect_true(terminal.Advance(delta, 2, 0.1, 1000) == EventFlag::NORMAL, "terminal: NORMAL");
+        expect_true(terminal.Lifecycle().step_counter == 0u, "terminal: no mutation");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_advance\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_advance: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,164 @@
+// ==============================
+// File: tests/test_batch_parity.cpp
+// ==============================
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "maxcore/maxcore.h"
+#include "maxcore/batch.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(ua));
+    std::memcpy(&ub, &b, sizeof(ub));
+    return ua == ub;
+}
+
+static void expect_same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b, const char* msg) {
+    if (!same_bits(a.phi, b.phi) || !same_bits(a.memory, b.memory) || !same_bits(a.kappa, b.kappa)) {
+        std::cout << "[FAIL] " << msg
+                  << " (phi " << a.phi << " vs " << b.phi
+                  << ", memory " << a.memory << " vs " << b.memory
+                  << ", kappa " << a.kappa << " vs " << b.kappa << ")\n";
+        g_fail += 1;
+    }
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_batch_parity\n";
+
+    ParameterSet p{
+        1.0,    // alpha
+        0.1,    // eta
+        0.5,    // beta
+        0.1,    // gamma
+        0.05,   // rho
+        0.25,   // lambda_phi
+        0.25,   // lambda_m
+        10.0    // kappa_max
+    };
+
+    const size_t delta_dim = 3;
+    const size_t lanes = 7;
+    const double dt = 0.01;
+
+    // Mixed initial states, including one lane that starts terminal.
+    std::vector<StructuralState> inits;
+    for (size_t i = 0; i < lanes; ++i) {
+        const double f = static_cast<double>(i);
+        inits.push_back(StructuralState{0.5 * f, 0.25 * f, p.kappa_max - 1.3 * f});
+    }
+    inits[5].kappa = 0.0;
+
+    auto batch_opt = MaxCoreBatch::Create(p, delta_dim, inits.data(), lanes, 4.0);
+    expect_true(batch_opt.has_value(), "MaxCoreBatch::Create must succeed");
+    if (!batch_opt) return 1;
+    MaxCoreBatch batch = *batch_opt;
+
+    std::vector<MaxCore> cores;
+    for (size_t i = 0; i < lanes; ++i) {
+        auto c = MaxCore::Create(p, delta_dim, inits[i], 4.0);
+        expect_true(c.has_value(), "MaxCore::Create must succeed");
+        if (!c) return 1;
+        cores.push_back(*c);
+    }
+
+    // ---- Lockstep run: every lane must match its scalar twin bit for bit
+    std::vector<double> deltas(lanes * delta_dim);
+    bool saw_collapse = false;
+
+    for (int t = 0; t < 600; ++t) {
+        for (size_t i = 0; i < lanes; ++i) {
+            const double f = static_cast<double>(i);
+            deltas[i * delta_dim + 0] = 1.0 + 0.01 * f * t;
+            deltas[i * delta_dim + 1] = 2.0 - 0.003 * t;
+            deltas[i * delta_dim + 2] = 0.5 * f;
+        }
+
+        // Lane 3 receives a non-finite input on one tick only.
+        if (t == 17) deltas[3 * delta_dim + 1] = std::numeric_limits<double>::quiet_NaN();
+
+        const std::vector<EventFlag>& ev = batch.StepAll(deltas.data(), dt);
+        expect_true(ev.size() == lanes, "StepAll must return one event per lane");
+
+        for (size_t i = 0; i < lanes; ++i) {
+            const EventFlag ev_scalar = cores[i].Step(deltas.data() + i * delta_dim, delta_dim, dt);
+            expect_true(ev[i] == ev_scalar, "lane event must match scalar Step");
+            if (ev_scalar == EventFlag::COLLAPSE) saw_collapse = true;
+
+            expect_same_state(batch.Current(i), cores[i].Current(), "lane current must match bitwise");
+            expect_same_state(batch.Previous(i), cores[i].Previous(), "lane previous must match bitwise");
+
+            const LifecycleContext a = batch.Lifecycle(i);
+            const LifecycleContext b = cores[i].Lifecycle();
+            expect_true(a.step_counter == b.step_counter, "lane step_counter must match");
+            expect_true(a.terminal == b.terminal, "lane terminal must match");
+            expect_true(a.collapse_emitted == b.collapse_emitted, "lane collapse_emitted must match");
+        }
+
+        if (t == 17) {
+            expect_true(ev[3] == EventFlag::ERROR, "NaN lane must report ERROR");
+            expect_true(ev[0] != EventFlag::ERROR, "NaN in another lane must not affect lane 0");
+        }
+    }
+    expect_true(saw_collapse, "at least one lane must collapse during the run");
+
+    // ---- Shared validation failures apply to every live lane, terminal lanes short-circuit
+    {
+        auto b2_opt = MaxCoreBatch::Create(p, delta_dim, inits.data(), lanes);
+        if (!b2_opt) return 1;
+        MaxCoreBatch b2 = *b2_opt;
+
+        const std::vector<EventFlag>& ev = b2.StepAll(deltas.data(), 0.0);
+        for (size_t i = 0; i < lanes; ++i) {
+            const EventFlag expected = (i == 5) ? EventFlag::NORMAL : EventFlag::ERROR;
+            expect_true(ev[i] == expected, "dt==0: ERROR on live lanes, NORMAL on terminal lanes");
+            expect_true(b2.Lifecycle(i).step_counter == 0u, "dt==0: no lane mutated");
+        }
+
+        const std::vector<EventFlag>& ev_null = b2.StepAll(nullptr, dt);
+        expect_true(ev_null[0] == EventFlag::ERROR, "null deltas must yield ERROR");
+    }
+
+    // ---- Create validation
+    {
+        StructuralState bad = inits[0];
+        bad.kappa = p.kappa_max + 1.0;
+        std::vector<StructuralState> bad_inits = inits;
+        bad_inits[2] = bad;
+
+        expect_true(!MaxCoreBatch::Create(p, delta_dim, bad_inits.data(), lanes).has_value(),
+                    "Create must reject an invalid lane state");
+        expect_true(!MaxCoreBatch::Create(p, 0, inits.data(), lanes).has_value(),
+                    "Create must reject delta_dim == 0");
+        expect_true(!MaxCoreBatch::Create(p, delta_dim, inits.data(), 0).has_value(),
+                    "Create must reject lanes == 0");
+        expect_true(!MaxCoreBatch::Create(p, delta_dim, inits.data(), lanes, -1.0).has_value(),
+                    "Create must reject invalid delta_max");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_batch_parity\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_batch_parity: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,153 @@
+// ==============================
+// File: tests/test_c_api_step_many.cpp
+// ==============================
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "maxcore/c_api.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore_state& a, const maxcore_state& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+int main() {
+    std::cout << "test_c_api_step_many\n";
+
+    const maxcore_params p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const maxcore_state init{0.0, 0.0, 10.0};
+    const size_t dim = 2;
+    const size_t stride = 3;  // padded rows
+    const size_t steps = 120;
+
+    // Rows: constant drive with ERROR rows (NaN delta, bad dt), collapse near step 40,
+    // terminal rows afterwards.
+    std::vector<double> deltas(steps * stride, -1.0);
+    std::vector<double> dts(steps, 0.01);
+    for (size_t i = 0; i < steps; ++i) {
+        deltas[i * stride + 0] = 1.0;
+        deltas[i * stride + 1] = 2.0;
+    }
+    deltas[7 * stride] = std::numeric_limits<double>::quiet_NaN();
+    dts[11] = 0.0;
+    dts[12] = 0.02;
+
+    for (size_t last_error_row : {steps, size_t(20)}) {
+        // last row ERROR or not: the error channel must follow the last row
+        std::vector<double> dts_case = dts;
+        const size_t n = (last_error_row == steps) ? steps : last_error_row + 1u;
+        if (last_error_row != steps) dts_case[last_error_row] = -1.0;
+
+        // Reference: a maxcore_step loop
+        maxcore_handle* ref = maxcore_create(&p, dim, &init, nullptr);
+        maxcore_handle* h = maxcore_create(&p, dim, &init, nullptr);
+        expect_true(ref && h, "maxcore_create must succeed");
+        if (!ref || !h) return 2;
+
+        std::vector<maxcore_event> ref_events(n);
+        std::vector<maxcore_state> ref_states(n);
+        size_t ref_committed = 0;
+        for (size_t i = 0; i < n; ++i) {
+            maxcore_lifecycle before{};
+            maxcore_lifecycle after{};
+            maxcore_get_lifecycle(ref, &before);
+            ref_events[i] = maxcore_step(ref, deltas.data() + i * stride, dim, dts_case[i]);
+            maxcore_get_current(ref, &ref_states[i]);
+            maxcore_get_lifecycle(ref, &after);
+            ref_committed += static_cast<size_t>(after.step_counter - before.step_counter);
+        }
+
+        std::vector<maxcore_event> events(n, MAXCORE_EVENT_ERROR);
+        std::vector<maxcore_state> states(n);
+        const size_t committed =
+            maxcore_step_many(h, deltas.data(), n, stride, dts_case.data(), events.data(), states.data());
+
+        bool events_ok = true;
+        bool states_ok = true;
+        size_t collapses = 0;
+        size_t errors = 0;
+        for (size_t i = 0; i < n; ++i) {
+            events_ok = events_ok && events[i] == ref_events[i];
+            states_ok = states_ok && same_state(states[i], ref_states[i]);
+            collapses += (events[i] == MAXCORE_EVENT_COLLAPSE) ? 1u : 0u;
+            errors += (events[i] == MAXCORE_EVENT_ERROR) ? 1u : 0u;
+        }
+        expect_true(errors >= 2u, "run must contain ERROR rows");
+        expect_true(last_error_row != steps || collapses == 1u, "full run must collapse once");
+        expect_true(events_ok, "events must equal a maxcore_step loop");
+        expect_true(states_ok, "states must equal a maxcore_step loop");
+        expect_true(committed == ref_committed && committed < n, "committed count must equal the loop");
+        expect_true(std::string(maxcore_last_error(h)) == maxcore_last_error(ref),
+                    "last_error must equal the loop's final value");
+
+        maxcore_state cur{};
+        maxcore_state cur_ref{};
+        maxcore_get_current(h, &cur);
+        maxcore_get_current(ref, &cur_ref);
+        expect_true(same_state(cur, cur_ref), "final state must equal the loop");
+
+        maxcore_destroy(ref);
+        maxcore_destroy(h);
+    }
+
+    // ---- states_out is optional; invalid arguments run nothing
+    {
+        maxcore_handle* a = maxcore_create(&p, dim, &init, nullptr);
+        maxcore_handle* b = maxcore_create(&p, dim, &init, nullptr);
+        if (!a || !b) return 2;
+        std::vector<maxcore_event> ea(10);
+        std::vector<maxcore_event> eb(10);
+        const size_t ca = maxcore_step_many(a, deltas.data(), 10, stride, dts.data(), ea.data(), nullptr);
+        std::vector<maxcore_state> sb(10);
+        const size_t cb = maxcore_step_many(b, deltas.data(), 10, stride, dts.data(), eb.data(), sb.data());
+        expect_true(ca == cb && ea == eb, "NULL states_out must not change stepping");
+
+        maxcore_lifecycle lc{};
+        maxcore_get_lifecycle(a, &lc);
+        const uint64_t sc = lc.step_counter;
+        expect_true(maxcore_step_many(a, nullptr, 10, stride, dts.data(), ea.data(), nullptr) == 0u,
+                    "NULL deltas must be rejected");
+        expect_true(maxcore_last_error(a)[0] != '\0', "invalid arguments must set last_error");
+        expect_true(maxcore_step_many(a, deltas.data(), 10, 1, dts.data(), ea.data(), nullptr) == 0u,
+                    "stride < delta_dim must be rejected");
+        expect_true(maxcore_step_many(a, deltas.data(), 10, stride, nullptr, ea.data(), nullptr) == 0u,
+                    "NULL dts must be rejected");
+        expect_true(maxcore_step_many(a, deltas.data(), 10, stride, dts.data(), nullptr, nullptr) == 0u,
+                    "NULL events_out must be rejected");
+        maxcore_get_lifecycle(a, &lc);
+        expect_true(lc.step_counter == sc, "rejected calls must not step");
+        expect_true(maxcore_step_many(nullptr, deltas.data(), 10, stride, dts.data(), ea.data(), nullptr) == 0u,
+                    "NULL handle must return 0");
+
+        maxcore_destroy(a);
+        maxcore_destroy(b);
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_c_api_step_many\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_c_api_step_many: " << g_fail << " failures\n";
+    return 2;
+}
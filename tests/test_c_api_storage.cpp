@@ -0,0 +1,188 @@
+// ==============================
+// File: tests/test_c_api_storage.cpp
+// ==============================
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "maxcore/c_api.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore_state& a, const maxcore_state& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+// dt of entity i at tick t: mostly regular, with a bad dt now and then.
+static double dt_at(size_t i, size_t t) {
+    return ((i + t) % 23 == 0) ? 0.0 : 0.01;
+}
+
+int main() {
+    std::cout << "test_c_api_storage\n";
+
+    const maxcore_params p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const size_t dim = 2;
+    const double delta[2] = {1.0, 2.0};
+
+    const size_t size = maxcore_handle_size();
+    const size_t align = maxcore_handle_align();
+    expect_true(size > 0 && align > 0 && (align & (align - 1)) == 0 && size % align == 0,
+                "handle size / alignment must be consistent");
+
+    // ---- init_in: same behaviour as maxcore_create, memory stays the caller's
+    {
+        std::vector<unsigned char> arena(2 * size + 2 * align);
+        void* raw = arena.data();
+        size_t space = arena.size();
+        void* mem = std::align(align, size, raw, space);
+        expect_true(mem != nullptr, "arena must fit one aligned handle");
+
+        const maxcore_state init{0.0, 0.0, 10.0};
+        maxcore_handle* a = maxcore_init_in(mem, size, &p, dim, &init, nullptr);
+        maxcore_handle* b = maxcore_create(&p, dim, &init, nullptr);
+        expect_true(a == mem && b != nullptr, "init_in must construct in place");
+
+        if (a && b) {
+            bool ok = true;
+            for (size_t t = 0; t < 400; ++t) {
+                const maxcore_event ea = maxcore_step(a, delta, dim, dt_at(0, t));
+                const maxcore_event eb = maxcore_step(b, delta, dim, dt_at(0, t));
+                maxcore_state sa{};
+                maxcore_state sb{};
+                maxcore_get_current(a, &sa);
+                maxcore_get_current(b, &sb);
+                ok = ok && ea == eb && same_state(sa, sb) && maxcore_last_status(a) == maxcore_last_status(b);
+            }
+            expect_true(ok, "in-place handle must step like a created handle");
+        }
+        maxcore_fini_in(a);
+        maxcore_destroy(b);
+
+        expect_true(maxcore_init_in(nullptr, size, &p, dim, &init, nullptr) == nullptr, "NULL memory rejected");
+        expect_true(maxcore_init_in(mem, size - 1, &p, dim, &init, nullptr) == nullptr, "short memory rejected");
+        if (align > 1) {
+            expect_true(maxcore_init_in(static_cast<unsigned char*>(mem) + 1, size, &p, dim, &init, nullptr) == nullptr,
+                        "misaligned memory rejected");
+        }
+        const maxcore_state bad{0.0, 0.0, 11.0};
+        expect_true(maxcore_init_in(mem, size, &p, dim, &bad, nullptr) == nullptr, "invalid state rejected");
+        maxcore_fini_in(nullptr);
+    }
+
+    // ---- Pool: contiguous, aligned, pool_step == per-handle maxcore_step
+    {
+        const size_t n = 97;
+        std::vector<maxcore_state> inits(n);
+        for (size_t i = 0; i < n; ++i) inits[i] = maxcore_state{0.0, 0.0, 2.0 + 8.0 * double(i) / double(n)};
+
+        maxcore_pool* pool = maxcore_pool_create(n, &p, dim, inits.data(), nullptr);
+        expect_true(pool != nullptr && maxcore_pool_size(pool) == n, "pool_create must succeed");
+        if (!pool) return 2;
+
+        bool layout_ok = reinterpret_cast<uintptr_t>(maxcore_pool_handle(pool, 0)) % 64u == 0;
+        for (size_t i = 1; i < n; ++i) {
+            layout_ok = layout_ok && reinterpret_cast<const unsigned char*>(maxcore_pool_handle(pool, i)) -
+                                             reinterpret_cast<const unsigned char*>(maxcore_pool_handle(pool, i - 1)) ==
+                                         static_cast<std::ptrdiff_t>(size);
+        }
+        expect_true(layout_ok, "pool handles must be contiguous in a cache-aligned block");
+        expect_true(maxcore_pool_handle(pool, n) == nullptr, "out-of-range index must return NULL");
+
+        std::vector<maxcore_handle*> ref(n);
+        for (size_t i = 0; i < n; ++i) ref[i] = maxcore_create(&p, dim, &inits[i], nullptr);
+
+        const size_t stride = 3;
+        std::vector<double> rows(n * stride, -1.0);
+        for (size_t i = 0; i < n; ++i) {
+            // odd entities are driven to collapse, even ones idle
+            rows[i * stride + 0] = (i % 2 != 0) ? 1.0 : 0.0;
+            rows[i * stride + 1] = (i % 2 != 0) ? 2.0 : 0.0;
+        }
+        std::vector<double> dts(n);
+        std::vector<maxcore_event> events(n);
+        std::vector<maxcore_state> states(n);
+
+        bool ok = true;
+        size_t collapses = 0;
+        for (size_t t = 0; t < 300; ++t) {
+            for (size_t i = 0; i < n; ++i) dts[i] = dt_at(i, t);
+            const size_t committed = maxcore_pool_step(pool, rows.data(), stride, dts.data(), events.data(), states.data());
+
+            size_t ref_committed = 0;
+            for (size_t i = 0; i < n; ++i) {
+                maxcore_lifecycle before{};
+                maxcore_lifecycle after{};
+                maxcore_get_lifecycle(ref[i], &before);
+                const maxcore_event ev = maxcore_step(ref[i], rows.data() + i * stride, dim, dts[i]);
+                maxcore_get_lifecycle(ref[i], &after);
+                ref_committed += static_cast<size_t>(after.step_counter - before.step_counter);
+
+                maxcore_state s{};
+                maxcore_get_current(ref[i], &s);
+                ok = ok && ev == events[i] && same_state(s, states[i]) &&
+                     maxcore_last_status(ref[i]) == maxcore_last_status(maxcore_pool_handle(pool, i));
+                collapses += (ev == MAXCORE_EVENT_COLLAPSE) ? 1u : 0u;
+            }
+            ok = ok && committed == ref_committed;
+        }
+        expect_true(collapses > 0 && collapses < n, "run must collapse part of the pool");
+        expect_true(ok, "pool_step must equal per-handle maxcore_step");
+
+        // Pool handles work with the per-handle API
+        maxcore_derived_frame f{};
+        int derived_ok = 0;
+        maxcore_handle* h = maxcore_pool_handle(pool, n - 1);
+        maxcore_step_with_derived(h, delta, dim, 0.01, &f, &derived_ok);
+        expect_true(derived_ok == 1, "pool handle must accept per-handle calls");
+
+        // Invalid arguments step nothing
+        maxcore_lifecycle lc{};
+        maxcore_get_lifecycle(h, &lc);
+        const uint64_t sc = lc.step_counter;
+        expect_true(maxcore_pool_step(pool, rows.data(), 1, dts.data(), events.data(), nullptr) == 0u &&
+                    maxcore_pool_step(pool, nullptr, stride, dts.data(), events.data(), nullptr) == 0u,
+                    "invalid pool_step arguments must return 0");
+        maxcore_get_lifecycle(h, &lc);
+        expect_true(lc.step_counter == sc && maxcore_last_status(h) == MAXCORE_STATUS_INVALID_ARGUMENT,
+                    "invalid pool_step must not step and must set the status");
+        expect_true(maxcore_pool_step(nullptr, rows.data(), stride, dts.data(), events.data(), nullptr) == 0u,
+                    "NULL pool must return 0");
+
+        for (maxcore_handle* r : ref) maxcore_destroy(r);
+        maxcore_pool_destroy(pool);
+
+        // Any invalid initial state fails the whole pool
+        inits[n / 2].kappa = std::numeric_limits<double>::quiet_NaN();
+        expect_true(maxcore_pool_create(n, &p, dim, inits.data(), nullptr) == nullptr, "invalid state must fail the pool");
+        expect_true(maxcore_pool_create(0, &p, dim, inits.data(), nullptr) == nullptr, "empty pool rejected");
+        expect_true(maxcore_pool_size(nullptr) == 0u, "NULL pool size");
+        maxcore_pool_destroy(nullptr);
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_c_api_storage\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_c_api_storage: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,156 @@
+// ==============================
+// File: tests/test_derived_batch.cpp
+// ==============================
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "maxcore/derived.h"
+#include "maxcore/maxcore.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+struct Columns {
+    explicit Columns(size_t n) : v(10, std::vector<double>(n)), valid(n, 0xAA) {}
+
+    maxcore::DerivedColumns Out() {
+        return maxcore::DerivedColumns{v[0].data(), v[1].data(), v[2].data(), v[3].data(), v[4].data(),
+                                       v[5].data(), v[6].data(), v[7].data(), v[8].data(), v[9].data()};
+    }
+
+    std::vector<std::vector<double>> v;
+    std::vector<uint8_t> valid;
+};
+
+// Every row must match the scalar ComputeDerived: same validity, same bits.
+static bool matches_scalar(
+    const std::vector<double>& cphi, const std::vector<double>& cmem, const std::vector<double>& ckap,
+    const std::vector<double>& pphi, const std::vector<double>& pmem, const std::vector<double>& pkap,
+    const maxcore::ParameterSet& p, double dt, const Columns& c, size_t count
+) {
+    using namespace maxcore;
+    size_t expected_count = 0;
+    for (size_t i = 0; i < cphi.size(); ++i) {
+        const LifecycleContext lc{i, false, false};
+        const auto d = ComputeDerived(StructuralState{cphi[i], cmem[i], ckap[i]},
+                                      StructuralState{pphi[i], pmem[i], pkap[i]}, lc, p, dt);
+        if (c.valid[i] != (d ? 1u : 0u)) return false;
+        if (!d) continue;
+        expected_count += 1;
+        const double want[10] = {d->d_phi, d->d_memory, d->d_kappa, d->phi_rate, d->memory_rate,
+                                 d->kappa_rate, d->kappa_ratio, d->kappa_distance, d->load_term, d->regen_term};
+        for (size_t k = 0; k < 10; ++k) {
+            if (!same_bits(c.v[k][i], want[k])) return false;
+        }
+    }
+    return expected_count == count;
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_derived_batch\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const double dt = 0.01;
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double big = std::numeric_limits<double>::max();
+
+    // ---- Shifted view over a recorded run (phi/memory/kappa of consecutive states)
+    {
+        MaxCore core = MaxCore::Create(p, 2, StructuralState{0.0, 0.0, p.kappa_max}).value();
+        const double delta[2] = {1.0, 2.0};
+        std::vector<double> phi{core.Current().phi};
+        std::vector<double> mem{core.Current().memory};
+        std::vector<double> kap{core.Current().kappa};
+        for (size_t t = 0; t < 37; ++t) {
+            core.Step(delta, 2, dt);
+            phi.push_back(core.Current().phi);
+            mem.push_back(core.Current().memory);
+            kap.push_back(core.Current().kappa);
+        }
+
+        const size_t rows = phi.size() - 1u;
+        Columns c(rows);
+        const size_t count = ComputeDerivedBatch(StateColumns{phi.data() + 1, mem.data() + 1, kap.data() + 1},
+                                                 StateColumns{phi.data(), mem.data(), kap.data()},
+                                                 rows, p, dt, c.Out(), c.valid.data());
+
+        const std::vector<double> cphi(phi.begin() + 1, phi.end()), cmem(mem.begin() + 1, mem.end()),
+            ckap(kap.begin() + 1, kap.end()), pphi(phi.begin(), phi.end() - 1), pmem(mem.begin(), mem.end() - 1),
+            pkap(kap.begin(), kap.end() - 1);
+        expect_true(count == rows, "a recorded run must be valid on every row");
+        expect_true(matches_scalar(cphi, cmem, ckap, pphi, pmem, pkap, p, dt, c, count),
+                    "shifted view must match ComputeDerived bitwise");
+    }
+
+    // ---- Edge rows: every rejection path of ComputeDerived, one per row
+    {
+        const std::vector<double> cphi{1.0, nan, 1.0, 1.0, 1.0, big, 1.0, 1.0, 1.0, 1.0, 1.0, 3.5};
+        const std::vector<double> cmem{2.0, 2.0, inf, 2.0, 2.0, 2.0, 2.0, 2.0, 2.0, 2.0, big, 1.0};
+        const std::vector<double> ckap{5.0, 5.0, 5.0, -1.0, 20.0, 5.0, -0.0, 0.0, 5.0, -big, 5.0, 9.99};
+        const std::vector<double> pphi{0.5, 0.5, 0.5, 0.5, 0.5, -big, 0.5, 0.5, nan, 0.5, 0.5, 3.4};
+        const std::vector<double> pmem{1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.1};
+        const std::vector<double> pkap{6.0, 6.0, 6.0, 6.0, 6.0, 6.0, 6.0, 6.0, 6.0, 6.0, 6.0, 10.0};
+        const size_t rows = cphi.size();
+
+        Columns c(rows);
+        const size_t count = ComputeDerivedBatch(StateColumns{cphi.data(), cmem.data(), ckap.data()},
+                                                 StateColumns{pphi.data(), pmem.data(), pkap.data()},
+                                                 rows, p, dt, c.Out(), c.valid.data());
+        expect_true(count > 0 && count < rows, "edge rows must mix valid and invalid");
+        expect_true(matches_scalar(cphi, cmem, ckap, pphi, pmem, pkap, p, dt, c, count),
+                    "edge rows must match ComputeDerived validity and bits");
+
+        // Invalid dt / params reject every row
+        Columns bad(rows);
+        expect_true(ComputeDerivedBatch(StateColumns{cphi.data(), cmem.data(), ckap.data()},
+                                        StateColumns{pphi.data(), pmem.data(), pkap.data()},
+                                        rows, p, 0.0, bad.Out(), bad.valid.data()) == 0u,
+                    "dt = 0 must yield no valid rows");
+        bool all_zero = true;
+        for (uint8_t v : bad.valid) all_zero = all_zero && v == 0u;
+        expect_true(all_zero, "dt = 0 must clear the mask");
+
+        ParameterSet q = p;
+        q.kappa_max = -1.0;
+        expect_true(ComputeDerivedBatch(StateColumns{cphi.data(), cmem.data(), ckap.data()},
+                                        StateColumns{pphi.data(), pmem.data(), pkap.data()},
+                                        rows, q, dt, bad.Out(), bad.valid.data()) == 0u,
+                    "kappa_max <= 0 must yield no valid rows");
+    }
+
+    // ---- Empty input
+    {
+        Columns c(0);
+        expect_true(ComputeDerivedBatch(StateColumns{nullptr, nullptr, nullptr}, StateColumns{nullptr, nullptr, nullptr},
+                                        0, p, dt, c.Out(), c.valid.data()) == 0u,
+                    "rows = 0 must be a no-op");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_derived_batch\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_derived_batch: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,228 @@
+// ==============================
+// File: tests/test_ensemble_runner.cpp
+// ==============================
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "maxcore/ensemble.h"
+#include "maxcore/maxcore.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_core(const maxcore::MaxCore& a, const maxcore::MaxCore& b) {
+    return same_bits(a.Current().phi, b.Current().phi) &&
+           same_bits(a.Current().memory, b.Current().memory) &&
+           same_bits(a.Current().kappa, b.Current().kappa) &&
+           same_bits(a.Previous().kappa, b.Previous().kappa) &&
+           a.Lifecycle().step_counter == b.Lifecycle().step_counter &&
+           a.Lifecycle().terminal == b.Lifecycle().terminal &&
+           a.Lifecycle().collapse_emitted == b.Lifecycle().collapse_emitted;
+}
+
+// Heterogeneous population: per-entity rho / lambda_phi and delta_dim 2 or 3,
+// so cores collapse at very different times (uneven load).
+struct Population {
+    std::vector<maxcore::MaxCore> cores;
+    std::vector<std::vector<double>> inputs;
+    std::vector<size_t> steps;
+};
+
+static Population make_population(size_t n, size_t max_steps) {
+    using namespace maxcore;
+
+    Population pop;
+    for (size_t e = 0; e < n; ++e) {
+        const double f = static_cast<double>(e);
+        const ParameterSet p{
+            0.1, 0.2, 0.1, 0.1,
+            0.02 + 0.01 * static_cast<double>(e % 7),   // rho
+            0.01 + 0.02 * static_cast<double>(e % 11),  // lambda_phi
+            0.05,
+            1.0
+        };
+        const size_t dim = 2 + (e % 2);
+        pop.cores.push_back(MaxCore::Create(p, dim, StructuralState{0.0, 0.0, 1.0}).value());
+
+        const size_t steps = max_steps - (e % 13) * 7;
+        std::vector<double> rows(steps * dim);
+        for (size_t i = 0; i < steps; ++i) {
+            const double t = static_cast<double>(i);
+            for (size_t d = 0; d < dim; ++d) {
+                rows[i * dim + d] = 0.4 + 0.3 * std::sin(0.07 * t + 0.3 * f + static_cast<double>(d));
+            }
+        }
+        // A few entities carry an invalid row
+        if (e % 17 == 5) rows[(steps / 3) * dim] = std::numeric_limits<double>::quiet_NaN();
+
+        pop.inputs.push_back(std::move(rows));
+        pop.steps.push_back(steps);
+    }
+    return pop;
+}
+
+static void bind(maxcore::EnsembleRunner& runner, const Population& pop, double dt) {
+    for (size_t e = 0; e < pop.cores.size(); ++e) {
+        const maxcore::EntityInput in{pop.inputs[e].data(), pop.steps[e], pop.cores[e].DeltaDim(), dt};
+        expect_true(runner.SetInput(e, in), "SetInput must accept a valid buffer");
+    }
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_ensemble_runner\n";
+
+    const size_t n = 301;
+    const size_t max_steps = 200;
+    const double dt = 1.0;
+    const Population pop = make_population(n, max_steps);
+
+    // ---- Reference: serial Step() over every row of every entity
+    std::vector<MaxCore> ref = pop.cores;
+    size_t ref_collapsed = 0;
+    size_t ref_errors = 0;
+    size_t ref_rows = 0;
+    for (size_t e = 0; e < n; ++e) {
+        for (size_t i = 0; i < pop.steps[e]; ++i) {
+            const EventFlag ev = ref[e].Step(pop.inputs[e].data() + i * ref[e].DeltaDim(), ref[e].DeltaDim(), dt);
+            ref_rows += 1u;
+            if (ev == EventFlag::COLLAPSE) ref_collapsed += 1u;
+            if (ev == EventFlag::ERROR) ref_errors += 1u;
+        }
+    }
+    std::cout << "reference: collapsed=" << ref_collapsed << " errors=" << ref_errors << "\n";
+    expect_true(ref_collapsed > 0 && ref_errors > 0, "population must exercise COLLAPSE and ERROR");
+
+    // ---- Barrier-per-tick mode, several worker counts
+    for (size_t workers : {1u, 2u, 5u, 0u}) {
+        auto runner = EnsembleRunner::Create(pop.cores, workers);
+        expect_true(runner.has_value(), "Create must accept a non-empty population");
+        if (!runner) continue;
+        bind(*runner, pop, dt);
+
+        EnsembleStats total{0, 0, 0};
+        for (size_t t = 0; t < max_steps; ++t) {
+            const EnsembleStats s = runner->Tick();
+            total.rows += s.rows;
+            total.collapsed += s.collapsed;
+            total.errors += s.errors;
+        }
+        const EnsembleStats idle = runner->Tick();
+
+        bool parity = true;
+        for (size_t e = 0; e < n; ++e) {
+            parity = parity && same_core(runner->Core(e), ref[e]) && runner->Remaining(e) == 0u;
+        }
+        expect_true(parity, "Tick: every entity must match serial stepping bitwise");
+        expect_true(total.rows == ref_rows && total.collapsed == ref_collapsed && total.errors == ref_errors,
+                    "Tick: stats must match serial stepping");
+        expect_true(idle.rows == 0u, "Tick on exhausted buffers must consume nothing");
+    }
+
+    // ---- Free-running mode: stops at each entity's first event, resumes on the next call
+    for (size_t workers : {1u, 3u, 8u}) {
+        auto runner = EnsembleRunner::Create(pop.cores, workers);
+        if (!runner) continue;
+        bind(*runner, pop, dt);
+
+        EnsembleStats first = runner->RunFree();
+        bool stopped_at_event = true;
+        for (size_t e = 0; e < n; ++e) {
+            if (runner->LastEvent(e) == EventFlag::NORMAL) {
+                stopped_at_event = stopped_at_event && runner->Remaining(e) == 0u;
+            }
+        }
+        expect_true(stopped_at_event, "RunFree: an entity only stops early on COLLAPSE or ERROR");
+        expect_true(first.collapsed + first.errors > 0, "RunFree: some entities must stop on an event");
+
+        EnsembleStats total = first;
+        for (int round = 0; round < 8; ++round) {
+            const EnsembleStats s = runner->RunFree();
+            total.rows += s.rows;
+            total.collapsed += s.collapsed;
+            total.errors += s.errors;
+        }
+
+        bool parity = true;
+        for (size_t e = 0; e < n; ++e) {
+            parity = parity && same_core(runner->Core(e), ref[e]) && runner->Remaining(e) == 0u;
+        }
+        expect_true(parity, "RunFree: every entity must match serial stepping bitwise");
+        expect_true(total.rows == ref_rows && total.collapsed == ref_collapsed && total.errors == ref_errors,
+                    "RunFree: stats must match serial stepping");
+    }
+
+    // ---- Budgeted free run equals the same number of ticks when no entity stops early
+    {
+        auto a = EnsembleRunner::Create(pop.cores, 4);
+        auto b = EnsembleRunner::Create(pop.cores, 2);
+        if (a && b) {
+            bind(*a, pop, dt);
+            bind(*b, pop, dt);
+            a->RunFree(5);
+            for (int t = 0; t < 5; ++t) b->Tick();
+
+            bool parity = true;
+            for (size_t e = 0; e < n; ++e) {
+                parity = parity && same_core(a->Core(e), b->Core(e)) && a->Cursor(e) == 5u && b->Cursor(e) == 5u;
+            }
+            expect_true(parity, "RunFree(5) must match 5 ticks");
+        }
+    }
+
+    // ---- Contract
+    {
+        expect_true(!EnsembleRunner::Create({}, 4), "empty population must be rejected");
+
+        auto runner = EnsembleRunner::Create(pop.cores, 2);
+        if (runner) {
+            const double row[3] = {1.0, 1.0, 1.0};
+            expect_true(!runner->SetInput(n, EntityInput{row, 1, 3, dt}), "out-of-range entity must be rejected");
+            expect_true(!runner->SetInput(0, EntityInput{nullptr, 1, 2, dt}), "null buffer must be rejected");
+            expect_true(!runner->SetInput(1, EntityInput{row, 1, 2, dt}), "stride < delta_dim must be rejected");
+            expect_true(runner->SetInput(0, EntityInput{nullptr, 0, 2, dt}), "empty buffer must be accepted");
+
+            const EnsembleStats s = runner->Tick();
+            expect_true(s.rows == 0u, "entities without input must not step");
+            expect_true(runner->Core(0).Lifecycle().step_counter == 0u, "unbound entity must not mutate");
+
+            // Runner is movable; the pool follows it.
+            EnsembleRunner moved = std::move(*runner);
+            bind(moved, pop, dt);
+            moved.Tick();
+            expect_true(same_core(moved.Core(0), [&]() {
+                MaxCore c = pop.cores[0];
+                c.Step(pop.inputs[0].data(), c.DeltaDim(), dt);
+                return c;
+            }()), "moved runner must keep working");
+        }
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_ensemble_runner\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_ensemble_runner: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,171 @@
+// ==============================
+// File: tests/test_entity_store.cpp
+// ==============================
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "maxcore/entity_store.h"
+#include "maxcore/maxcore.h"
+#include "maxcore/profile.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+// Deterministic xorshift so the batches are reproducible.
+static uint64_t next_rand(uint64_t& s) {
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    return s;
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_entity_store\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const ParameterProfile profile = ParameterProfile::Create(p, 2, 6.0, ReductionMode::LANES4).value();
+    const StructuralState genesis{0.0, 0.0, 1.5};
+
+    // ---- Validation
+    {
+        expect_true(!EntityStore::Create(profile, StructuralState{0.0, 0.0, 99.0}), "kappa above kappa_max rejected");
+        expect_true(!EntityStore::Create(profile, StructuralState{std::numeric_limits<double>::quiet_NaN(), 0.0, 1.0}),
+                    "non-finite genesis rejected");
+        auto s = EntityStore::Create(profile, genesis, 5, 1);
+        expect_true(s.has_value() && s->Shards() == 8u && s->Workers() == 1u, "shards round up to a power of two");
+        expect_true(s->Size() == 0u && !s->Contains(1u) && !s->Current(1u), "new store is empty");
+        expect_true(s->Apply(nullptr, 3).applied == 0u, "null batch applies nothing");
+    }
+
+    // ---- Bitwise parity with unordered_map<id, MaxCore> for several shard / worker counts
+    {
+        const size_t ids = 3000;
+        const size_t batches = 25;
+        const size_t per_batch = 4000;
+
+        // Shared delta pool; some entries are NaN to exercise ERROR.
+        std::vector<double> pool(2 * 64);
+        uint64_t seed = 0x9e3779b97f4a7c15ull;
+        for (size_t k = 0; k < pool.size(); ++k) {
+            pool[k] = static_cast<double>(next_rand(seed) % 2000u) * 0.001;
+        }
+        pool[2 * 17] = std::numeric_limits<double>::quiet_NaN();
+
+        struct Config {
+            size_t shards;
+            size_t workers;
+        };
+        for (const Config cfg : {Config{1, 1}, Config{4, 1}, Config{16, 3}, Config{0, 4}}) {
+            EntityStore store = EntityStore::Create(profile, genesis, cfg.shards, cfg.workers).value();
+            std::unordered_map<uint64_t, MaxCore> ref;
+
+            // Some ids get their own initial state up front.
+            for (uint64_t id = 0; id < 50; ++id) {
+                const StructuralState init{0.1, 0.0, 0.5 + 0.01 * static_cast<double>(id)};
+                const uint64_t key = id * 7919u;
+                expect_true(store.Insert(key, init), "Insert of a new id succeeds");
+                ref.emplace(key, MaxCore::Create(p, 2, init, 6.0, ReductionMode::LANES4).value());
+            }
+            expect_true(!store.Insert(0u, genesis), "duplicate Insert rejected");
+            expect_true(!store.Insert(123456789u, StructuralState{0.0, 0.0, -1.0}), "invalid Insert rejected");
+
+            bool events_ok = true;
+            bool stats_ok = true;
+            uint64_t rs = 12345;
+            std::vector<KeyedUpdate> batch(per_batch);
+            std::vector<EventFlag> events(per_batch);
+            for (size_t b = 0; b < batches; ++b) {
+                for (size_t k = 0; k < per_batch; ++k) {
+                    const uint64_t r = next_rand(rs);
+                    const uint64_t id = (r % ids) * 7919u;  // many repeats per batch
+                    const double* delta = (r % 97u == 5u) ? nullptr : &pool[2 * ((r >> 20) % 64u)];
+                    const double dt = (r % 211u == 3u) ? 100.0 : 0.01;  // occasional unstable dt
+                    batch[k] = KeyedUpdate{id, delta, dt};
+                }
+
+                const EntityStoreStats st = store.Apply(batch.data(), batch.size(), events.data());
+
+                EntityStoreStats want{0, 0, 0, 0};
+                for (size_t k = 0; k < per_batch; ++k) {
+                    const KeyedUpdate& u = batch[k];
+                    auto it = ref.find(u.id);
+                    if (it == ref.end()) {
+                        it = ref.emplace(u.id, MaxCore::Create(p, 2, genesis, 6.0, ReductionMode::LANES4).value()).first;
+                        want.inserted += 1u;
+                    }
+                    const EventFlag ev = it->second.Step(u.delta, 2, u.dt);
+                    events_ok = events_ok && events[k] == ev;
+                    want.applied += 1u;
+                    if (ev == EventFlag::COLLAPSE) want.collapsed += 1u;
+                    if (ev == EventFlag::ERROR) want.errors += 1u;
+                }
+                stats_ok = stats_ok && st.applied == want.applied && st.inserted == want.inserted &&
+                           st.collapsed == want.collapsed && st.errors == want.errors;
+            }
+
+            bool states_ok = store.Size() == ref.size();
+            bool saw_collapse = false;
+            for (const auto& kv : ref) {
+                const MaxCore& c = kv.second;
+                const auto cur = store.Current(kv.first);
+                const auto prev = store.Previous(kv.first);
+                const auto lc = store.Lifecycle(kv.first);
+                states_ok = states_ok && cur && prev && lc && same_state(*cur, c.Current()) &&
+                            same_state(*prev, c.Previous()) && lc->step_counter == c.Lifecycle().step_counter &&
+                            lc->terminal == c.Lifecycle().terminal &&
+                            lc->collapse_emitted == c.Lifecycle().collapse_emitted;
+                saw_collapse = saw_collapse || c.Lifecycle().collapse_emitted;
+            }
+            expect_true(states_ok, "store must match unordered_map<id, MaxCore> bitwise");
+            expect_true(events_ok, "events_out must match per-update MaxCore::Step");
+            expect_true(stats_ok, "Apply stats must match the reference counts");
+            expect_true(saw_collapse, "workload must reach collapse");
+            expect_true(!store.Contains(1u), "unseen id is absent");
+        }
+    }
+
+    // ---- Moved store keeps its entities
+    {
+        EntityStore a = EntityStore::Create(profile, genesis, 2, 2).value();
+        const double d[2] = {0.3, 0.4};
+        const KeyedUpdate u{42u, d, 0.01};
+        a.Apply(&u, 1);
+        EntityStore b = std::move(a);
+        expect_true(b.Contains(42u) && b.Lifecycle(42u)->step_counter == 1u, "moved store keeps entities");
+        b.Apply(&u, 1);
+        expect_true(b.Lifecycle(42u)->step_counter == 2u, "moved store keeps applying");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_entity_store\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_entity_store: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,282 @@
+// ==============================
+// File: tests/test_event_queue.cpp
+// ==============================
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "maxcore/ensemble.h"
+#include "maxcore/event_queue.h"
+#include "maxcore/maxcore.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+static maxcore::CoreEvent make_event(uint64_t entity, uint64_t seq) {
+    const double v = static_cast<double>(seq);
+    return maxcore::CoreEvent{entity, seq, maxcore::EventFlag::COLLAPSE, maxcore::StructuralState{v, v + 0.5, 0.0}};
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_event_queue\n";
+
+    // ---- Creation and capacity rounding
+    {
+        expect_true(!EventQueue::Create(0), "capacity 0 rejected");
+        expect_true(!EventQueue::Create(std::numeric_limits<size_t>::max()), "oversized capacity rejected");
+        // Passes the size check, but no host can allocate it: nullopt, not std::bad_alloc.
+        expect_true(!EventQueue::Create(std::numeric_limits<size_t>::max() / 256u), "failed allocation rejected");
+        auto q = EventQueue::Create(100);
+        expect_true(q.has_value() && q->Capacity() == 128u, "capacity rounds up to a power of two");
+        expect_true(EventQueue::Create(1)->Capacity() == 1u, "capacity 1 is valid");
+    }
+
+    // ---- Single thread: FIFO, batch dequeue, overflow accounting, wrap-around
+    {
+        EventQueue q = EventQueue::Create(8).value();
+        CoreEvent out[16];
+        expect_true(q.PopBatch(out, 16) == 0u && !q.TryPop(out[0]), "empty queue pops nothing");
+
+        bool fifo = true;
+        uint64_t next_in = 0;
+        uint64_t next_out = 0;
+        for (size_t round = 0; round < 50; ++round) {
+            const size_t pushes = 3u + round % 9u;  // up to 11: overflows an 8-slot ring
+            for (size_t k = 0; k < pushes; ++k) {
+                if (q.TryPush(make_event(7u, next_in))) next_in += 1u;
+            }
+            const size_t n = q.PopBatch(out, 5u);
+            for (size_t k = 0; k < n; ++k) {
+                fifo = fifo && out[k].step_counter == next_out && out[k].entity == 7u &&
+                       same_state(out[k].state, make_event(7u, next_out).state);
+                next_out += 1u;
+            }
+        }
+        while (q.TryPop(out[0])) {
+            fifo = fifo && out[0].step_counter == next_out;
+            next_out += 1u;
+        }
+        expect_true(fifo, "single-producer events must dequeue in push order, intact");
+        expect_true(next_out == next_in, "every accepted event is dequeued exactly once");
+        expect_true(q.Dropped() > 0u, "overfull rounds must drop events");
+
+        uint64_t attempted = 0;
+        for (size_t round = 0; round < 50; ++round) attempted += 3u + round % 9u;
+        expect_true(q.Dropped() + next_in == attempted, "accepted + dropped == attempted");
+        expect_true(q.SizeApprox() == 0u, "drained queue is empty");
+
+        EventQueue moved = std::move(q);
+        expect_true(moved.TryPush(make_event(1u, 0u)) && moved.SizeApprox() == 1u, "moved queue keeps working");
+    }
+
+    // ---- Multiple producers, concurrent consumer
+    {
+        const size_t producers = 4;
+        const uint64_t per_producer = 200000;
+        EventQueue q = EventQueue::Create(1024).value();
+
+        std::atomic<size_t> running{producers};
+        std::vector<uint64_t> accepted(producers, 0);
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&q, &running, &accepted, p, per_producer]() {
+                uint64_t seq = 0;
+                for (uint64_t k = 0; k < per_producer; ++k) {
+                    // Sequence numbers count accepted events only, so gaps mean loss.
+                    if (q.TryPush(make_event(p, seq))) seq += 1u;
+                }
+                accepted[p] = seq;
+                running.fetch_sub(1u);
+            });
+        }
+
+        std::vector<uint64_t> next(producers, 0);
+        bool ordered = true;
+        std::vector<CoreEvent> buf(256);
+        for (;;) {
+            const bool done = running.load() == 0u;
+            const size_t n = q.PopBatch(buf.data(), buf.size());
+            for (size_t k = 0; k < n; ++k) {
+                const CoreEvent& ev = buf[k];
+                ordered = ordered && ev.entity < producers && ev.step_counter == next[ev.entity] &&
+                          same_state(ev.state, make_event(ev.entity, ev.step_counter).state);
+                if (ev.entity < producers) next[ev.entity] += 1u;
+            }
+            if (done && n == 0) break;
+        }
+        for (std::thread& t : threads) t.join();
+
+        uint64_t total_accepted = 0;
+        bool complete = true;
+        for (size_t p = 0; p < producers; ++p) {
+            complete = complete && next[p] == accepted[p];
+            total_accepted += accepted[p];
+        }
+        expect_true(ordered, "per-producer order must be preserved and events intact");
+        expect_true(complete, "every accepted event must be delivered exactly once");
+        expect_true(total_accepted + q.Dropped() == producers * per_producer, "accepted + dropped == attempted");
+    }
+
+    // ---- Ensemble reports COLLAPSE / ERROR through the queue
+    {
+        const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+        const size_t n = 90;
+        const size_t steps = 300;
+        std::vector<MaxCore> cores;
+        std::vector<std::vector<double>> inputs(n);
+        for (size_t e = 0; e < n; ++e) {
+            cores.push_back(MaxCore::Create(p, 2, StructuralState{0.0, 0.0, 1.0 + 0.08 * static_cast<double>(e)}).value());
+            inputs[e].assign(steps * 2, (e % 3 == 0) ? 0.2 : 2.0);
+            if (e % 7 == 1) inputs[e][20] = std::numeric_limits<double>::quiet_NaN();
+        }
+
+        for (size_t workers : {1u, 3u}) {
+            auto runner = EnsembleRunner::Create(cores, workers).value();
+            EventQueue q = EventQueue::Create(4096).value();
+            runner.SetEventQueue(&q);
+            for (size_t e = 0; e < n; ++e) runner.SetInput(e, EntityInput{inputs[e].data(), steps, 2, 0.01});
+
+            size_t collapsed = 0;
+            size_t errors = 0;
+            for (size_t t = 0; t < steps; ++t) {
+                const EnsembleStats s = (t % 60 == 30) ? runner.RunFree(5) : runner.Tick();
+                collapsed += s.collapsed;
+                errors += s.errors;
+            }
+
+            std::vector<CoreEvent> events(8192);
+            const size_t got = q.PopBatch(events.data(), events.size());
+            size_t got_collapsed = 0;
+            size_t got_errors = 0;
+            bool states_ok = true;
+            for (size_t k = 0; k < got; ++k) {
+                const CoreEvent& ev = events[k];
+                if (ev.event == EventFlag::COLLAPSE) {
+                    got_collapsed += 1u;
+                    const MaxCore& c = runner.Core(static_cast<size_t>(ev.entity));
+                    states_ok = states_ok && same_state(ev.state, c.Current()) &&
+                                ev.step_counter == c.Lifecycle().step_counter;
+                }
+                if (ev.event == EventFlag::ERROR) got_errors += 1u;
+            }
+            expect_true(collapsed > 0u && errors > 0u, "run must produce COLLAPSE and ERROR");
+            expect_true(got_collapsed == collapsed && got_errors == errors && q.Dropped() == 0u,
+                        "queue must receive every COLLAPSE and ERROR exactly once");
+            expect_true(states_ok, "COLLAPSE entries must carry the collapsed state and step_counter");
+        }
+    }
+
+    // ---- Orchestrator loop: drain the queue between ticks and restart collapsed entities
+    {
+        const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+        const size_t n = 70;
+        const size_t steps = 400;
+        const StructuralState genesis{0.0, 0.0, 2.0};
+        std::vector<MaxCore> cores;
+        std::vector<std::vector<double>> inputs(n);
+        for (size_t e = 0; e < n; ++e) {
+            cores.push_back(MaxCore::Create(p, 2, StructuralState{0.0, 0.0, 1.0 + 0.1 * static_cast<double>(e % 9)}).value());
+            inputs[e].assign(steps * 2, (e % 4 == 0) ? 0.3 : 1.5);
+        }
+
+        // Restart policy, applied identically to the runner and the serial reference:
+        // even entities restart right after their COLLAPSE is seen, odd ones are left
+        // coasting until tick 250, and entity 5 is given a terminal genesis at tick 100.
+        auto restarts = [&](size_t t, size_t e, bool collapsed_now, bool terminal) -> std::optional<StructuralState> {
+            if (e == 5 && t == 100) return StructuralState{0.0, 0.0, 0.0};
+            if (collapsed_now && e % 2 == 0) return genesis;
+            if (t == 250 && terminal) return genesis;
+            return std::nullopt;
+        };
+
+        for (size_t workers : {1u, 3u}) {
+            auto runner = EnsembleRunner::Create(cores, workers).value();
+            EventQueue q = EventQueue::Create(1024).value();
+            runner.SetEventQueue(&q);
+            for (size_t e = 0; e < n; ++e) runner.SetInput(e, EntityInput{inputs[e].data(), steps, 2, 0.01});
+            expect_true(!runner.Genesis(n, genesis), "Genesis out of range rejected");
+            expect_true(!runner.Genesis(0, StructuralState{0.0, 0.0, 99.0}), "invalid genesis state rejected");
+
+            std::vector<MaxCore> ref = cores;
+            std::vector<EventFlag> ref_last(n, EventFlag::NORMAL);
+            size_t restarted = 0;
+            bool live_ok = true;
+            std::vector<CoreEvent> buf(256);
+            for (size_t t = 0; t < steps; ++t) {
+                runner.Tick();
+
+                std::vector<bool> collapsed_now(n, false);
+                for (size_t e = 0; e < n; ++e) {
+                    ref_last[e] = ref[e].Step(&inputs[e][t * 2], 2, 0.01);
+                    collapsed_now[e] = ref_last[e] == EventFlag::COLLAPSE;
+                }
+
+                // The runner side learns of collapses only through the queue.
+                std::vector<bool> queued(n, false);
+                for (size_t got = q.PopBatch(buf.data(), buf.size()); got > 0; got = q.PopBatch(buf.data(), buf.size())) {
+                    for (size_t k = 0; k < got; ++k) {
+                        if (buf[k].event == EventFlag::COLLAPSE) queued[static_cast<size_t>(buf[k].entity)] = true;
+                    }
+                }
+
+                size_t ref_live = 0;
+                for (size_t e = 0; e < n; ++e) {
+                    live_ok = live_ok && queued[e] == collapsed_now[e];
+                    const auto runner_state = restarts(t, e, queued[e], runner.Core(e).Lifecycle().terminal);
+                    const auto ref_state = restarts(t, e, collapsed_now[e], ref[e].Lifecycle().terminal);
+                    if (runner_state) {
+                        live_ok = live_ok && runner.Genesis(e, *runner_state);
+                        restarted += 1u;
+                    }
+                    if (ref_state) ref[e].Genesis(*ref_state);
+                    if (!ref[e].Lifecycle().terminal) ref_live += 1u;
+                }
+                live_ok = live_ok && runner.Live() == ref_live;
+            }
+
+            bool same = true;
+            for (size_t e = 0; e < n; ++e) {
+                same = same && same_state(runner.Core(e).Current(), ref[e].Current()) &&
+                       same_state(runner.Core(e).Previous(), ref[e].Previous()) &&
+                       runner.Core(e).Lifecycle().step_counter == ref[e].Lifecycle().step_counter &&
+                       runner.Cursor(e) == steps && runner.LastEvent(e) == ref_last[e];
+            }
+            expect_true(restarted > n, "workload must restart entities repeatedly");
+            expect_true(live_ok, "queued collapses, Genesis results and live count must match the reference");
+            expect_true(same, "restarted ensemble must equal serial stepping with the same restarts");
+        }
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_event_queue\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_event_queue: " << g_fail << " failures\n";
+    return 2;
+}
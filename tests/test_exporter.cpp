@@ -0,0 +1,220 @@
+// ==============================
+// File: tests/test_exporter.cpp
+// ==============================
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "maxcore/derived.h"
+#include "maxcore/exporter.h"
+#include "maxcore/lifecycle.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static std::string read_file(const std::string& path) {
+    std::string text;
+    if (std::FILE* f = std::fopen(path.c_str(), "rb")) {
+        char buf[4096];
+        size_t n = 0;
+        while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+        std::fclose(f);
+    }
+    return text;
+}
+
+struct Row {
+    uint64_t t;
+    uint64_t lifecycle_id;
+    maxcore::EventFlag event;
+    maxcore::StructuralState state;
+    maxcore::LifecycleContext lifecycle;
+    maxcore::DerivedFrame derived;
+};
+
+// Reference CSV line with printf-style formatting (what iostream fixed + setprecision produced).
+static std::string printf_csv(const Row& r, int precision) {
+    static const char* names[] = {"NORMAL", "COLLAPSE", "ERROR"};
+    char buf[64];
+    std::string line = std::to_string(r.t) + "," + std::to_string(r.lifecycle_id) + "," +
+                       std::to_string(r.lifecycle.step_counter) + "," + names[static_cast<int>(r.event)] + "," +
+                       (r.lifecycle.terminal ? "1" : "0") + "," + (r.lifecycle.collapse_emitted ? "1" : "0");
+    const maxcore::DerivedFrame& d = r.derived;
+    const double values[] = {r.state.phi, r.state.memory, r.state.kappa, d.d_phi, d.d_memory, d.d_kappa,
+                             d.phi_rate, d.memory_rate, d.kappa_rate, d.kappa_ratio, d.kappa_distance,
+                             d.load_term, d.regen_term};
+    for (double v : values) {
+        std::snprintf(buf, sizeof(buf), ",%.*f", precision, v);
+        line += buf;
+    }
+    return line + "\n";
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_exporter\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const double delta[2] = {1.0, 2.0};
+    const double dt = 0.01;
+    const std::string path = "test_exporter.out";
+
+    // Rows of a multi-lifecycle pipeline run
+    std::vector<Row> rows;
+    {
+        auto runner = LifecycleRunner::Create(p, 2, StructuralState{0.0, 0.0, p.kappa_max});
+        if (!runner) return 2;
+        for (uint64_t t = 0; t < 300; ++t) {
+            const EventFlag ev = runner->Step(delta, 2, dt);
+            const MaxCore& core = runner->Core();
+            auto d = ComputeDerived(core.Current(), core.Previous(), core.Lifecycle(), p, dt);
+            if (!d) return 2;
+            rows.push_back(Row{t, runner->LifecycleId(), ev, core.Current(), core.Lifecycle(), *d});
+            if (ev == EventFlag::COLLAPSE) runner->Genesis();
+        }
+    }
+
+    // ---- CSV fixed precision: same text as printf, block size smaller than the output
+    {
+        ExportOptions opt;
+        opt.precision = 10;
+        opt.block_bytes = kMaxExportRowBytes;
+        {
+            auto e = TextExporter::Create(path, opt);
+            expect_true(e.has_value(), "CSV Create must succeed");
+            if (!e) return 2;
+            bool ok = true;
+            for (const Row& r : rows) ok = ok && e->Append(r.t, r.lifecycle_id, r.event, r.state, r.lifecycle, r.derived);
+            expect_true(ok && e->Rows() == rows.size(), "CSV Append must succeed");
+            expect_true(e->Close() && e->Close(), "Close must succeed and be idempotent");
+        }
+
+        std::string expected = TextExporter::Header(ExportFormat::CSV);
+        expect_true(expected.rfind("t,lifecycle,step_counter,event,terminal,collapse_emitted,phi,", 0) == 0,
+                    "CSV header schema");
+        for (const Row& r : rows) expected += printf_csv(r, 10);
+        expect_true(read_file(path) == expected, "CSV file must equal printf formatting");
+    }
+
+    // ---- Shortest round-trip: every double parses back to the same bits
+    {
+        ExportOptions opt;
+        char buf[kMaxExportRowBytes];
+        bool ok = true;
+        for (const Row& r : rows) {
+            const size_t n = TextExporter::FormatRow(buf, opt, r.t, r.lifecycle_id, r.event, r.state, r.lifecycle, r.derived);
+            ok = ok && n > 0 && buf[n - 1] == '\n';
+            buf[n - 1] = '\0';
+
+            std::vector<std::string> fields;
+            for (char* tok = std::strtok(buf, ","); tok != nullptr; tok = std::strtok(nullptr, ",")) fields.emplace_back(tok);
+            ok = ok && fields.size() == 19u;
+            if (fields.size() != 19u) continue;
+            const double values[] = {r.state.phi, r.state.kappa, r.derived.kappa_rate, r.derived.regen_term};
+            const size_t cols[] = {6, 8, 14, 18};
+            for (size_t k = 0; k < 4; ++k) {
+                ok = ok && same_bits(std::strtod(fields[cols[k]].c_str(), nullptr), values[k]);
+            }
+        }
+        expect_true(ok, "shortest output must round-trip");
+    }
+
+    // ---- JSONL: one object per line, stable keys, null for non-finite
+    {
+        ExportOptions opt;
+        opt.format = ExportFormat::JSONL;
+        {
+            auto e = TextExporter::Create(path, opt);
+            if (!e) return 2;
+            Row r = rows[0];
+            e->Append(r.t, r.lifecycle_id, r.event, r.state, r.lifecycle, r.derived);
+            r.derived.d_phi = std::numeric_limits<double>::infinity();
+            r.lifecycle.terminal = true;
+            e->Append(r.t, r.lifecycle_id, r.event, r.state, r.lifecycle, r.derived);
+        }
+        const std::string text = read_file(path);
+        expect_true(TextExporter::Header(ExportFormat::JSONL).empty(), "JSONL has no header");
+        expect_true(text.rfind("{\"t\":0,\"lifecycle\":0,\"step_counter\":1,\"event\":\"NORMAL\",\"terminal\":false,"
+                               "\"collapse_emitted\":false,\"phi\":", 0) == 0,
+                    "JSONL key order and literals");
+        const size_t nl = text.find('\n');
+        expect_true(nl != std::string::npos && text[nl - 1] == '}' && text.back() == '\n', "one object per line");
+        expect_true(text.find("\"d_phi\":null", nl) != std::string::npos &&
+                    text.find("\"terminal\":true", nl) != std::string::npos, "non-finite written as null");
+    }
+
+    // ---- Move-assignment over an exporter with pending rows flushes and closes it
+    {
+        const std::string other = path + ".2";
+        ExportOptions opt;
+        opt.precision = 10;
+        {
+            auto e = TextExporter::Create(path, opt);
+            auto f = TextExporter::Create(other, opt);
+            expect_true(e.has_value() && f.has_value(), "move: Create must succeed");
+            if (!e || !f) return 2;
+            for (size_t i = 0; i < 10; ++i) {
+                const Row& r = rows[i];
+                e->Append(r.t, r.lifecycle_id, r.event, r.state, r.lifecycle, r.derived);
+            }
+            const Row& r = rows[10];
+            f->Append(r.t, r.lifecycle_id, r.event, r.state, r.lifecycle, r.derived);
+
+            *e = std::move(*f);
+            expect_true(e->Rows() == 1u, "move: destination takes over the source's rows");
+            e->Append(rows[11].t, rows[11].lifecycle_id, rows[11].event, rows[11].state, rows[11].lifecycle,
+                      rows[11].derived);
+        }
+
+        std::string first = TextExporter::Header(ExportFormat::CSV);
+        for (size_t i = 0; i < 10; ++i) first += printf_csv(rows[i], 10);
+        expect_true(read_file(path) == first, "move: pending rows of the destination must be written");
+
+        const std::string second = TextExporter::Header(ExportFormat::CSV) + printf_csv(rows[10], 10) +
+                                   printf_csv(rows[11], 10);
+        expect_true(read_file(other) == second, "move: source's file continues under the destination");
+        std::remove(other.c_str());
+    }
+
+    // ---- Invalid options
+    {
+        ExportOptions opt;
+        opt.precision = kMaxExportPrecision + 1;
+        expect_true(!TextExporter::Create(path, opt), "precision above the maximum must be rejected");
+        opt.precision = 6;
+        opt.block_bytes = kMaxExportRowBytes - 1u;
+        expect_true(!TextExporter::Create(path, opt), "block smaller than one row must be rejected");
+        expect_true(!TextExporter::Create("no_such_dir/x.csv"), "unopenable path must be rejected");
+    }
+
+    std::remove(path.c_str());
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_exporter\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_exporter: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,141 @@
+// ==============================
+// File: tests/test_fixed_parity.cpp
+// ==============================
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+
+#include "maxcore/maxcore.h"
+#include "maxcore/fixed.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(ua));
+    std::memcpy(&ub, &b, sizeof(ub));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+static maxcore::ParameterSet make_params() {
+    return maxcore::ParameterSet{
+        1.0,    // alpha
+        0.1,    // eta
+        0.5,    // beta
+        0.1,    // gamma
+        0.05,   // rho
+        0.25,   // lambda_phi
+        0.25,   // lambda_m
+        10.0    // kappa_max
+    };
+}
+
+// Runs a fixed core and a runtime-dim core side by side until collapse or `steps`.
+template <size_t Dim>
+static void run_parity(std::optional<double> delta_max, const char* label) {
+    using namespace maxcore;
+
+    const ParameterSet p = make_params();
+    const StructuralState init{0.0, 0.0, p.kappa_max};
+
+    auto fixed_opt = MaxCoreFixed<Dim>::Create(p, init, delta_max);
+    auto core_opt = MaxCore::Create(p, Dim, init, delta_max);
+    expect_true(fixed_opt.has_value() && core_opt.has_value(), label);
+    if (!fixed_opt || !core_opt) return;
+
+    MaxCoreFixed<Dim> fixed = *fixed_opt;
+    MaxCore core = *core_opt;
+
+    const double dt = 0.01;
+    bool diverged = false;
+
+    for (int t = 0; t < 2000 && !diverged; ++t) {
+        std::array<double, Dim> delta{};
+        for (size_t i = 0; i < Dim; ++i) {
+            delta[i] = 0.3 + 0.017 * static_cast<double>(i) - 0.0004 * t;
+        }
+
+        const EventFlag ev_f = fixed.Step(delta, dt);
+        const EventFlag ev_c = core.Step(delta.data(), Dim, dt);
+
+        if (ev_f != ev_c ||
+            !same_state(fixed.Current(), core.Current()) ||
+            !same_state(fixed.Previous(), core.Previous()) ||
+            fixed.Lifecycle().step_counter != core.Lifecycle().step_counter ||
+            fixed.Lifecycle().terminal != core.Lifecycle().terminal ||
+            fixed.Lifecycle().collapse_emitted != core.Lifecycle().collapse_emitted) {
+            diverged = true;
+        }
+    }
+
+    expect_true(!diverged, label);
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_fixed_parity\n";
+
+    // Library-instantiated production dims
+    run_parity<2>(std::nullopt, "Dim=2 must match MaxCore bitwise");
+    run_parity<3>(std::nullopt, "Dim=3 must match MaxCore bitwise");
+    run_parity<8>(std::nullopt, "Dim=8 must match MaxCore bitwise");
+    run_parity<8>(0.5, "Dim=8 with norm guard must match MaxCore bitwise");
+
+    // Caller-instantiated dim
+    run_parity<5>(std::nullopt, "Dim=5 must match MaxCore bitwise");
+
+    const ParameterSet p = make_params();
+    const StructuralState init{0.0, 0.0, p.kappa_max};
+
+    // ---- ERROR paths: no mutation
+    {
+        MaxCoreFixed<3> fixed = MaxCoreFixed<3>::Create(p, init).value();
+
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const double bad[3] = {1.0, nan, 2.0};
+        expect_true(fixed.Step(bad, 0.01) == EventFlag::ERROR, "non-finite component must yield ERROR");
+
+        const double ok[3] = {1.0, 2.0, 3.0};
+        expect_true(fixed.Step(ok, 0.0) == EventFlag::ERROR, "dt==0 must yield ERROR");
+        expect_true(fixed.Step(ok, 1000.0) == EventFlag::ERROR, "unstable dt must yield ERROR");
+
+        const double huge[3] = {1e200, 1e200, 0.0};
+        expect_true(fixed.Step(huge, 0.01) == EventFlag::ERROR, "overflowing norm2 must yield ERROR");
+
+        expect_true(fixed.Lifecycle().step_counter == 0u, "ERROR must not mutate");
+        expect_true(same_state(fixed.Current(), init), "ERROR must not change state");
+    }
+
+    // ---- Create validation mirrors MaxCore::Create
+    {
+        StructuralState bad = init;
+        bad.kappa = -1.0;
+        expect_true(!MaxCoreFixed<2>::Create(p, bad).has_value(), "Create must reject invalid state");
+        expect_true(!MaxCoreFixed<2>::Create(p, init, 0.0).has_value(), "Create must reject delta_max <= 0");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_fixed_parity\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_fixed_parity: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,174 @@
+// ==============================
+// File: tests/test_genesis.cpp
+// ==============================
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+
+#include "maxcore/lifecycle.h"
+#include "maxcore/maxcore.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+static bool same_core(const maxcore::MaxCore& a, const maxcore::MaxCore& b) {
+    return same_state(a.Current(), b.Current()) &&
+           same_state(a.Previous(), b.Previous()) &&
+           a.Lifecycle().step_counter == b.Lifecycle().step_counter &&
+           a.Lifecycle().terminal == b.Lifecycle().terminal &&
+           a.Lifecycle().collapse_emitted == b.Lifecycle().collapse_emitted;
+}
+
+static maxcore::ParameterSet make_params() {
+    return maxcore::ParameterSet{
+        1.0,    // alpha
+        0.1,    // eta
+        0.5,    // beta
+        0.1,    // gamma
+        0.05,   // rho
+        0.25,   // lambda_phi
+        0.25,   // lambda_m
+        10.0    // kappa_max
+    };
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_genesis\n";
+
+    const ParameterSet p = make_params();
+    const StructuralState init{0.0, 0.0, p.kappa_max};
+    const double delta[2] = {1.0, 2.0};
+    const double dt = 0.01;
+
+    // ---- Genesis after collapse is indistinguishable from a fresh Create()
+    {
+        MaxCore core = MaxCore::Create(p, 2, init).value();
+        EventFlag ev = EventFlag::NORMAL;
+        for (int i = 0; i < 10000 && ev != EventFlag::COLLAPSE; ++i) ev = core.Step(delta, 2, dt);
+        expect_true(ev == EventFlag::COLLAPSE && core.Lifecycle().terminal, "setup must collapse");
+
+        const StructuralState restart{0.5, 0.25, 7.0};
+        expect_true(core.Genesis(restart), "Genesis must accept a valid state");
+
+        MaxCore fresh = MaxCore::Create(p, 2, restart).value();
+        expect_true(same_core(core, fresh), "Genesis must equal a fresh Create()");
+
+        bool parity = true;
+        for (int i = 0; i < 500; ++i) {
+            const EventFlag a = core.Step(delta, 2, dt);
+            const EventFlag b = fresh.Step(delta, 2, dt);
+            parity = parity && a == b && same_core(core, fresh);
+        }
+        expect_true(parity, "stepping after Genesis must match a fresh core bitwise");
+    }
+
+    // ---- Invalid genesis state is rejected without mutation
+    {
+        MaxCore core = MaxCore::Create(p, 2, init).value();
+        core.Step(delta, 2, dt);
+        const MaxCore before = core;
+
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        expect_true(!core.Genesis(StructuralState{nan, 0.0, 1.0}), "non-finite state must be rejected");
+        expect_true(!core.Genesis(StructuralState{-1.0, 0.0, 1.0}), "negative phi must be rejected");
+        expect_true(!core.Genesis(StructuralState{0.0, 0.0, p.kappa_max * 2.0}), "kappa > kappa_max must be rejected");
+        expect_true(same_core(core, before), "rejected Genesis must not mutate");
+
+        expect_true(core.Genesis(StructuralState{0.0, 0.0, 0.0}), "terminal genesis state must be accepted");
+        expect_true(core.Lifecycle().terminal && !core.Lifecycle().collapse_emitted,
+                    "terminal genesis must be terminal without collapse");
+    }
+
+    // ---- LifecycleRunner: ids and summaries
+    {
+        auto runner = LifecycleRunner::Create(p, 2, init);
+        expect_true(runner.has_value(), "runner Create must accept valid input");
+        expect_true(!LifecycleRunner::Create(p, 0, init), "runner Create must reject delta_dim == 0");
+
+        if (runner) {
+            // Manual reference with explicit Create() per lifecycle
+            MaxCore ref = MaxCore::Create(p, 2, init).value();
+            uint64_t ref_id = 0;
+            uint64_t ref_len = 0;
+            double ref_min = init.kappa;
+            bool summaries_ok = true;
+            bool parity = true;
+
+            for (int t = 0; t < 3000; ++t) {
+                const EventFlag a = runner->Step(delta, 2, dt);
+                const EventFlag b = ref.Step(delta, 2, dt);
+                ref_len = ref.Lifecycle().step_counter;
+                ref_min = std::min(ref_min, ref.Current().kappa);
+                parity = parity && a == b && same_core(runner->Core(), ref) && runner->LifecycleId() == ref_id;
+
+                if (a == EventFlag::COLLAPSE) {
+                    const LifecycleSummary s = runner->Genesis();
+                    summaries_ok = summaries_ok && s.lifecycle_id == ref_id && s.length == ref_len &&
+                                   same_bits(s.min_kappa, ref_min) && s.collapsed && same_bits(s.min_kappa, 0.0);
+
+                    ref = MaxCore::Create(p, 2, init).value();
+                    ref_id += 1u;
+                    ref_min = init.kappa;
+                }
+            }
+
+            std::cout << "lifecycles closed=" << runner->History().size() << "\n";
+            expect_true(parity, "runner must match explicit re-Create bitwise");
+            expect_true(summaries_ok, "closed summaries must match the reference");
+            expect_true(runner->History().size() == ref_id && ref_id >= 2u, "History must hold every closed lifecycle");
+            expect_true(runner->LifecycleId() == ref_id, "LifecycleId must count genesis events");
+
+            const LifecycleSummary running = runner->Running();
+            expect_true(running.lifecycle_id == ref_id && running.length == ref.Lifecycle().step_counter &&
+                        same_bits(running.min_kappa, ref_min) && !running.collapsed,
+                        "Running summary must track the open lifecycle");
+
+            // Explicit genesis before collapse closes a non-collapsed lifecycle
+            const LifecycleSummary early = runner->Genesis();
+            expect_true(!early.collapsed && runner->Core().Lifecycle().step_counter == 0u,
+                        "early Genesis must close a non-collapsed lifecycle and reset the core");
+
+            // ERROR steps do not affect the summary
+            const double bad[2] = {std::numeric_limits<double>::quiet_NaN(), 0.0};
+            expect_true(runner->Step(bad, 2, dt) == EventFlag::ERROR, "invalid delta must return ERROR");
+            expect_true(runner->Running().length == 0u && same_bits(runner->Running().min_kappa, init.kappa),
+                        "ERROR must not change the running summary");
+
+            const size_t before = runner->History().size();
+            runner->ClearHistory();
+            expect_true(before > 0 && runner->History().empty(), "ClearHistory must drain History");
+            expect_true(runner->LifecycleId() == ref_id + 1u, "ClearHistory must not reset lifecycle ids");
+        }
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_genesis\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_genesis: " << g_fail << " failures\n";
+    return 2;
+}
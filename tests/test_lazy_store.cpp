@@ -0,0 +1,252 @@
+// ==============================
+// File: tests/test_lazy_store.cpp
+// ==============================
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "maxcore/lazy_store.h"
+#include "maxcore/maxcore.h"
+#include "maxcore/profile.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+static bool close_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    auto close = [](double x, double y) { return std::fabs(x - y) <= 1e-9 * (1.0 + std::fabs(y)); };
+    return close(a.phi, b.phi) && close(a.memory, b.memory) && close(a.kappa, b.kappa);
+}
+
+static bool same_lifecycle(const maxcore::LifecycleContext& a, const maxcore::LifecycleContext& b) {
+    return a.step_counter == b.step_counter && a.terminal == b.terminal && a.collapse_emitted == b.collapse_emitted;
+}
+
+static const size_t kEntities = 24;
+static const size_t kTicks = 3000;
+static const double kDt = 0.01;
+
+// Entity i receives input every 37..81 ticks; every sixth entity never does.
+static bool active(size_t i, size_t t) {
+    if (i % 6 == 5) return false;
+    const size_t period = 37 + 11 * (i % 5);
+    return (t + 5 * i) % period == 0;
+}
+
+static void delta_at(size_t i, size_t t, double* out) {
+    out[0] = 1.0 + 0.01 * static_cast<double>(t % 7);
+    out[1] = ((t + i) % 41 == 0) ? std::numeric_limits<double>::quiet_NaN() : 2.0;
+}
+
+// Idle entities with a large memory drain Kappa and collapse inside a gap.
+static maxcore::StructuralState initial_state(size_t i, double kappa_max) {
+    const double memory = (i % 4 == 0) ? 3.0 + 0.6 * static_cast<double>(i) : 0.0;
+    return maxcore::StructuralState{0.0, memory, kappa_max - 0.1 * static_cast<double>(i)};
+}
+
+using CollapseList = std::vector<std::pair<size_t, uint64_t>>;
+
+// Runs the scenario eagerly (every entity stepped every tick) and lazily, and
+// compares events, lifecycles, states and collapse ticks.
+static void run_mode(const maxcore::ParameterProfile& profile, maxcore::CatchUpMode mode, const char* name) {
+    using namespace maxcore;
+
+    const ParameterSet& p = profile.Params();
+    std::optional<LazyEntityStore> store = LazyEntityStore::Create(profile, kDt, mode);
+    expect_true(store.has_value(), "store Create must succeed");
+    if (!store) return;
+
+    std::vector<MaxCore> eager;
+    for (size_t i = 0; i < kEntities; ++i) {
+        const StructuralState init = initial_state(i, p.kappa_max);
+        eager.push_back(MaxCore::Create(p, 2, init, profile.DeltaMax()).value());
+        expect_true(store->Add(init) == std::optional<size_t>(i), "ids are dense in insertion order");
+    }
+
+    const double zero[2] = {0.0, 0.0};
+    double delta[2] = {0.0, 0.0};
+    CollapseList eager_collapses;
+    bool events_ok = true;
+    bool reads_ok = true;
+    size_t inputs = 0;
+
+    for (size_t t = 0; t < kTicks; ++t) {
+        for (size_t i = 0; i < kEntities; ++i) {
+            EventFlag ev = EventFlag::NORMAL;
+            if (active(i, t)) {
+                delta_at(i, t, delta);
+                ev = eager[i].Step(delta, 2, kDt);
+                events_ok = events_ok && store->Input(i, delta, 2) == ev;
+                inputs += 1u;
+            } else {
+                ev = eager[i].Step(zero, 2, kDt);
+            }
+            if (ev == EventFlag::COLLAPSE) eager_collapses.emplace_back(i, t);
+        }
+        store->Tick();
+
+        // Occasional reads catch an entity up mid-run.
+        if (t % 250 == 249) {
+            const size_t i = (t / 250) % kEntities;
+            const StructuralState& s = store->Current(i);
+            reads_ok = reads_ok && same_lifecycle(store->Lifecycle(i), eager[i].Lifecycle()) &&
+                       ((mode == CatchUpMode::EXACT) ? same_state(s, eager[i].Current())
+                                                     : close_state(s, eager[i].Current()));
+        }
+    }
+    expect_true(inputs < kEntities * kTicks / 20u, "scenario must be mostly idle");
+    expect_true(events_ok, name);
+    expect_true(reads_ok, "mid-run reads must match eager stepping");
+
+    store->SyncAll();
+    bool states_ok = true;
+    bool lifecycle_ok = true;
+    size_t never_collapsed = 0;
+    for (size_t i = 0; i < kEntities; ++i) {
+        lifecycle_ok = lifecycle_ok && same_lifecycle(store->Lifecycle(i), eager[i].Lifecycle());
+        if (mode == CatchUpMode::EXACT) {
+            states_ok = states_ok && same_state(store->Current(i), eager[i].Current()) &&
+                        same_state(store->Previous(i), eager[i].Previous());
+        } else {
+            states_ok = states_ok && close_state(store->Current(i), eager[i].Current()) &&
+                        close_state(store->Previous(i), eager[i].Previous());
+        }
+        never_collapsed += eager[i].Lifecycle().collapse_emitted ? 0u : 1u;
+    }
+    expect_true(lifecycle_ok, "step_counter, terminal and collapse_emitted must match eager stepping");
+    expect_true(states_ok, "states must match eager stepping");
+
+    CollapseList lazy_collapses;
+    size_t gap_collapses = 0;
+    for (const CollapseRecord& r : store->Collapses()) {
+        lazy_collapses.emplace_back(r.entity, r.tick);
+        gap_collapses += active(r.entity, static_cast<size_t>(r.tick)) ? 0u : 1u;
+    }
+    std::sort(lazy_collapses.begin(), lazy_collapses.end());
+    std::sort(eager_collapses.begin(), eager_collapses.end());
+    expect_true(lazy_collapses == eager_collapses, "collapse ticks must match eager stepping");
+    expect_true(gap_collapses > 0u && never_collapsed > 0u,
+                "scenario must collapse inside gaps and keep some entities alive");
+
+    store->ClearCollapses();
+    expect_true(store->Collapses().empty(), "ClearCollapses empties the log");
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_lazy_store\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const ParameterProfile profile = ParameterProfile::Create(p, 2, 6.0).value();
+
+    run_mode(profile, CatchUpMode::EXACT, "EXACT events must match eager stepping");
+    run_mode(profile, CatchUpMode::CLOSED_FORM, "CLOSED_FORM events must match eager stepping");
+
+    // ---- Default catch-up over a long idle window that ends in collapse
+    {
+        LazyEntityStore store = LazyEntityStore::Create(profile, kDt).value();
+        const StructuralState init{0.0, 8.1, p.kappa_max};
+        const size_t id = store.Add(init).value();
+        MaxCore ref = MaxCore::Create(p, 2, init, 6.0).value();
+
+        const double zero[2] = {0.0, 0.0};
+        std::optional<uint64_t> collapse_tick;
+        const uint64_t window = 20000;
+        for (uint64_t t = 0; t < window; ++t) {
+            if (ref.Step(zero, 2, kDt) == EventFlag::COLLAPSE) collapse_tick = t;
+            store.Tick();
+        }
+        expect_true(collapse_tick.has_value() && *collapse_tick > 1000u,
+                    "default: fixture must collapse after a long stretch of the window");
+
+        const LifecycleContext lc = store.Lifecycle(id);
+        expect_true(same_state(store.Current(id), ref.Current()), "default: current must be bitwise eager");
+        expect_true(same_state(store.Previous(id), ref.Previous()), "default: previous must be bitwise eager");
+        expect_true(same_lifecycle(lc, ref.Lifecycle()), "default: step_counter and flags must match eager");
+        expect_true(store.Collapses().size() == 1u && store.Collapses()[0].entity == id &&
+                        std::optional<uint64_t>(store.Collapses()[0].tick) == collapse_tick,
+                    "default: collapse tick must match eager stepping");
+    }
+
+    // ---- Validation
+    {
+        expect_true(!LazyEntityStore::Create(profile, 0.0), "dt == 0 rejected");
+        expect_true(!LazyEntityStore::Create(profile, 100.0), "unstable dt rejected");
+        expect_true(!LazyEntityStore::Create(profile, std::numeric_limits<double>::quiet_NaN()), "NaN dt rejected");
+
+        LazyEntityStore store = LazyEntityStore::Create(profile, kDt).value();
+        expect_true(!store.Add(StructuralState{-1.0, 0.0, 1.0}), "negative phi rejected");
+        expect_true(!store.Add(StructuralState{0.0, 0.0, p.kappa_max * 2.0}), "kappa above kappa_max rejected");
+        expect_true(store.Size() == 0u, "rejected entities are not added");
+    }
+
+    // ---- Late Add, one step per tick, terminal entities
+    {
+        LazyEntityStore store = LazyEntityStore::Create(profile, kDt, CatchUpMode::EXACT).value();
+        const StructuralState init{0.0, 0.0, p.kappa_max};
+        for (size_t t = 0; t < 10; ++t) store.Tick();
+
+        const size_t id = store.Add(init).value();
+        MaxCore ref = MaxCore::Create(p, 2, init, 6.0).value();
+        const double zero[2] = {0.0, 0.0};
+        const double delta[2] = {1.0, 2.0};
+        for (size_t t = 0; t < 100; ++t) {
+            ref.Step(zero, 2, kDt);
+            store.Tick();
+        }
+        expect_true(store.Lifecycle(id).step_counter == 100u, "late entity steps from its first tick only");
+        expect_true(same_state(store.Current(id), ref.Current()), "late entity must match eager stepping");
+
+        expect_true(store.Input(id, delta, 2) == ref.Step(delta, 2, kDt), "input after a gap");
+        const StructuralState after = store.Current(id);
+        expect_true(store.Input(id, delta, 2) == EventFlag::ERROR, "second input in the same tick is ERROR");
+        expect_true(same_state(store.Current(id), after) && store.Lifecycle(id).step_counter == 101u,
+                    "second input in the same tick must not mutate");
+        expect_true(store.Input(id, nullptr, 2) == EventFlag::ERROR, "still ERROR for a NULL delta");
+
+        store.Tick();
+        expect_true(store.Input(id, nullptr, 2) == EventFlag::ERROR, "NULL delta is ERROR");
+        expect_true(store.Input(id + 0, delta, 1) == EventFlag::ERROR, "tick already consumed by the ERROR step");
+        store.Tick();
+        expect_true(store.Input(id, delta, 1) == EventFlag::ERROR, "dimension mismatch is ERROR");
+        expect_true(store.Lifecycle(id).step_counter == 101u, "ERROR steps do not commit");
+
+        const size_t dead = store.Add(StructuralState{1.0, 1.0, 0.0}).value();
+        for (size_t t = 0; t < 50; ++t) store.Tick();
+        expect_true(store.Input(dead, nullptr, 2) == EventFlag::NORMAL, "terminal entity short-circuits");
+        expect_true(store.Lifecycle(dead).step_counter == 0u && store.Lifecycle(dead).terminal,
+                    "terminal entity never commits");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_lazy_store\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_lazy_store: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,274 @@
+// ==============================
+// File: tests/test_parameter_sweep.cpp
+// ==============================
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "maxcore/maxcore.h"
+#include "maxcore/sweep.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static maxcore::ParameterSet make_base() {
+    return maxcore::ParameterSet{
+        0.1,   // alpha
+        0.2,   // eta
+        0.1,   // beta
+        0.1,   // gamma
+        0.1,   // rho
+        0.05,  // lambda_phi
+        0.05,  // lambda_m
+        1.0    // kappa_max
+    };
+}
+
+struct ScalarRun {
+    int64_t collapse_step;
+    maxcore::EventFlag stop_event;
+    maxcore::StructuralState final_state;
+    double min_kappa;
+};
+
+// Reference: a fresh MaxCore fed the stream until the first COLLAPSE or ERROR.
+static ScalarRun run_scalar(
+    const maxcore::ParameterSet& p,
+    const maxcore::StructuralState& init,
+    const std::vector<double>& rows,
+    size_t steps,
+    size_t dim,
+    double dt,
+    std::optional<double> delta_max = std::nullopt
+) {
+    using namespace maxcore;
+
+    MaxCore core = MaxCore::Create(p, dim, init, delta_max).value();
+    ScalarRun r{-1, EventFlag::NORMAL, init, init.kappa};
+    for (size_t i = 0; i < steps; ++i) {
+        const EventFlag ev = core.Step(rows.data() + i * dim, dim, dt);
+        if (ev == EventFlag::ERROR) {
+            r.stop_event = ev;
+            break;
+        }
+        r.min_kappa = std::min(r.min_kappa, core.Current().kappa);
+        if (ev == EventFlag::COLLAPSE) {
+            r.stop_event = ev;
+            r.collapse_step = static_cast<int64_t>(i);
+            break;
+        }
+    }
+    r.final_state = core.Current();
+    return r;
+}
+
+static bool same_result(const maxcore::SweepResult& a, const maxcore::SweepResult& b) {
+    if (a.Points() != b.Points() || a.shape != b.shape) return false;
+    for (size_t k = 0; k < a.Points(); ++k) {
+        if (a.collapse_step[k] != b.collapse_step[k]) return false;
+        if (a.stop_event[k] != b.stop_event[k]) return false;
+        if (!same_bits(a.final_phi[k], b.final_phi[k])) return false;
+        if (!same_bits(a.final_memory[k], b.final_memory[k])) return false;
+        if (!same_bits(a.final_kappa[k], b.final_kappa[k])) return false;
+        if (!same_bits(a.min_kappa[k], b.min_kappa[k])) return false;
+    }
+    return true;
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_parameter_sweep\n";
+
+    const ParameterSet base = make_base();
+    const StructuralState init{0.0, 0.0, 1.0};
+    const size_t dim = 3;
+    const size_t steps = 400;
+    const double dt = 1.0;
+
+    std::vector<double> rows(steps * dim);
+    for (size_t i = 0; i < steps; ++i) {
+        const double f = static_cast<double>(i);
+        rows[dim * i + 0] = 0.5 + 0.4 * std::sin(0.05 * f);
+        rows[dim * i + 1] = 0.3 + 0.002 * f;
+        rows[dim * i + 2] = 0.2 * std::cos(0.03 * f);
+    }
+
+    // 5 x 6 x 5 = 150 points: several 64-lane blocks, a partial tail block,
+    // a mix of collapsing and surviving points, and eta values that fail dt.
+    std::vector<SweepAxis> axes{
+        {&ParameterSet::rho, {0.02, 0.05, 0.15, 0.30, 0.60}},
+        {&ParameterSet::lambda_phi, {0.01, 0.02, 0.05, 0.10, 0.20, 0.40}},
+        {&ParameterSet::eta, {0.1, 0.2, 0.5, 0.9, 1.5}},
+    };
+
+    const auto sweep = ParameterSweep::Create(base, axes, dim, init);
+    expect_true(sweep.has_value(), "Create must accept a valid grid");
+    if (!sweep) {
+        std::cout << "[FAIL] test_parameter_sweep: " << g_fail << " failures\n";
+        return 2;
+    }
+    expect_true(sweep->Points() == 150u, "Points() must be the product of the axis sizes");
+    expect_true(sweep->Shape() == std::vector<size_t>({5u, 6u, 5u}), "Shape() must list the axis sizes");
+
+    // ---- Row-major decode, last axis fastest
+    {
+        const ParameterSet p = sweep->PointParams(1u * 30u + 2u * 5u + 3u);
+        expect_true(same_bits(p.rho, 0.05) && same_bits(p.lambda_phi, 0.05) && same_bits(p.eta, 0.9),
+                    "PointParams must decode row-major");
+        expect_true(same_bits(p.alpha, base.alpha), "unswept fields must come from the base");
+    }
+
+    // ---- Parity with scalar cores
+    const auto serial = sweep->Run(rows.data(), steps, dim, dt, 1);
+    expect_true(serial.has_value(), "Run must accept valid input");
+    if (serial) {
+        size_t collapsed = 0;
+        size_t errors = 0;
+        size_t survived = 0;
+        bool parity = true;
+        for (size_t k = 0; k < sweep->Points(); ++k) {
+            const ParameterSet p = sweep->PointParams(k);
+            if (!MaxCore::Create(p, dim, init)) {
+                parity = false;
+                continue;
+            }
+            const ScalarRun ref = run_scalar(p, init, rows, steps, dim, dt);
+            parity = parity &&
+                     serial->collapse_step[k] == ref.collapse_step &&
+                     serial->stop_event[k] == ref.stop_event &&
+                     same_bits(serial->final_phi[k], ref.final_state.phi) &&
+                     same_bits(serial->final_memory[k], ref.final_state.memory) &&
+                     same_bits(serial->final_kappa[k], ref.final_state.kappa) &&
+                     same_bits(serial->min_kappa[k], ref.min_kappa);
+
+            if (ref.stop_event == EventFlag::COLLAPSE) collapsed += 1;
+            if (ref.stop_event == EventFlag::ERROR) errors += 1;
+            if (ref.stop_event == EventFlag::NORMAL) survived += 1;
+        }
+        std::cout << "collapsed=" << collapsed << " errors=" << errors << " survived=" << survived << "\n";
+        expect_true(parity, "every point must match its scalar MaxCore bitwise");
+        expect_true(collapsed > 0 && errors > 0 && survived > 0, "grid must exercise every outcome");
+
+        // ---- Independence from thread count
+        for (size_t threads : {2u, 3u, 8u, 0u}) {
+            const auto multi = sweep->Run(rows.data(), steps, dim, dt, threads);
+            expect_true(multi.has_value() && same_result(*serial, *multi),
+                        "results must not depend on the thread count");
+        }
+    }
+
+    // ---- Invalid row stops live points with ERROR; collapsed points keep COLLAPSE
+    {
+        std::vector<double> bad = rows;
+        const size_t bad_row = 150;
+        bad[dim * bad_row + 1] = std::numeric_limits<double>::quiet_NaN();
+
+        const auto a = sweep->Run(bad.data(), steps, dim, dt, 4);
+        expect_true(a.has_value(), "Run with a NaN row must still return results");
+        if (a && serial) {
+            bool ok = true;
+            for (size_t k = 0; k < a->Points(); ++k) {
+                const ScalarRun ref = run_scalar(sweep->PointParams(k), init, bad, steps, dim, dt);
+                ok = ok && a->stop_event[k] == ref.stop_event && a->collapse_step[k] == ref.collapse_step &&
+                     same_bits(a->final_kappa[k], ref.final_state.kappa);
+            }
+            expect_true(ok, "NaN row must match the scalar ERROR semantics");
+        }
+    }
+
+    // ---- Norm guard: rows above delta_max are clamped once, then every point
+    // commits like a MaxCore created with the same delta_max
+    {
+        const double delta_max = 0.45;
+        const auto guarded = ParameterSweep::Create(base, axes, dim, init, delta_max);
+        expect_true(guarded.has_value(), "Create must accept delta_max");
+        const auto g = guarded ? guarded->Run(rows.data(), steps, dim, dt, 3) : std::nullopt;
+        expect_true(g.has_value(), "guarded Run must accept valid input");
+        if (g && serial) {
+            bool ok = true;
+            for (size_t k = 0; k < g->Points(); ++k) {
+                const ScalarRun ref = run_scalar(guarded->PointParams(k), init, rows, steps, dim, dt, delta_max);
+                ok = ok && g->stop_event[k] == ref.stop_event && g->collapse_step[k] == ref.collapse_step &&
+                     same_bits(g->final_phi[k], ref.final_state.phi) &&
+                     same_bits(g->final_kappa[k], ref.final_state.kappa) &&
+                     same_bits(g->min_kappa[k], ref.min_kappa);
+            }
+            expect_true(ok, "guarded points must match scalar MaxCore with delta_max bitwise");
+            expect_true(!same_result(*serial, *g), "delta_max must change the grid");
+        }
+    }
+
+    // ---- Strided input
+    {
+        const size_t stride = 5;
+        std::vector<double> wide(steps * stride, -7.0);
+        for (size_t i = 0; i < steps; ++i) {
+            for (size_t d = 0; d < dim; ++d) wide[stride * i + d] = rows[dim * i + d];
+        }
+        const auto s = sweep->Run(wide.data(), steps, stride, dt, 3);
+        expect_true(s.has_value() && serial && same_result(*serial, *s), "stride must only select rows");
+    }
+
+    // ---- Contract: Create rejects, Run rejects
+    {
+        expect_true(!ParameterSweep::Create(base, {}, dim, init), "no axes must be rejected");
+        expect_true(!ParameterSweep::Create(base, {{&ParameterSet::rho, {}}}, dim, init),
+                    "empty axis must be rejected");
+        expect_true(!ParameterSweep::Create(base, {{nullptr, {0.1}}}, dim, init), "null field must be rejected");
+        expect_true(!ParameterSweep::Create(base, {{&ParameterSet::rho, {0.1, -1.0}}}, dim, init),
+                    "invalid swept value must be rejected");
+        expect_true(!ParameterSweep::Create(base, {{&ParameterSet::kappa_max, {2.0, 0.5}}}, dim, init),
+                    "initial kappa above a swept kappa_max must be rejected");
+        expect_true(!ParameterSweep::Create(base, {{&ParameterSet::rho, {0.1}}}, 0, init),
+                    "delta_dim == 0 must be rejected");
+
+        expect_true(!sweep->Run(nullptr, steps, dim, dt), "null deltas must be rejected");
+        expect_true(!sweep->Run(rows.data(), steps, dim - 1, dt), "stride < delta_dim must be rejected");
+
+        const auto empty = sweep->Run(nullptr, 0, dim, dt, 2);
+        expect_true(empty.has_value(), "zero steps must be accepted");
+        if (empty) {
+            bool ok = true;
+            for (size_t k = 0; k < empty->Points(); ++k) {
+                ok = ok && same_bits(empty->final_kappa[k], init.kappa) && empty->collapse_step[k] == -1;
+            }
+            expect_true(ok, "zero steps must leave every point at the initial state");
+        }
+
+        const auto dead = ParameterSweep::Create(base, {{&ParameterSet::rho, {0.1, 0.2}}}, dim,
+                                                 StructuralState{0.0, 0.0, 0.0});
+        expect_true(dead.has_value(), "terminal initial state must be accepted");
+        if (dead) {
+            const auto r = dead->Run(rows.data(), steps, dim, 1000.0, 2);
+            expect_true(r.has_value() && r->stop_event[0] == EventFlag::NORMAL && r->collapse_step[0] == -1,
+                        "terminal points short-circuit to NORMAL before dt validation");
+        }
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_parameter_sweep\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_parameter_sweep: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,198 @@
+// ==============================
+// File: tests/test_predict_collapse.cpp
+// ==============================
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "maxcore/maxcore.h"
+#include "maxcore/predict.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static void expect_index(std::optional<uint64_t> got, std::optional<uint64_t> want, const char* msg) {
+    if (got != want) {
+        std::cout << "[FAIL] " << msg << " (got=" << (got ? static_cast<long long>(*got) : -1)
+                  << " want=" << (want ? static_cast<long long>(*want) : -1) << ")\n";
+        g_fail += 1;
+    }
+}
+
+static maxcore::MaxCore make_core() {
+    using namespace maxcore;
+
+    ParameterSet p{
+        1e-3,   // alpha
+        0.05,   // eta
+        0.02,   // beta
+        0.01,   // gamma
+        0.002,  // rho
+        0.01,   // lambda_phi
+        0.004,  // lambda_m
+        10.0    // kappa_max
+    };
+    return MaxCore::Create(p, 2, StructuralState{0.0, 0.0, p.kappa_max}).value();
+}
+
+// Plain Step() loop over a row generator: reference answer.
+template <class RowFn>
+static std::optional<uint64_t> reference(maxcore::MaxCore core, RowFn row, double dt, uint64_t horizon) {
+    for (uint64_t i = 0; i < horizon; ++i) {
+        const double* d = row(i);
+        if (d == nullptr) return std::nullopt;
+        const maxcore::EventFlag ev = core.Step(d, 2, dt);
+        if (ev == maxcore::EventFlag::COLLAPSE) return i;
+        if (ev == maxcore::EventFlag::ERROR) return std::nullopt;
+    }
+    return std::nullopt;
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_predict_collapse\n";
+
+    const double dt = 0.1;
+    const MaxCore core = make_core();
+
+    // ---- Constant input
+    {
+        const double slow[2] = {0.3 * 4.9, 0.4 * 4.9};
+        const double safe[2] = {0.3, 0.4};
+
+        const auto want = reference(core, [&](uint64_t) { return slow; }, dt, 100000);
+        expect_true(want.has_value(), "reference must collapse");
+        expect_index(PredictCollapse(core, DeltaSource::Constant(slow, 2), dt, 100000), want,
+                     "constant: index must match Step loop");
+
+        expect_index(PredictCollapse(core, DeltaSource::Constant(slow, 2), dt, *want), std::nullopt,
+                     "constant: horizon ending before collapse yields none");
+        expect_index(PredictCollapse(core, DeltaSource::Constant(slow, 2), dt, *want + 1), want,
+                     "constant: horizon covering the collapse step yields it");
+        expect_index(PredictCollapse(core, DeltaSource::Constant(safe, 2), dt, 5000000), std::nullopt,
+                     "constant: stable input yields none");
+    }
+
+    // ---- Piecewise-constant input
+    {
+        const double calm[2] = {0.3, 0.4};
+        const double storm[2] = {0.3 * 6.0, 0.4 * 6.0};
+        const DeltaSegment segs[] = {
+            {calm, 40000},
+            {storm, 1000},
+            {calm, 30000},
+            {storm, 100000},
+        };
+
+        auto row = [&](uint64_t i) -> const double* {
+            uint64_t acc = 0;
+            for (const DeltaSegment& s : segs) {
+                if (i < acc + s.steps) return s.delta;
+                acc += s.steps;
+            }
+            return nullptr;
+        };
+
+        const auto want = reference(core, row, dt, 1000000);
+        expect_true(want.has_value(), "piecewise reference must collapse");
+        expect_index(PredictCollapse(core, DeltaSource::Piecewise(segs, 4, 2), dt, 1000000), want,
+                     "piecewise: index must match Step loop");
+        expect_index(PredictCollapse(core, DeltaSource::Piecewise(segs, 2, 2), dt, 1000000), std::nullopt,
+                     "piecewise: source ending before collapse yields none");
+    }
+
+    // ---- Rounding-level ties: adjacent scales on both sides of a collapse-step boundary
+    {
+        const double calm[2] = {0.3, 0.4};
+
+        // Step-loop collapse index of a source built from `scale`: constant, or a calm
+        // prefix first so that the tie segment starts from a jumped state.
+        auto stepped = [&](double scale, bool prefix) {
+            const double d[2] = {0.3 * scale, 0.4 * scale};
+            return reference(core, [&](uint64_t i) { return (prefix && i < 30000) ? calm : d; }, dt, 1000000);
+        };
+        auto predicted = [&](double scale, bool prefix) {
+            const double d[2] = {0.3 * scale, 0.4 * scale};
+            const DeltaSegment segs[] = {{calm, 30000}, {d, 1000000}};
+            return prefix ? PredictCollapse(core, DeltaSource::Piecewise(segs, 2, 2), dt, 1000000)
+                          : PredictCollapse(core, DeltaSource::Constant(d, 2), dt, 1000000);
+        };
+
+        for (bool prefix : {false, true}) {
+            double lo = 5.0;
+            double hi = 8.0;
+            const auto at_start = stepped(lo, prefix);
+            while (true) {
+                const double mid = lo + (hi - lo) / 2.0;
+                if (!(mid > lo && mid < hi)) break;
+                if (stepped(mid, prefix) == at_start) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            expect_true(stepped(lo, prefix) != stepped(hi, prefix),
+                        "tie: bisection must end on a collapse-step boundary");
+            for (double scale : {lo, hi}) {
+                expect_index(predicted(scale, prefix), stepped(scale, prefix),
+                             prefix ? "tie: piecewise index must match Step loop"
+                                    : "tie: constant index must match Step loop");
+            }
+        }
+    }
+
+    // ---- Arbitrary stream
+    {
+        const size_t steps = 20000;
+        std::vector<double> rows(steps * 2);
+        for (size_t i = 0; i < steps; ++i) {
+            const double f = static_cast<double>(i);
+            rows[2 * i + 0] = 1.5 + std::sin(0.01 * f);
+            rows[2 * i + 1] = 1.5 + 0.0001 * f;
+        }
+
+        const auto want = reference(core, [&](uint64_t i) { return i < steps ? rows.data() + 2 * i : nullptr; },
+                                    dt, steps);
+        expect_true(want.has_value(), "stream reference must collapse");
+        expect_index(PredictCollapse(core, DeltaSource::Stream(rows.data(), steps, 2, 2), dt, steps), want,
+                     "stream: index must match Step loop");
+
+        rows[2 * 10 + 1] = std::numeric_limits<double>::quiet_NaN();
+        expect_index(PredictCollapse(core, DeltaSource::Stream(rows.data(), steps, 2, 2), dt, steps), std::nullopt,
+                     "stream: ERROR before collapse yields none");
+    }
+
+    // ---- Core is not mutated; terminal and invalid inputs yield none
+    {
+        expect_true(core.Lifecycle().step_counter == 0u, "core must not be mutated");
+
+        const double delta[2] = {10.0, 10.0};
+        expect_index(PredictCollapse(core, DeltaSource::Constant(delta, 3), dt, 1000), std::nullopt,
+                     "length mismatch yields none");
+        expect_index(PredictCollapse(core, DeltaSource::Constant(delta, 2), 0.0, 1000), std::nullopt,
+                     "invalid dt yields none");
+
+        const ParameterSet p{1e-3, 0.05, 0.02, 0.01, 0.002, 0.01, 0.004, 10.0};
+        const MaxCore dead = MaxCore::Create(p, 2, StructuralState{0.0, 0.0, 0.0}).value();
+        expect_index(PredictCollapse(dead, DeltaSource::Constant(delta, 2), dt, 1000), std::nullopt,
+                     "terminal core yields none");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_predict_collapse\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_predict_collapse: " << g_fail << " failures\n";
+    return 2;
+}
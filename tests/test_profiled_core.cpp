@@ -0,0 +1,193 @@
+// ==============================
+// File: tests/test_profiled_core.cpp
+// ==============================
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "maxcore/derived.h"
+#include "maxcore/maxcore.h"
+#include "maxcore/profile.h"
+#include "maxcore/profiled_core.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+static bool same_lifecycle(const maxcore::LifecycleContext& a, const maxcore::LifecycleContext& b) {
+    return a.step_counter == b.step_counter && a.terminal == b.terminal && a.collapse_emitted == b.collapse_emitted;
+}
+
+// Input of step t: regular steps with every ERROR reason mixed in and a collapse along the way.
+struct Input {
+    const double* delta;
+    size_t len;
+    double dt;
+};
+
+static Input input_at(size_t t) {
+    static const double delta[3] = {1.0, 2.0, 0.5};
+    static const double bad[3] = {0.0, std::numeric_limits<double>::quiet_NaN(), 0.0};
+    static const double huge[3] = {40.0, 0.0, 0.0};
+    switch (t % 19) {
+        case 3:  return Input{nullptr, 3, 0.01};
+        case 5:  return Input{delta, 2, 0.01};
+        case 7:  return Input{delta, 3, -1.0};
+        case 8:  return Input{delta, 3, 100.0};
+        case 9:  return Input{bad, 3, 0.01};
+        case 11: return Input{huge, 3, 0.01};
+        default: return Input{delta, 3, 0.01};
+    }
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_profiled_core\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const StructuralState init{0.0, 0.0, p.kappa_max};
+
+    expect_true(sizeof(ParameterProfile) == sizeof(void*), "a profile is one pointer");
+    expect_true(sizeof(LeanCore) <= 40u, "lean core must fit in 40 bytes");
+    expect_true(sizeof(ProfiledCore) <= 64u, "profiled core must fit in one cache line");
+    expect_true(sizeof(LeanCore) < sizeof(MaxCore) / 2u, "lean core must be under half a MaxCore");
+
+    // ---- Profile validation and precomputed max_rate
+    {
+        auto prof = ParameterProfile::Create(p, 3);
+        expect_true(prof.has_value(), "valid profile must be created");
+        if (prof) {
+            expect_true(prof->MaxRate() == 0.25 && prof->DeltaDim() == 3u && !prof->DeltaMax(),
+                        "profile must expose its configuration and max_rate");
+        }
+
+        ParameterSet q = p;
+        q.eta = 0.0;
+        expect_true(!ParameterProfile::Create(q, 3), "invalid params rejected");
+        expect_true(!ParameterProfile::Create(p, 0), "delta_dim == 0 rejected");
+        expect_true(!ParameterProfile::Create(p, 3, -1.0), "invalid delta_max rejected");
+        expect_true(!ParameterProfile::Create(p, 3, std::nullopt, static_cast<ReductionMode>(7)),
+                    "invalid reduction rejected");
+
+        if (prof) {
+            StructuralState bad = init;
+            bad.kappa = 11.0;
+            expect_true(!LeanCore::Create(*prof, bad) && !ProfiledCore::Create(*prof, bad),
+                        "initial state is validated against the profile");
+        }
+    }
+
+    // ---- Shared ownership: cores keep the profile alive
+    {
+        std::vector<LeanCore> cores;
+        {
+            auto prof = ParameterProfile::Create(p, 3);
+            if (!prof) return 2;
+            for (size_t i = 0; i < 100; ++i) cores.push_back(LeanCore::Create(*prof, init).value());
+            expect_true(prof->UseCount() == 101u, "every core holds one reference");
+
+            ParameterProfile copy = *prof;
+            ParameterProfile moved = std::move(copy);
+            expect_true(prof->UseCount() == 103u && moved == *prof, "copies share one block");
+            expect_true(copy == *prof && copy.DeltaDim() == 3u && same_bits(copy.Params().kappa_max, p.kappa_max),
+                        "a moved-from profile stays usable");
+
+            auto other = ParameterProfile::Create(p, 2);
+            if (!other) return 2;
+            moved = std::move(*other);
+            expect_true(moved.DeltaDim() == 2u && *other == *prof && prof->UseCount() == 103u,
+                        "move-assignment swaps the references");
+        }
+        expect_true(cores.front().Profile().UseCount() == 100u, "profile outlives its last named copy");
+        expect_true(cores.front().Profile() == cores.back().Profile(), "cores share the profile");
+
+        const double delta[3] = {1.0, 2.0, 0.5};
+        expect_true(cores.back().Step(delta, 3, 0.01) == EventFlag::NORMAL, "core steps after the profile went out of scope");
+        cores.erase(cores.begin() + 1, cores.end());
+        expect_true(cores.front().Profile().UseCount() == 1u, "destroyed cores release their reference");
+    }
+
+    // ---- Bitwise parity with MaxCore (both variants, both reductions, with and without guard)
+    const std::optional<double> guards[2] = {std::nullopt, 5.0};
+    for (const std::optional<double>& dm : guards) {
+        for (ReductionMode mode : {ReductionMode::SERIAL, ReductionMode::LANES4}) {
+            auto prof = ParameterProfile::Create(p, 3, dm, mode);
+            if (!prof) return 2;
+
+            MaxCore ref = MaxCore::Create(p, 3, init, dm, mode).value();
+            ProfiledCore full = ProfiledCore::Create(*prof, init).value();
+            LeanCore lean = LeanCore::Create(*prof, init).value();
+
+            bool ok = true;
+            bool derived_ok = true;
+            size_t collapses = 0;
+            size_t errors = 0;
+            size_t geneses = 0;
+            for (size_t t = 0; t < 600; ++t) {
+                const Input in = input_at(t);
+                StepStatus sr = StepStatus::OK;
+                StepStatus sf = StepStatus::OK;
+                StepStatus sl = StepStatus::OK;
+                const EventFlag er = ref.Step(in.delta, in.len, in.dt, sr);
+                const EventFlag ef = full.Step(in.delta, in.len, in.dt, sf);
+                const EventFlag el = lean.Step(in.delta, in.len, in.dt, sl);
+
+                ok = ok && er == ef && er == el && sr == sf && sr == sl;
+                ok = ok && same_state(ref.Current(), full.Current()) && same_state(ref.Current(), lean.Current());
+                ok = ok && same_state(ref.Previous(), full.Previous());
+                ok = ok && same_lifecycle(ref.Lifecycle(), full.Lifecycle()) &&
+                     same_lifecycle(ref.Lifecycle(), lean.Lifecycle());
+
+                const auto dr = ComputeDerived(ref.Current(), ref.Previous(), ref.Lifecycle(), p, in.dt);
+                const auto df = ComputeDerived(full.Current(), full.Previous(), full.Lifecycle(),
+                                               full.Profile().Params(), in.dt);
+                derived_ok = derived_ok && dr.has_value() == df.has_value() &&
+                             (!dr || (same_bits(dr->kappa_rate, df->kappa_rate) && same_bits(dr->load_term, df->load_term)));
+
+                collapses += (er == EventFlag::COLLAPSE) ? 1u : 0u;
+                errors += (er == EventFlag::ERROR) ? 1u : 0u;
+
+                // Restart a few steps into the terminal state
+                if (ref.Lifecycle().terminal && (t % 19) == 0) {
+                    const StructuralState again{1.0, 2.0, 9.0};
+                    ok = ok && ref.Genesis(again) && full.Genesis(again) && lean.Genesis(again);
+                    geneses += 1u;
+                }
+            }
+            expect_true(collapses > 1u && errors > 0u && geneses > 0u,
+                        "run must cover ERROR, COLLAPSE, terminal and Genesis");
+            expect_true(ok, "profiled cores must match MaxCore bitwise (events, status, state, lifecycle)");
+            expect_true(derived_ok, "ComputeDerived on a profiled core must match MaxCore");
+            expect_true(!lean.Genesis(StructuralState{-1.0, 0.0, 1.0}), "invalid Genesis state rejected");
+        }
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_profiled_core\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_profiled_core: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,171 @@
+// ==============================
+// File: tests/test_reduction_lanes.cpp
+// ==============================
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "maxcore/maxcore.h"
+#include "maxcore/reduction.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(ua));
+    std::memcpy(&ub, &b, sizeof(ub));
+    return ua == ub;
+}
+
+// Deterministic pseudo-random values spanning several magnitudes (sign included).
+static std::vector<double> make_values(size_t n, uint64_t seed) {
+    std::vector<double> v(n);
+    uint64_t x = seed;
+    for (size_t i = 0; i < n; ++i) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        const double u = static_cast<double>(x >> 11) * (1.0 / 9007199254740992.0);
+        const double scale = std::ldexp(1.0, static_cast<int>((x >> 3) % 40u) - 20);
+        v[i] = (u - 0.5) * scale;
+    }
+    return v;
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_reduction_lanes\n";
+
+    const ReductionIsa isas[] = {ReductionIsa::SCALAR, ReductionIsa::SSE2, ReductionIsa::AVX2};
+
+    std::cout << "best isa=" << static_cast<int>(BestReductionIsa()) << "\n";
+    expect_true(ReductionIsaSupported(ReductionIsa::SCALAR), "SCALAR must always be supported");
+    expect_true(ReductionIsaSupported(BestReductionIsa()), "best ISA must be supported");
+
+    // ---- Reference implements the documented order
+    {
+        const double v[7] = {1.5, -2.25, 3.0, 0.1, 7.0, -0.3, 1e-3};
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        s0 += v[0] * v[0]; s0 += v[4] * v[4];
+        s1 += v[1] * v[1]; s1 += v[5] * v[5];
+        s2 += v[2] * v[2]; s2 += v[6] * v[6];
+        s3 += v[3] * v[3];
+        const double expected = (s0 + s1) + (s2 + s3);
+        expect_true(same_bits(Norm2Lanes4Reference(v, 7), expected), "reference must follow the lane spec");
+        expect_true(same_bits(Norm2Lanes4Reference(v, 0), 0.0), "empty input must yield +0.0");
+    }
+
+    // ---- Every ISA matches the reference bit for bit
+    {
+        const size_t sizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 64, 255, 256, 257, 1000, 4096, 4099};
+        for (size_t n : sizes) {
+            for (uint64_t seed = 1; seed <= 8; ++seed) {
+                const std::vector<double> v = make_values(n, seed * 7919u + n);
+                const double ref = Norm2Lanes4Reference(v.data(), n);
+
+                for (ReductionIsa isa : isas) {
+                    const double got = Norm2Lanes4(v.data(), n, isa);
+                    if (!same_bits(got, ref)) {
+                        std::cout << "[DIFF] n=" << n << " seed=" << seed << " isa=" << static_cast<int>(isa) << "\n";
+                        expect_true(false, "ISA kernel must match reference bitwise");
+                    }
+                }
+                expect_true(same_bits(Norm2Lanes4(v.data(), n), ref), "default dispatch must match reference");
+            }
+        }
+    }
+
+    // ---- Unaligned input
+    {
+        std::vector<double> v = make_values(1025, 99u);
+        const double ref = Norm2Lanes4Reference(v.data() + 1, 1023);
+        for (ReductionIsa isa : isas) {
+            expect_true(same_bits(Norm2Lanes4(v.data() + 1, 1023, isa), ref), "unaligned input must match reference");
+        }
+    }
+
+    // ---- Non-finite components propagate to a non-finite result on every ISA
+    {
+        std::vector<double> v = make_values(300, 5u);
+        v[133] = std::numeric_limits<double>::quiet_NaN();
+        std::vector<double> w = make_values(300, 6u);
+        w[299] = -std::numeric_limits<double>::infinity();
+        for (ReductionIsa isa : isas) {
+            expect_true(!std::isfinite(Norm2Lanes4(v.data(), v.size(), isa)), "NaN must propagate");
+            expect_true(!std::isfinite(Norm2Lanes4(w.data(), w.size(), isa)), "-Inf must propagate");
+        }
+    }
+
+    // ---- Engine integration
+    {
+        ParameterSet p{
+            1e-4,   // alpha
+            0.1,    // eta
+            0.5,    // beta
+            0.1,    // gamma
+            0.05,   // rho
+            0.25,   // lambda_phi
+            0.25,   // lambda_m
+            10.0    // kappa_max
+        };
+        const StructuralState init{0.0, 0.0, p.kappa_max};
+        const double dt = 0.01;
+
+        // dim <= 2: LANES4 and SERIAL coincide bitwise
+        {
+            MaxCore a = MaxCore::Create(p, 2, init, std::nullopt, ReductionMode::SERIAL).value();
+            MaxCore b = MaxCore::Create(p, 2, init, std::nullopt, ReductionMode::LANES4).value();
+            const double delta[2] = {0.7, -1.3};
+            bool same = true;
+            for (int t = 0; t < 100; ++t) {
+                same = same && (a.Step(delta, 2, dt) == b.Step(delta, 2, dt));
+                same = same && same_bits(a.Current().kappa, b.Current().kappa) &&
+                       same_bits(a.Current().phi, b.Current().phi);
+            }
+            expect_true(same, "LANES4 must equal SERIAL for dim 2");
+        }
+
+        // wide delta: LANES4 step uses exactly the documented reduction
+        {
+            const size_t dim = 1024;
+            std::vector<double> delta = make_values(dim, 42u);
+            for (double& v : delta) v *= 1e-6;
+
+            MaxCore lanes = MaxCore::Create(p, dim, init, std::nullopt, ReductionMode::LANES4).value();
+            const EventFlag ev = lanes.Step(delta.data(), dim, dt);
+            expect_true(ev == EventFlag::NORMAL, "LANES4 step must succeed");
+
+            const double norm2 = Norm2Lanes4Reference(delta.data(), dim);
+            const double phi_expected = init.phi + (p.alpha * norm2) - (p.eta * init.phi * dt);
+            expect_true(same_bits(lanes.Current().phi, phi_expected), "LANES4 phi must use the lane-order norm2");
+
+            std::vector<double> bad = delta;
+            bad[500] = std::numeric_limits<double>::quiet_NaN();
+            const uint64_t sc = lanes.Lifecycle().step_counter;
+            expect_true(lanes.Step(bad.data(), dim, dt) == EventFlag::ERROR, "LANES4: NaN component must yield ERROR");
+            expect_true(lanes.Lifecycle().step_counter == sc, "LANES4: ERROR must not mutate");
+        }
+
+        expect_true(!MaxCore::Create(p, 2, init, std::nullopt, static_cast<ReductionMode>(7)).has_value(),
+                    "Create must reject an unknown reduction mode");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_reduction_lanes\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_reduction_lanes: " << g_fail << " failures\n";
+    return 2;
+}
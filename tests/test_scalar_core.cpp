@@ -0,0 +1,202 @@
+// ==============================
+// File: tests/test_scalar_core.cpp
+// ==============================
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "maxcore/batch.h"
+#include "maxcore/maxcore.h"
+#include "maxcore/scalar_core.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_bits(float a, float b) {
+    uint32_t ua = 0;
+    uint32_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(float));
+    std::memcpy(&ub, &b, sizeof(float));
+    return ua == ub;
+}
+
+template <typename S>
+static bool same_state(const maxcore::BasicStructuralState<S>& a, const maxcore::BasicStructuralState<S>& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+static bool same_lifecycle(const maxcore::LifecycleContext& a, const maxcore::LifecycleContext& b) {
+    return a.step_counter == b.step_counter && a.terminal == b.terminal && a.collapse_emitted == b.collapse_emitted;
+}
+
+// Input of step t in precision S: regular steps, every ERROR reason and a collapse along the way.
+template <typename S>
+struct Input {
+    const S* delta;
+    size_t len;
+    S dt;
+};
+
+template <typename S>
+static Input<S> input_at(size_t t) {
+    static const S delta[2] = {S(1), S(2)};
+    static const S bad[2] = {S(1), std::numeric_limits<S>::quiet_NaN()};
+    static const S huge[2] = {S(40), S(0)};
+    switch (t % 17) {
+        case 3:  return Input<S>{nullptr, 2, S(0.01)};
+        case 5:  return Input<S>{delta, 1, S(0.01)};
+        case 7:  return Input<S>{delta, 2, S(0)};
+        case 8:  return Input<S>{delta, 2, S(100)};
+        case 9:  return Input<S>{bad, 2, S(0.01)};
+        case 11: return Input<S>{huge, 2, S(0.01)};
+        default: return Input<S>{delta, 2, S(0.01)};
+    }
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_scalar_core\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const StructuralState init{0.0, 0.0, p.kappa_max};
+    const size_t steps = 500;
+
+    // ---- MaxCoreT<double> == MaxCore (SERIAL) bitwise, with and without guard
+    const std::optional<double> guards[2] = {std::nullopt, 5.0};
+    for (const std::optional<double>& dm : guards) {
+        MaxCore ref = MaxCore::Create(p, 2, init, dm).value();
+        MaxCoreT<double> core = MaxCoreT<double>::Create(p, 2, init, dm).value();
+
+        bool ok = true;
+        size_t collapses = 0;
+        size_t errors = 0;
+        for (size_t t = 0; t < steps; ++t) {
+            const Input<double> in = input_at<double>(t);
+            StepStatus sr = StepStatus::OK;
+            StepStatus sc = StepStatus::OK;
+            const EventFlag er = ref.Step(in.delta, in.len, in.dt, sr);
+            const EventFlag ec = core.Step(in.delta, in.len, in.dt, sc);
+            ok = ok && er == ec && sr == sc && same_state(ref.Current(), core.Current()) &&
+                 same_state(ref.Previous(), core.Previous()) && same_lifecycle(ref.Lifecycle(), core.Lifecycle());
+            collapses += (er == EventFlag::COLLAPSE) ? 1u : 0u;
+            errors += (er == EventFlag::ERROR) ? 1u : 0u;
+
+            if (ref.Lifecycle().terminal && t % 17 == 0) {
+                const StructuralState again{1.0, 2.0, 9.5};
+                ok = ok && ref.Genesis(again) && core.Genesis(again);
+            }
+        }
+        expect_true(collapses > 1u && errors > 0u, "run must cover ERROR, COLLAPSE, terminal and Genesis");
+        expect_true(ok, "MaxCoreT<double> must match MaxCore bitwise");
+    }
+
+    // ---- MaxCoreT<float>: same semantics, single-precision values close to double
+    {
+        const auto pf = ParamsAs<float>(p);
+        MaxCoreT<float> f = MaxCoreT<float>::Create(pf, 2, StateAs<float>(init)).value();
+        MaxCoreT<double> d = MaxCoreT<double>::Create(p, 2, init).value();
+
+        const float df[2] = {1.0f, 2.0f};
+        const double dd[2] = {1.0, 2.0};
+        bool clamps_ok = true;
+        bool close_ok = true;
+        size_t collapses = 0;
+        for (size_t t = 0; t < 400; ++t) {
+            const EventFlag ef = f.Step(df, 2, 0.01f);
+            const EventFlag ed = d.Step(dd, 2, 0.01);
+            collapses += (ef == EventFlag::COLLAPSE) ? 1u : 0u;
+            const auto& s = f.Current();
+            clamps_ok = clamps_ok && s.phi >= 0.0f && s.memory >= 0.0f && s.kappa >= 0.0f && s.kappa <= pf.kappa_max;
+            if (ed == EventFlag::NORMAL && !d.Lifecycle().terminal && !f.Lifecycle().terminal) {
+                close_ok = close_ok && std::fabs(double(s.phi) - d.Current().phi) <= 1e-4 * (1.0 + d.Current().phi) &&
+                           std::fabs(double(s.kappa) - d.Current().kappa) <= 1e-3;
+            }
+        }
+        expect_true(clamps_ok, "float clamps must hold");
+        expect_true(collapses == 1u && f.Lifecycle().terminal && f.Lifecycle().collapse_emitted,
+                    "float collapse must be emitted exactly once");
+        StepStatus st = StepStatus::OK;
+        expect_true(f.Step(df, 2, 0.01f, st) == EventFlag::NORMAL && st == StepStatus::TERMINAL,
+                    "terminal float core short-circuits");
+        expect_true(close_ok, "float trajectory must stay close to double before collapse");
+
+        // Validation runs on the float values
+        ParameterSet tiny = p;
+        tiny.eta = 1e-50;  // positive in double, 0 in float
+        expect_true(MaxCoreT<double>::Create(tiny, 2, init).has_value(), "tiny eta is valid in double");
+        expect_true(!MaxCoreT<float>::Create(ParamsAs<float>(tiny), 2, StateAs<float>(init)),
+                    "eta that underflows in float must be rejected");
+        ParameterSet big = p;
+        big.kappa_max = 1e300;  // inf in float
+        expect_true(!MaxCoreT<float>::Create(ParamsAs<float>(big), 2, BasicStructuralState<float>{0.0f, 0.0f, 1.0f}),
+                    "kappa_max that overflows in float must be rejected");
+        expect_true(!MaxCoreT<float>::Create(pf, 0, StateAs<float>(init)), "delta_dim == 0 rejected");
+        expect_true(!MaxCoreT<float>::Create(pf, 2, StateAs<float>(init), -1.0f), "invalid delta_max rejected");
+    }
+
+    // ---- MaxCoreBatchT<float> lanes == MaxCoreT<float> bitwise
+    {
+        const size_t lanes = 9;
+        const auto pf = ParamsAs<float>(p);
+        std::vector<BasicStructuralState<float>> inits(lanes);
+        std::vector<MaxCoreT<float>> cores;
+        for (size_t i = 0; i < lanes; ++i) {
+            inits[i] = BasicStructuralState<float>{0.0f, 0.0f, 2.0f + float(i)};
+            cores.push_back(MaxCoreT<float>::Create(pf, 2, inits[i], 6.0f).value());
+        }
+        auto batch = MaxCoreBatchT<float>::Create(pf, 2, inits.data(), lanes, 6.0f);
+        expect_true(batch.has_value(), "float batch Create must succeed");
+        if (!batch) return 2;
+
+        std::vector<float> deltas(lanes * 2);
+        bool ok = true;
+        size_t collapses = 0;
+        for (size_t t = 0; t < 300; ++t) {
+            for (size_t i = 0; i < lanes; ++i) {
+                // every third lane idles (never collapses), the others are driven
+                const bool idle = (i % 3 == 0);
+                deltas[i * 2 + 0] = idle ? 0.0f : 1.0f + 0.01f * float(t % 7);
+                deltas[i * 2 + 1] = ((t + i) % 29 == 0) ? std::numeric_limits<float>::infinity() : (idle ? 0.0f : 2.0f);
+            }
+            const float dt = (t % 31 == 0) ? -1.0f : 0.01f;
+            const std::vector<EventFlag>& ev = batch->StepAll(deltas.data(), dt);
+            for (size_t i = 0; i < lanes; ++i) {
+                const EventFlag e = cores[i].Step(deltas.data() + i * 2, 2, dt);
+                ok = ok && e == ev[i] && same_state(cores[i].Current(), batch->Current(i)) &&
+                     same_state(cores[i].Previous(), batch->Previous(i)) &&
+                     same_lifecycle(cores[i].Lifecycle(), batch->Lifecycle(i));
+                collapses += (e == EventFlag::COLLAPSE) ? 1u : 0u;
+            }
+        }
+        expect_true(collapses > 0u && collapses < lanes, "float batch run must collapse part of the lanes");
+        expect_true(ok, "MaxCoreBatchT<float> must match MaxCoreT<float> bitwise");
+        expect_true(sizeof(*batch->Phi()) == sizeof(float), "float batch columns are single precision");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_scalar_core\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_scalar_core: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,348 @@
+// ==============================
+// File: tests/test_snapshot.cpp
+// ==============================
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "maxcore/batch.h"
+#include "maxcore/ensemble.h"
+#include "maxcore/maxcore.h"
+#include "maxcore/snapshot.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+static bool same_core(const maxcore::MaxCore& a, const maxcore::MaxCore& b) {
+    return same_state(a.Current(), b.Current()) &&
+           same_state(a.Previous(), b.Previous()) &&
+           a.DeltaDim() == b.DeltaDim() &&
+           a.Lifecycle().step_counter == b.Lifecycle().step_counter &&
+           a.Lifecycle().terminal == b.Lifecycle().terminal &&
+           a.Lifecycle().collapse_emitted == b.Lifecycle().collapse_emitted;
+}
+
+static void fill_row(double* row, size_t dim, size_t t, size_t salt) {
+    for (size_t d = 0; d < dim; ++d) {
+        row[d] = 0.5 + 0.45 * std::sin(0.11 * static_cast<double>(t) + 0.7 * static_cast<double>(d + salt));
+    }
+}
+
+// Steps both cores with identical inputs; true if their futures are bit-identical.
+static bool same_future(maxcore::MaxCore a, maxcore::MaxCore b, size_t steps, size_t salt) {
+    std::vector<double> row(a.DeltaDim());
+    for (size_t t = 0; t < steps; ++t) {
+        fill_row(row.data(), row.size(), t, salt);
+        const maxcore::EventFlag ea = a.Step(row.data(), row.size(), 0.5);
+        const maxcore::EventFlag eb = b.Step(row.data(), row.size(), 0.5);
+        if (ea != eb || !same_core(a, b)) return false;
+    }
+    return true;
+}
+
+// Overwrites payload word `word` of a snapshot and recomputes the header
+// checksum (word-wise FNV-1a plus avalanche, as written by snapshot.cpp), so the
+// buffer passes every structural check and only the semantic ones can reject it.
+template <class T>
+static std::vector<uint8_t> forge(std::vector<uint8_t> buf, size_t word, T value) {
+    using namespace maxcore;
+    std::memcpy(buf.data() + kSnapshotHeaderBytes + word * 8u, &value, 8u);
+
+    const size_t payload = buf.size() - kSnapshotHeaderBytes;
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t off = 0; off < payload; off += 8u) {
+        uint64_t w = 0;
+        std::memcpy(&w, buf.data() + kSnapshotHeaderBytes + off, 8u);
+        h ^= w;
+        h *= 0x100000001b3ull;
+    }
+    h ^= static_cast<uint64_t>(payload);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    std::memcpy(buf.data() + 6u * 8u, &h, 8u);
+    return buf;
+}
+
+static std::vector<maxcore::MaxCore> make_cores(size_t n) {
+    using namespace maxcore;
+
+    std::vector<MaxCore> cores;
+    for (size_t i = 0; i < n; ++i) {
+        const ParameterSet p{0.1, 0.2, 0.1, 0.1, 0.02 + 0.01 * static_cast<double>(i % 5),
+                             0.05 + 0.03 * static_cast<double>(i % 3), 0.05, 1.0};
+        const std::optional<double> dm = (i % 2 == 0) ? std::optional<double>(0.8) : std::nullopt;
+        const ReductionMode red = (i % 3 == 0) ? ReductionMode::LANES4 : ReductionMode::SERIAL;
+        const size_t dim = 2 + (i % 6);
+        MaxCore c = MaxCore::Create(p, dim, StructuralState{0.0, 0.0, 1.0}, dm, red).value();
+
+        // Advance each core a different distance (some collapse)
+        std::vector<double> row(dim);
+        for (size_t t = 0; t < 20 + 13 * i; ++t) {
+            fill_row(row.data(), dim, t, i);
+            c.Step(row.data(), dim, 0.5);
+        }
+        cores.push_back(c);
+    }
+    return cores;
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_snapshot\n";
+
+    const std::vector<MaxCore> cores = make_cores(24);
+    size_t terminal = 0;
+    for (const MaxCore& c : cores) terminal += c.Lifecycle().terminal ? 1u : 0u;
+    std::cout << "cores=" << cores.size() << " terminal=" << terminal << "\n";
+    expect_true(terminal > 0 && terminal < cores.size(), "fixture must mix live and collapsed cores");
+
+    // ---- Single core round trip
+    {
+        const std::vector<uint8_t> buf = Snapshot(cores[3]);
+        expect_true(buf.size() == SnapshotSize(1), "single snapshot size");
+        const std::optional<MaxCore> back = Restore(buf.data(), buf.size());
+        expect_true(back.has_value() && same_core(*back, cores[3]), "Restore must reproduce the core");
+        if (back) expect_true(same_future(*back, cores[3], 300, 3), "restored core must have a bit-identical future");
+    }
+
+    // ---- Bulk round trip, unaligned destination
+    {
+        const std::vector<uint8_t> buf = SnapshotBulk(cores.data(), cores.size());
+        expect_true(buf.size() == SnapshotSize(cores.size()), "bulk snapshot size (all configurations distinct)");
+
+        std::vector<uint8_t> shifted(buf.size() + 3);
+        std::memcpy(shifted.data() + 3, buf.data(), buf.size());
+
+        const auto back = RestoreBulk(shifted.data() + 3, buf.size());
+        expect_true(back.has_value() && back->size() == cores.size(), "RestoreBulk must restore every core");
+        if (back) {
+            bool ok = true;
+            for (size_t i = 0; i < cores.size(); ++i) {
+                ok = ok && same_core((*back)[i], cores[i]) && same_future((*back)[i], cores[i], 200, i);
+            }
+            expect_true(ok, "bulk-restored cores must have bit-identical futures");
+        }
+
+        expect_true(!Restore(buf.data(), buf.size()), "Restore must reject a multi-core snapshot");
+
+        std::vector<uint8_t> small(SnapshotSize(cores.size()) - 1);
+        expect_true(WriteSnapshot(cores.data(), cores.size(), small.data(), small.size()) == 0u,
+                    "WriteSnapshot must reject a short buffer");
+    }
+
+    // ---- Shared configurations are stored once
+    {
+        std::vector<MaxCore> shared;
+        for (size_t i = 0; i < 40; ++i) shared.push_back(cores[i % 2 == 0 ? 4 : 7]);
+        const std::vector<uint8_t> buf = SnapshotBulk(shared.data(), shared.size());
+
+        uint64_t configs = 0;
+        std::memcpy(&configs, buf.data() + 7u * 8u, 8u);
+        expect_true(configs == 2u, "two distinct configurations must give two entries");
+        expect_true(buf.size() == kSnapshotHeaderBytes + (2u * kSnapshotConfigWords + 40u * kSnapshotCoreWords) * 8u,
+                    "shared snapshot size");
+        expect_true(buf.size() < SnapshotSize(shared.size()), "SnapshotSize is an upper bound");
+
+        const auto back = RestoreBulk(buf.data(), buf.size());
+        bool ok = back.has_value() && back->size() == shared.size();
+        for (size_t i = 0; ok && i < shared.size(); ++i) ok = same_core((*back)[i], shared[i]);
+        expect_true(ok, "cores sharing a configuration must restore exactly");
+    }
+
+    // ---- Corruption, truncation, foreign byte order, version, kind
+    {
+        const std::vector<uint8_t> good = SnapshotBulk(cores.data(), 4);
+
+        std::vector<uint8_t> bad = good;
+        bad[kSnapshotHeaderBytes + 100] ^= 0x01u;
+        expect_true(!RestoreBulk(bad.data(), bad.size()), "payload bit flip must be rejected");
+
+        expect_true(!RestoreBulk(good.data(), good.size() - 8), "truncated snapshot must be rejected");
+        expect_true(!RestoreBulk(good.data(), 10), "short buffer must be rejected");
+        expect_true(!RestoreBulk(nullptr, good.size()), "null buffer must be rejected");
+
+        bad = good;
+        bad[0] = 'X';
+        expect_true(!RestoreBulk(bad.data(), bad.size()), "bad magic must be rejected");
+
+        bad = good;
+        for (size_t i = 0; i < 4; ++i) std::swap(bad[8 + i], bad[15 - i]);
+        expect_true(!RestoreBulk(bad.data(), bad.size()), "foreign byte order must be rejected");
+
+        bad = good;
+        bad[16] = static_cast<uint8_t>(bad[16] + 1u);
+        expect_true(!RestoreBulk(bad.data(), bad.size()), "unknown version must be rejected");
+
+        expect_true(!RestoreBatch(good.data(), good.size()), "CORES snapshot must not restore as BATCH");
+    }
+
+    // ---- Intact buffers describing an invalid engine
+    {
+        // Cores 0-3 have distinct configurations: table entries 0-3, then the records.
+        const std::vector<uint8_t> good = SnapshotBulk(cores.data(), 4);
+        const size_t cfg = kSnapshotConfigWords;
+        const size_t rec = kSnapshotCoreWords;
+        const size_t body = 4u * cfg;
+        expect_true(good.size() == kSnapshotHeaderBytes + (body + 4u * rec) * 8u,
+                    "fixture: four configuration entries");
+        expect_true(RestoreBulk(forge(good, 0, 0.1).data(), good.size()).has_value(),
+                    "forge must keep a valid buffer restorable");
+
+        const double nan = std::nan("");
+        expect_true(!RestoreBulk(forge(good, cfg + 1u, -0.2).data(), good.size()),
+                    "non-positive parameter must be rejected");
+        expect_true(!RestoreBulk(forge(good, 3u * cfg + 7u, nan).data(), good.size()),
+                    "non-finite kappa_max must be rejected");
+        expect_true(!Restore(forge(Snapshot(cores[0]), 8, uint64_t{0}).data(), Snapshot(cores[0]).size()),
+                    "zero delta_dim must be rejected");
+        expect_true(!RestoreBulk(forge(forge(good, 2u * cfg + 9u, uint64_t{1}), 2u * cfg + 10u, -1.0).data(),
+                                 good.size()),
+                    "non-positive delta_max must be rejected");
+        expect_true(!RestoreBulk(forge(good, cfg + 9u, uint64_t{2}).data(), good.size()),
+                    "unknown has_delta_max flag must be rejected");
+        expect_true(!RestoreBulk(forge(good, 11, uint64_t{7}).data(), good.size()),
+                    "unknown reduction mode must be rejected");
+        expect_true(!RestoreBulk(forge(good, body + rec, uint64_t{4}).data(), good.size()),
+                    "configuration index out of range must be rejected");
+
+        std::vector<uint8_t> bad = good;
+        const uint64_t configs = 3;
+        std::memcpy(bad.data() + 7u * 8u, &configs, 8u);
+        expect_true(!RestoreBulk(bad.data(), bad.size()), "configuration count must match the payload");
+
+        // Per-entity state
+        expect_true(!RestoreBulk(forge(good, body + rec + 1u, nan).data(), good.size()),
+                    "non-finite phi must be rejected");
+        expect_true(!RestoreBulk(forge(good, body + 3u, 1e9).data(), good.size()),
+                    "kappa above kappa_max must be rejected");
+        expect_true(!RestoreBulk(forge(good, body + 2u * rec + 5u, -1.0).data(), good.size()),
+                    "negative previous memory must be rejected");
+
+        size_t live = 4;
+        size_t dead = 4;
+        for (size_t i = 0; i < 4; ++i) (cores[i].Lifecycle().terminal ? dead : live) = i;
+        expect_true(live < 4u, "fixture: a live core among the first four");
+        if (live < 4u) {
+            const size_t flags = body + live * rec + 8u;
+            expect_true(!RestoreBulk(forge(good, flags, uint64_t{1}).data(), good.size()),
+                        "terminal flag on a live core must be rejected");
+            expect_true(!RestoreBulk(forge(good, flags, uint64_t{2}).data(), good.size()),
+                        "collapse_emitted without terminal must be rejected");
+            expect_true(!RestoreBulk(forge(good, flags, uint64_t{4}).data(), good.size()),
+                        "unknown flag bits must be rejected");
+            expect_true(!RestoreBulk(forge(good, body + live * rec + 3u, 0.0).data(), good.size()),
+                        "Kappa == 0 without the terminal flag must be rejected");
+        }
+        if (dead < 4u) {
+            expect_true(!RestoreBulk(forge(good, body + dead * rec + 8u, uint64_t{0}).data(), good.size()),
+                        "terminal core without the terminal flag must be rejected");
+        }
+
+        const ParameterSet p{0.1, 0.2, 0.1, 0.1, 0.05, 0.1, 0.05, 1.0};
+        const std::vector<StructuralState> inits(5, StructuralState{0.0, 0.0, 1.0});
+        const std::vector<uint8_t> bgood =
+            SnapshotBatch(MaxCoreBatch::Create(p, 3, inits.data(), inits.size(), std::nullopt).value());
+        const size_t lanes = inits.size();
+        expect_true(RestoreBatch(bgood.data(), bgood.size()).has_value(), "batch fixture must restore");
+        expect_true(!RestoreBatch(forge(bgood, 4, 0.0).data(), bgood.size()), "batch: zero parameter must be rejected");
+        expect_true(!RestoreBatch(forge(bgood, 8, uint64_t{0}).data(), bgood.size()),
+                    "batch: zero delta_dim must be rejected");
+        expect_true(!RestoreBatch(forge(bgood, 11, uint64_t{1}).data(), bgood.size()),
+                    "batch: non-SERIAL reduction must be rejected");
+        expect_true(!RestoreBatch(forge(bgood, cfg + 2u, -1.0).data(), bgood.size()),
+                    "batch: negative phi must be rejected");
+        expect_true(!RestoreBatch(forge(bgood, cfg + 2u * lanes, 0.0).data(), bgood.size()),
+                    "batch: Kappa == 0 without the terminal flag must be rejected");
+        expect_true(!RestoreBatch(forge(bgood, cfg + 7u * lanes + 1u, uint64_t{1}).data(), bgood.size()),
+                    "batch: terminal flag on a live lane must be rejected");
+        expect_true(!RestoreBatch(forge(bgood, cfg + 8u * lanes + 1u, uint64_t{2}).data(), bgood.size()),
+                    "batch: flag values other than 0 / 1 must be rejected");
+    }
+
+    // ---- Batch round trip
+    {
+        const ParameterSet p{0.1, 0.2, 0.1, 0.1, 0.05, 0.1, 0.05, 1.0};
+        std::vector<StructuralState> inits(37, StructuralState{0.0, 0.0, 1.0});
+        inits[5] = StructuralState{0.0, 0.0, 0.0};
+        MaxCoreBatch batch = MaxCoreBatch::Create(p, 3, inits.data(), inits.size(), 0.9).value();
+
+        std::vector<double> deltas(inits.size() * 3);
+        auto step = [&](MaxCoreBatch& b, size_t t) {
+            for (size_t i = 0; i < inits.size(); ++i) fill_row(deltas.data() + i * 3, 3, t, i);
+            b.StepAll(deltas.data(), 0.5);
+        };
+        for (size_t t = 0; t < 40; ++t) step(batch, t);
+
+        const std::vector<uint8_t> buf = SnapshotBatch(batch);
+        expect_true(buf.size() == BatchSnapshotSize(batch.Lanes()), "batch snapshot size");
+        expect_true(!RestoreBulk(buf.data(), buf.size()), "BATCH snapshot must not restore as CORES");
+
+        std::optional<MaxCoreBatch> back = RestoreBatch(buf.data(), buf.size());
+        expect_true(back.has_value() && back->Lanes() == batch.Lanes(), "RestoreBatch must restore every lane");
+        if (back) {
+            bool ok = true;
+            for (size_t t = 40; t < 400; ++t) {
+                step(batch, t);
+                step(*back, t);
+                for (size_t i = 0; i < batch.Lanes(); ++i) {
+                    ok = ok && back->Events()[i] == batch.Events()[i] &&
+                         same_state(back->Current(i), batch.Current(i)) &&
+                         same_state(back->Previous(i), batch.Previous(i)) &&
+                         back->Lifecycle(i).step_counter == batch.Lifecycle(i).step_counter &&
+                         back->Lifecycle(i).terminal == batch.Lifecycle(i).terminal &&
+                         back->Lifecycle(i).collapse_emitted == batch.Lifecycle(i).collapse_emitted;
+                }
+            }
+            expect_true(ok, "restored batch must have a bit-identical future");
+        }
+    }
+
+    // ---- Ensemble round trip
+    {
+        auto runner = EnsembleRunner::Create(cores, 3);
+        if (runner) {
+            const std::vector<uint8_t> buf = SnapshotEnsemble(*runner);
+            expect_true(buf == SnapshotBulk(cores.data(), cores.size()), "ensemble snapshot must equal bulk snapshot");
+
+            auto back = RestoreEnsemble(buf.data(), buf.size(), 2);
+            expect_true(back.has_value() && back->Size() == cores.size(), "RestoreEnsemble must restore every entity");
+            if (back) {
+                bool ok = true;
+                for (size_t i = 0; i < cores.size(); ++i) ok = ok && same_core(back->Core(i), cores[i]);
+                expect_true(ok, "restored ensemble must hold the snapshotted cores");
+            }
+        }
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_snapshot\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_snapshot: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,181 @@
+// ==============================
+// File: tests/test_step_sequence.cpp
+// ==============================
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "maxcore/maxcore.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(ua));
+    std::memcpy(&ub, &b, sizeof(ub));
+    return ua == ub;
+}
+
+static void expect_same_core(const maxcore::MaxCore& a, const maxcore::MaxCore& b, const char* msg) {
+    const bool cur = same_bits(a.Current().phi, b.Current().phi) &&
+                     same_bits(a.Current().memory, b.Current().memory) &&
+                     same_bits(a.Current().kappa, b.Current().kappa);
+    const bool prev = same_bits(a.Previous().phi, b.Previous().phi) &&
+                      same_bits(a.Previous().memory, b.Previous().memory) &&
+                      same_bits(a.Previous().kappa, b.Previous().kappa);
+    const bool lc = a.Lifecycle().step_counter == b.Lifecycle().step_counter &&
+                    a.Lifecycle().terminal == b.Lifecycle().terminal &&
+                    a.Lifecycle().collapse_emitted == b.Lifecycle().collapse_emitted;
+    expect_true(cur && prev && lc, msg);
+}
+
+static maxcore::MaxCore make_core() {
+    using namespace maxcore;
+
+    ParameterSet p{
+        1.0,    // alpha
+        0.1,    // eta
+        0.5,    // beta
+        0.1,    // gamma
+        0.05,   // rho
+        0.25,   // lambda_phi
+        0.25,   // lambda_m
+        10.0    // kappa_max
+    };
+
+    StructuralState init{0.0, 0.0, p.kappa_max};
+    return MaxCore::Create(p, 2, init).value();
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_step_sequence\n";
+
+    const size_t steps = 400;
+    const size_t stride = 3; // padded rows: 2 used values + 1 ignored
+    const double dt = 0.01;
+
+    std::vector<double> block(steps * stride);
+    std::vector<double> dts(steps);
+    for (size_t i = 0; i < steps; ++i) {
+        const double f = static_cast<double>(i);
+        block[i * stride + 0] = 1.0 + 0.001 * f;
+        block[i * stride + 1] = 2.0 - 0.002 * f;
+        block[i * stride + 2] = std::numeric_limits<double>::quiet_NaN(); // padding, never read
+        dts[i] = 0.01 + 0.00001 * f;
+    }
+
+    // ---- Constant dt: parity with a Step() loop, stops at collapse
+    {
+        MaxCore seq = make_core();
+        MaxCore ref = make_core();
+
+        const SequenceResult r = seq.StepSequence(block.data(), steps, stride, dt);
+
+        size_t ref_committed = 0;
+        size_t ref_index = steps;
+        EventFlag ref_event = EventFlag::NORMAL;
+        for (size_t i = 0; i < steps; ++i) {
+            const EventFlag ev = ref.Step(block.data() + i * stride, 2, dt);
+            if (ev == EventFlag::ERROR) { ref_index = i; ref_event = ev; break; }
+            ref_committed += 1;
+            if (ev == EventFlag::COLLAPSE) { ref_index = i; ref_event = ev; break; }
+        }
+
+        expect_true(ref_event == EventFlag::COLLAPSE, "reference run must collapse inside the block");
+        expect_true(r.event == ref_event, "sequence event must match Step loop");
+        expect_true(r.event_index == ref_index, "sequence event_index must match Step loop");
+        expect_true(r.committed == ref_committed, "sequence committed must match Step loop");
+        expect_true(r.committed == seq.Lifecycle().step_counter, "committed must equal step_counter");
+        expect_same_core(seq, ref, "sequence state must match Step loop bitwise");
+
+        // Terminal core: short-circuit, nothing committed
+        const SequenceResult r2 = seq.StepSequence(block.data(), steps, stride, dt);
+        expect_true(r2.event == EventFlag::NORMAL, "terminal: NORMAL");
+        expect_true(r2.committed == 0u, "terminal: nothing committed");
+        expect_true(r2.event_index == steps, "terminal: no event index");
+    }
+
+    // ---- Per-row dt: parity with a Step() loop
+    {
+        MaxCore seq = make_core();
+        MaxCore ref = make_core();
+
+        const size_t short_steps = 20;
+        const SequenceResult r = seq.StepSequence(block.data(), short_steps, stride, dts.data());
+        for (size_t i = 0; i < short_steps; ++i) {
+            ref.Step(block.data() + i * stride, 2, dts[i]);
+        }
+
+        expect_true(r.event == EventFlag::NORMAL, "per-row dt: block completes");
+        expect_true(r.committed == short_steps, "per-row dt: all rows committed");
+        expect_true(r.event_index == short_steps, "per-row dt: no event index");
+        expect_same_core(seq, ref, "per-row dt state must match Step loop bitwise");
+    }
+
+    // ---- ERROR mid-block: prior rows committed, failing row not committed
+    {
+        std::vector<double> bad = block;
+        bad[10 * stride + 1] = std::numeric_limits<double>::infinity();
+
+        MaxCore seq = make_core();
+        MaxCore ref = make_core();
+        const SequenceResult r = seq.StepSequence(bad.data(), steps, stride, dt);
+        for (size_t i = 0; i < 10; ++i) ref.Step(bad.data() + i * stride, 2, dt);
+
+        expect_true(r.event == EventFlag::ERROR, "non-finite row must yield ERROR");
+        expect_true(r.event_index == 10u, "ERROR index must point at the bad row");
+        expect_true(r.committed == 10u, "rows before the bad row must be committed");
+        expect_same_core(seq, ref, "state after ERROR must equal state before the bad row");
+
+        std::vector<double> bad_dts = dts;
+        bad_dts[7] = 0.0;
+        MaxCore seq2 = make_core();
+        const SequenceResult r2 = seq2.StepSequence(block.data(), steps, stride, bad_dts.data());
+        expect_true(r2.event == EventFlag::ERROR && r2.event_index == 7u && r2.committed == 7u,
+                    "invalid per-row dt must stop at that row");
+    }
+
+    // ---- Block-level validation (no mutation)
+    {
+        MaxCore seq = make_core();
+
+        const SequenceResult a = seq.StepSequence(nullptr, steps, stride, dt);
+        expect_true(a.event == EventFlag::ERROR && a.committed == 0u, "null deltas: ERROR");
+
+        const SequenceResult b = seq.StepSequence(block.data(), steps, 1, dt);
+        expect_true(b.event == EventFlag::ERROR && b.committed == 0u, "stride < delta_dim: ERROR");
+
+        const SequenceResult c = seq.StepSequence(block.data(), steps, stride, 1000.0);
+        expect_true(c.event == EventFlag::ERROR && c.committed == 0u, "unstable dt: ERROR");
+
+        const SequenceResult d = seq.StepSequence(block.data(), steps, stride, static_cast<const double*>(nullptr));
+        expect_true(d.event == EventFlag::ERROR && d.committed == 0u, "null dts: ERROR");
+
+        const SequenceResult e = seq.StepSequence(block.data(), 0, stride, dt);
+        expect_true(e.event == EventFlag::NORMAL && e.committed == 0u, "empty block: NORMAL");
+
+        expect_true(seq.Lifecycle().step_counter == 0u, "validation failures must not mutate");
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_step_sequence\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_step_sequence: " << g_fail << " failures\n";
+    return 2;
+}
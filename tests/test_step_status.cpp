@@ -0,0 +1,204 @@
+// ==============================
+// File: tests/test_step_status.cpp
+// ==============================
+#include <cfloat>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <optional>
+#include <string>
+
+#include "maxcore/c_api.h"
+#include "maxcore/maxcore.h"
+
+static size_t g_allocs = 0;
+
+void* operator new(std::size_t n) {
+    g_allocs += 1;
+    if (void* p = std::malloc(n == 0 ? 1 : n)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+// One input per failure reason; each case starts from a fresh core.
+struct Case {
+    const char* name;
+    maxcore::StructuralState init;
+    std::optional<double> delta_max;
+    const double* delta;
+    size_t len;
+    double dt;
+    maxcore::StepStatus expected;
+};
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_step_status\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const StructuralState init{0.0, 0.0, p.kappa_max};
+    const double delta[2] = {1.0, 2.0};
+    const double bad[2] = {1.0, std::numeric_limits<double>::quiet_NaN()};
+    const double huge[2] = {1e154, 0.0};  // norm2 = 1e308 is finite, phi + alpha * norm2 is not
+
+    const Case cases[] = {
+        {"OK", init, std::nullopt, delta, 2, 0.01, StepStatus::OK},
+        {"NULL_INPUT", init, std::nullopt, nullptr, 2, 0.01, StepStatus::NULL_INPUT},
+        {"DIM_MISMATCH", init, std::nullopt, delta, 3, 0.01, StepStatus::DIM_MISMATCH},
+        {"DT_INVALID zero", init, std::nullopt, delta, 2, 0.0, StepStatus::DT_INVALID},
+        {"DT_INVALID nan", init, std::nullopt, delta, 2, std::numeric_limits<double>::quiet_NaN(), StepStatus::DT_INVALID},
+        {"DT_UNSTABLE", init, std::nullopt, delta, 2, 100.0, StepStatus::DT_UNSTABLE},
+        {"DELTA_NON_FINITE", init, std::nullopt, bad, 2, 0.01, StepStatus::DELTA_NON_FINITE},
+        {"NORM_GUARD", init, 1e200, delta, 2, 0.01, StepStatus::NORM_GUARD},  // delta_max^2 overflows
+        {"NUMERIC_FAILURE", StructuralState{DBL_MAX, 0.0, p.kappa_max}, std::nullopt, huge, 2, 0.01,
+         StepStatus::NUMERIC_FAILURE},
+    };
+
+    // ---- C++: every reason is reported, the event is unchanged, failures never commit
+    for (const Case& c : cases) {
+        MaxCore a = MaxCore::Create(p, 2, c.init, c.delta_max).value();
+        MaxCore b = a;
+
+        StepStatus status = StepStatus::OK;
+        const EventFlag eb = b.Step(c.delta, c.len, c.dt, status);
+        const EventFlag ea = a.Step(c.delta, c.len, c.dt);
+
+        const std::string msg = std::string("C++ status for ") + c.name;
+        expect_true(status == c.expected, msg.c_str());
+        expect_true(ea == eb && same_state(a.Current(), b.Current()) &&
+                    a.Lifecycle().step_counter == b.Lifecycle().step_counter,
+                    "status overload must step like Step()");
+        expect_true((status == StepStatus::OK) == (eb != EventFlag::ERROR), "OK iff the event is not ERROR");
+        expect_true(status == StepStatus::OK || b.Lifecycle().step_counter == 0u, "failures must not commit");
+
+        StepStatus ds = StepStatus::OK;
+        std::optional<DerivedFrame> d;
+        MaxCore e = MaxCore::Create(p, 2, c.init, c.delta_max).value();
+        e.StepWithDerived(c.delta, c.len, c.dt, d, ds);
+        expect_true(ds == c.expected, "StepWithDerived must report the same status");
+    }
+
+    // ---- C++: terminal short-circuit reports TERMINAL with NORMAL
+    {
+        MaxCore core = MaxCore::Create(p, 2, init).value();
+        StepStatus status = StepStatus::OK;
+        size_t guard = 0;
+        while (!core.Lifecycle().terminal && guard++ < 100000u) core.Step(delta, 2, 0.01, status);
+        expect_true(core.Lifecycle().terminal && status == StepStatus::OK, "collapse step reports OK");
+        const EventFlag ev = core.Step(delta, 2, 0.01, status);
+        expect_true(ev == EventFlag::NORMAL && status == StepStatus::TERMINAL, "terminal step reports TERMINAL");
+    }
+
+    // ---- C API: codes match the C++ enum; strings are static; last_error keeps its contract
+    {
+        const maxcore_params cp{p.alpha, p.eta, p.beta, p.gamma, p.rho, p.lambda_phi, p.lambda_m, p.kappa_max};
+        for (const Case& c : cases) {
+            const maxcore_state cs{c.init.phi, c.init.memory, c.init.kappa};
+            const double dm = c.delta_max.value_or(0.0);
+            maxcore_handle* h = maxcore_create(&cp, 2, &cs, c.delta_max ? &dm : nullptr);
+            expect_true(h != nullptr, "maxcore_create must succeed");
+            if (!h) continue;
+
+            maxcore_step(h, c.delta, c.len, c.dt);
+            const maxcore_status s = maxcore_last_status(h);
+            const std::string msg = std::string("C status for ") + c.name;
+            expect_true(static_cast<int>(s) == static_cast<int>(c.expected), msg.c_str());
+            expect_true((s == MAXCORE_STATUS_OK) == (maxcore_last_error(h)[0] == '\0'),
+                        "last_error must be empty exactly on success");
+            expect_true(s == MAXCORE_STATUS_OK || std::strcmp(maxcore_last_error(h), maxcore_status_string(s)) == 0,
+                        "last_error must be the status string");
+
+            maxcore_derived_frame f{};
+            int ok = -1;
+            maxcore_step_with_derived(h, c.delta, c.len, c.dt, &f, &ok);
+            expect_true(maxcore_last_status(h) == s || c.expected == StepStatus::OK,
+                        "maxcore_step_with_derived must set the status");
+
+            maxcore_destroy(h);
+        }
+
+        bool strings_ok = true;
+        for (int i = MAXCORE_STATUS_OK; i <= MAXCORE_STATUS_INVALID_ARGUMENT; ++i) {
+            const char* s = maxcore_status_string(static_cast<maxcore_status>(i));
+            strings_ok = strings_ok && s != nullptr && s[0] != '\0';
+        }
+        expect_true(strings_ok, "every status has a string");
+        expect_true(std::strcmp(maxcore_status_string(static_cast<maxcore_status>(42)), "unknown status") == 0,
+                    "out-of-range status must map to a fixed string");
+        expect_true(maxcore_last_status(nullptr) == MAXCORE_STATUS_INVALID_ARGUMENT, "NULL handle status");
+        expect_true(std::strcmp(maxcore_last_error(nullptr), "null handle") == 0, "NULL handle error string");
+
+        // step_many: invalid arguments, then the last row's status
+        const maxcore_state cs{init.phi, init.memory, init.kappa};
+        maxcore_handle* h = maxcore_create(&cp, 2, &cs, nullptr);
+        if (h) {
+            const double rows[4] = {1.0, 2.0, 1.0, 2.0};
+            const double dts[2] = {0.01, -1.0};
+            maxcore_event ev[2];
+            maxcore_step_many(h, rows, 2, 1, dts, ev, nullptr);
+            expect_true(maxcore_last_status(h) == MAXCORE_STATUS_INVALID_ARGUMENT, "step_many invalid arguments");
+            maxcore_step_many(h, rows, 2, 2, dts, ev, nullptr);
+            expect_true(maxcore_last_status(h) == MAXCORE_STATUS_DT_INVALID, "step_many reports the last row");
+            maxcore_step_many(h, rows, 1, 2, dts, ev, nullptr);
+            expect_true(maxcore_last_status(h) == MAXCORE_STATUS_OK, "step_many success clears the status");
+        }
+        maxcore_destroy(h);
+    }
+
+    // ---- Steady state: the error channel does not allocate
+    {
+        const maxcore_params cp{p.alpha, p.eta, p.beta, p.gamma, p.rho, p.lambda_phi, p.lambda_m, p.kappa_max};
+        const maxcore_state cs{init.phi, init.memory, init.kappa};
+        maxcore_handle* h = maxcore_create(&cp, 2, &cs, nullptr);
+        if (h) {
+            const size_t before = g_allocs;
+            for (size_t t = 0; t < 10000; ++t) {
+                maxcore_step(h, (t % 3 == 0) ? bad : delta, 2, (t % 5 == 0) ? 0.0 : 0.01);
+                (void)maxcore_last_error(h);
+                (void)maxcore_last_status(h);
+            }
+            expect_true(g_allocs == before, "maxcore_step and the error channel must not allocate");
+        }
+        maxcore_destroy(h);
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_step_status\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_step_status: " << g_fail << " failures\n";
+    return 2;
+}
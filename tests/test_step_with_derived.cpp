@@ -0,0 +1,171 @@
+// ==============================
+// File: tests/test_step_with_derived.cpp
+// ==============================
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <optional>
+
+#include "maxcore/c_api.h"
+#include "maxcore/derived.h"
+#include "maxcore/maxcore.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_frame(const maxcore::DerivedFrame& a, const maxcore::DerivedFrame& b) {
+    return same_bits(a.d_phi, b.d_phi) && same_bits(a.d_memory, b.d_memory) && same_bits(a.d_kappa, b.d_kappa) &&
+           same_bits(a.phi_rate, b.phi_rate) && same_bits(a.memory_rate, b.memory_rate) &&
+           same_bits(a.kappa_rate, b.kappa_rate) && same_bits(a.kappa_ratio, b.kappa_ratio) &&
+           same_bits(a.kappa_distance, b.kappa_distance) && same_bits(a.load_term, b.load_term) &&
+           same_bits(a.regen_term, b.regen_term) && a.step_counter == b.step_counter &&
+           a.terminal == b.terminal && a.collapse_emitted == b.collapse_emitted;
+}
+
+static bool same_frame_c(const maxcore_derived_frame& a, const maxcore_derived_frame& b) {
+    return same_bits(a.d_phi, b.d_phi) && same_bits(a.d_memory, b.d_memory) && same_bits(a.d_kappa, b.d_kappa) &&
+           same_bits(a.phi_rate, b.phi_rate) && same_bits(a.memory_rate, b.memory_rate) &&
+           same_bits(a.kappa_rate, b.kappa_rate) && same_bits(a.kappa_ratio, b.kappa_ratio) &&
+           same_bits(a.kappa_distance, b.kappa_distance) && same_bits(a.load_term, b.load_term) &&
+           same_bits(a.regen_term, b.regen_term) && a.step_counter == b.step_counter &&
+           a.terminal == b.terminal && a.collapse_emitted == b.collapse_emitted;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+// Input of step t: regular steps with ERROR cases mixed in (null, wrong length,
+// bad dt, non-finite delta, norm guard) and a collapse along the way.
+struct Input {
+    const double* delta;
+    size_t len;
+    double dt;
+};
+
+static Input input_at(size_t t) {
+    static const double delta[2] = {1.0, 2.0};
+    static const double small[2] = {0.1, 0.0};
+    static const double bad[2] = {std::numeric_limits<double>::quiet_NaN(), 0.0};
+    static const double huge[2] = {1e6, 0.0};
+    switch (t % 17) {
+        case 3:  return Input{nullptr, 2, 0.01};
+        case 5:  return Input{delta, 1, 0.01};
+        case 7:  return Input{delta, 2, 0.0};
+        case 9:  return Input{bad, 2, 0.01};
+        case 11: return Input{huge, 2, 0.01};
+        case 13: return Input{small, 2, 0.02};
+        default: return Input{delta, 2, 0.01};
+    }
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_step_with_derived\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const StructuralState init{0.0, 0.0, p.kappa_max};
+    const size_t steps = 200;  // runs past collapse into the terminal short-circuit
+
+    // ---- C++: fused call equals Step() + ComputeDerived() for every outcome
+    const std::optional<double> guards[2] = {std::nullopt, 5.0};
+    for (const std::optional<double>& dm : guards) {
+        for (ReductionMode mode : {ReductionMode::SERIAL, ReductionMode::LANES4}) {
+            MaxCore a = MaxCore::Create(p, 2, init, dm, mode).value();
+            MaxCore b = a;
+
+            bool events_ok = true;
+            bool states_ok = true;
+            bool frames_ok = true;
+            size_t collapses = 0;
+            size_t errors = 0;
+            size_t frames = 0;
+            for (size_t t = 0; t < steps; ++t) {
+                const Input in = input_at(t);
+                const EventFlag ea = a.Step(in.delta, in.len, in.dt);
+                const auto da = ComputeDerived(a.Current(), a.Previous(), a.Lifecycle(), p, in.dt);
+
+                std::optional<DerivedFrame> db = DerivedFrame{};
+                const EventFlag eb = b.StepWithDerived(in.delta, in.len, in.dt, db);
+
+                events_ok = events_ok && ea == eb;
+                states_ok = states_ok && same_state(a.Current(), b.Current()) &&
+                            same_state(a.Previous(), b.Previous()) &&
+                            a.Lifecycle().step_counter == b.Lifecycle().step_counter &&
+                            a.Lifecycle().terminal == b.Lifecycle().terminal;
+                frames_ok = frames_ok && da.has_value() == db.has_value() && (!da || same_frame(*da, *db));
+
+                collapses += (ea == EventFlag::COLLAPSE) ? 1u : 0u;
+                errors += (ea == EventFlag::ERROR) ? 1u : 0u;
+                frames += da ? 1u : 0u;
+            }
+            expect_true(collapses == 1u && errors > 0u && frames > 0u && frames < steps,
+                        "run must cover NORMAL, ERROR, COLLAPSE, terminal and missing frames");
+            expect_true(events_ok, "StepWithDerived events must equal Step()");
+            expect_true(states_ok, "StepWithDerived states must equal Step()");
+            expect_true(frames_ok, "StepWithDerived frames must equal ComputeDerived bitwise");
+        }
+    }
+
+    // ---- C API: maxcore_step_with_derived equals maxcore_step + maxcore_compute_derived
+    {
+        const maxcore_params cp{p.alpha, p.eta, p.beta, p.gamma, p.rho, p.lambda_phi, p.lambda_m, p.kappa_max};
+        const maxcore_state cs{init.phi, init.memory, init.kappa};
+        maxcore_handle* ha = maxcore_create(&cp, 2, &cs, nullptr);
+        maxcore_handle* hb = maxcore_create(&cp, 2, &cs, nullptr);
+        maxcore_handle* hc = maxcore_create(&cp, 2, &cs, nullptr);
+        expect_true(ha && hb && hc, "maxcore_create must succeed");
+
+        if (ha && hb && hc) {
+            bool ok = true;
+            for (size_t t = 0; t < steps; ++t) {
+                const Input in = input_at(t);
+                maxcore_derived_frame fa{};
+                maxcore_derived_frame fb{};
+                const maxcore_event ea = maxcore_step(ha, in.delta, in.len, in.dt);
+                const int oka = maxcore_compute_derived(ha, in.dt, &fa);
+
+                int okb = -1;
+                const maxcore_event eb = maxcore_step_with_derived(hb, in.delta, in.len, in.dt, &fb, &okb);
+                const maxcore_event ec = maxcore_step_with_derived(hc, in.delta, in.len, in.dt, nullptr, nullptr);
+
+                ok = ok && ea == eb && ea == ec && oka == okb && (oka == 0 || same_frame_c(fa, fb));
+                ok = ok && std::strcmp(maxcore_last_error(ha), maxcore_last_error(hb)) == 0;
+            }
+            expect_true(ok, "C API fused step must equal the two-call sequence");
+
+            int flag = -1;
+            maxcore_derived_frame f{};
+            expect_true(maxcore_step_with_derived(nullptr, nullptr, 0, 0.01, &f, &flag) == MAXCORE_EVENT_ERROR &&
+                        flag == 0, "null handle must return ERROR and derived_ok = 0");
+        }
+
+        maxcore_destroy(ha);
+        maxcore_destroy(hb);
+        maxcore_destroy(hc);
+    }
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_step_with_derived\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_step_with_derived: " << g_fail << " failures\n";
+    return 2;
+}
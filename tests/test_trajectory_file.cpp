@@ -0,0 +1,300 @@
+// ==============================
+// File: tests/test_trajectory_file.cpp
+// ==============================
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "maxcore/derived.h"
+#include "maxcore/lifecycle.h"
+#include "maxcore/trajectory_file.h"
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+static bool same_state(const maxcore::StructuralState& a, const maxcore::StructuralState& b) {
+    return same_bits(a.phi, b.phi) && same_bits(a.memory, b.memory) && same_bits(a.kappa, b.kappa);
+}
+
+static bool same_derived(const maxcore::DerivedFrame& a, const maxcore::DerivedFrame& b) {
+    return same_bits(a.d_phi, b.d_phi) && same_bits(a.d_memory, b.d_memory) && same_bits(a.d_kappa, b.d_kappa) &&
+           same_bits(a.phi_rate, b.phi_rate) && same_bits(a.memory_rate, b.memory_rate) &&
+           same_bits(a.kappa_rate, b.kappa_rate) && same_bits(a.kappa_ratio, b.kappa_ratio) &&
+           same_bits(a.kappa_distance, b.kappa_distance) && same_bits(a.load_term, b.load_term) &&
+           same_bits(a.regen_term, b.regen_term);
+}
+
+static std::vector<uint8_t> read_file(const std::string& path) {
+    std::vector<uint8_t> bytes;
+    if (std::FILE* f = std::fopen(path.c_str(), "rb")) {
+        uint8_t buf[4096];
+        size_t n = 0;
+        while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) bytes.insert(bytes.end(), buf, buf + n);
+        std::fclose(f);
+    }
+    return bytes;
+}
+
+static void write_file(const std::string& path, const std::vector<uint8_t>& bytes) {
+    if (std::FILE* f = std::fopen(path.c_str(), "wb")) {
+        std::fwrite(bytes.data(), 1, bytes.size(), f);
+        std::fclose(f);
+    }
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_trajectory_file\n";
+
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    const StructuralState genesis{0.0, 0.0, p.kappa_max};
+    const double delta[2] = {1.0, 2.0};
+    const double bad[2] = {std::numeric_limits<double>::quiet_NaN(), 0.0};
+    const double dt = 0.01;
+    const size_t steps = 200;  // several lifecycles, one ERROR row
+    const std::string path = "test_trajectory_file.mctraj";
+
+    // ---- Write a multi-lifecycle run with a chunk size that does not divide the row count
+    std::vector<TrajectoryRow> ref;
+    {
+        auto runner = LifecycleRunner::Create(p, 2, genesis);
+        auto w = TrajectoryFileWriter::Create(path, p, dt, 2, 7);
+        expect_true(runner.has_value() && w.has_value(), "Create must succeed");
+        if (!runner || !w) return 2;
+
+        for (size_t t = 0; t < steps; ++t) {
+            const EventFlag ev = runner->Step(t == 90 ? bad : delta, 2, dt);
+            const MaxCore& core = runner->Core();
+            ref.push_back(TrajectoryRow{runner->LifecycleId(), ev, core.Current(), core.Previous(), core.Lifecycle()});
+            expect_true(w->Append(core, ev, runner->LifecycleId()), "Append must succeed");
+            if (ev == EventFlag::COLLAPSE) runner->Genesis();
+        }
+        expect_true(w->Rows() == steps, "writer row count");
+        expect_true(w->Close(), "Close must succeed");
+        expect_true(w->Close(), "Close is idempotent");
+    }
+
+    // ---- Read it back: header, chunk layout, every column bit for bit
+    {
+        auto r = TrajectoryFileReader::Open(path);
+        expect_true(r.has_value(), "Open must succeed");
+        if (!r) return 2;
+
+        expect_true(r->Rows() == steps && r->ChunkRows() == 7u && r->DeltaDim() == 2u, "header fields");
+        expect_true(same_bits(r->Dt(), dt) && same_bits(r->Params().kappa_max, p.kappa_max) &&
+                    same_bits(r->Params().rho, p.rho), "header params");
+        expect_true(r->Chunks() == (steps + 6u) / 7u && r->ChunkSize(r->Chunks() - 1u) == steps % 7u,
+                    "chunk count and short tail chunk");
+
+        bool columns_ok = true;
+        size_t row = 0;
+        for (size_t c = 0; c < r->Chunks(); ++c) {
+            const auto lc = r->LifecycleIds(c);
+            const auto sc = r->StepCounter(c);
+            const auto ev = r->Events(c);
+            const auto phi = r->Phi(c);
+            const auto kap = r->Kappa(c);
+            const auto pm = r->PrevMemory(c);
+            columns_ok = columns_ok && reinterpret_cast<uintptr_t>(phi.first) % alignof(double) == 0u;
+            for (size_t i = 0; i < r->ChunkSize(c); ++i, ++row) {
+                const TrajectoryRow& e = ref[row];
+                columns_ok = columns_ok && lc[i] == e.lifecycle_id && sc[i] == e.lifecycle.step_counter &&
+                             ev[i] == e.event && same_bits(phi[i], e.current.phi) &&
+                             same_bits(kap[i], e.current.kappa) && same_bits(pm[i], e.previous.memory);
+            }
+        }
+        expect_true(columns_ok && row == steps, "column spans must match the run");
+
+        bool rows_ok = true;
+        bool derived_ok = true;
+        bool saw_error = false;
+        bool saw_collapse = false;
+        for (size_t i = 0; i < steps; ++i) {
+            const TrajectoryRow got = r->Row(i);
+            const TrajectoryRow& e = ref[i];
+            rows_ok = rows_ok && got.lifecycle_id == e.lifecycle_id && got.event == e.event &&
+                      same_state(got.current, e.current) && same_state(got.previous, e.previous) &&
+                      got.lifecycle.step_counter == e.lifecycle.step_counter &&
+                      got.lifecycle.terminal == e.lifecycle.terminal &&
+                      got.lifecycle.collapse_emitted == e.lifecycle.collapse_emitted;
+
+            const auto want = ComputeDerived(e.current, e.previous, e.lifecycle, p, dt);
+            const auto have = r->Derived(i);
+            derived_ok = derived_ok && want.has_value() == have.has_value() &&
+                         (!want || same_derived(*want, *have));
+
+            saw_error = saw_error || e.event == EventFlag::ERROR;
+            saw_collapse = saw_collapse || e.event == EventFlag::COLLAPSE;
+        }
+        expect_true(saw_error && saw_collapse, "run must cover ERROR and COLLAPSE rows");
+        expect_true(rows_ok, "Row() must gather the run");
+        expect_true(derived_ok, "Derived() must equal the in-memory DerivedFrame");
+
+        // Move keeps the mapping alive
+        TrajectoryFileReader moved = std::move(*r);
+        expect_true(moved.Rows() == steps && same_state(moved.Row(steps - 1u).current, ref.back().current),
+                    "moved reader must stay valid");
+    }
+
+    // ---- Empty file (header only) is valid
+    {
+        {
+            auto w = TrajectoryFileWriter::Create(path, p, dt, 2, 16);
+            expect_true(w.has_value(), "empty Create");
+        }
+        auto r = TrajectoryFileReader::Open(path);
+        expect_true(r.has_value() && r->Rows() == 0u && r->Chunks() == 0u, "empty file must open with 0 rows");
+    }
+
+    // ---- Interrupted run: the file stays readable up to its last full chunk
+    {
+        auto w = TrajectoryFileWriter::Create(path, p, dt, 2, 7);
+        for (size_t t = 0; t < 17 && w; ++t) w->Append(ref[t]);
+
+        auto r = TrajectoryFileReader::Open(path);  // writer still open, 3 rows pending
+        expect_true(r.has_value() && r->Rows() == 14u && r->Chunks() == 2u,
+                    "unclosed file must open with its flushed chunks");
+        expect_true(r && same_state(r->Row(13).current, ref[13].current), "flushed rows must read back");
+        r.reset();
+
+        expect_true(w->Close(), "Close after partial read");
+        auto closed = TrajectoryFileReader::Open(path);
+        expect_true(closed.has_value() && closed->Rows() == 17u, "Close must publish the partial chunk");
+    }
+
+    // ---- Move-assignment finalizes the file the target still had open
+    {
+        const std::string other_path = "test_trajectory_file_other.mctraj";
+        {
+            auto a = TrajectoryFileWriter::Create(path, p, dt, 2, 7);
+            auto b = TrajectoryFileWriter::Create(other_path, p, dt, 2, 7);
+            for (size_t t = 0; t < 10 && a; ++t) a->Append(ref[t]);
+            for (size_t t = 0; t < 4 && b; ++t) b->Append(ref[t]);
+
+            *a = std::move(*b);
+            auto r = TrajectoryFileReader::Open(path);
+            expect_true(r.has_value() && r->Rows() == 10u && same_state(r->Row(9).current, ref[9].current),
+                        "assigned-over writer must be finalized");
+            a->Append(ref[4]);
+        }
+        auto r = TrajectoryFileReader::Open(other_path);
+        expect_true(r.has_value() && r->Rows() == 5u, "moved-in writer must keep its rows");
+        std::remove(other_path.c_str());
+    }
+
+    // ---- Corruption and invalid inputs are rejected
+    {
+        {
+            auto w = TrajectoryFileWriter::Create(path, p, dt, 2, 7);
+            for (size_t t = 0; t < 20 && w; ++t) w->Append(ref[t]);
+        }
+        const std::vector<uint8_t> good = read_file(path);
+        expect_true(good.size() > kTrajectoryHeaderBytes, "reference file written");
+
+        std::vector<uint8_t> bytes = good;
+        bytes[0] = 'X';
+        write_file(path, bytes);
+        expect_true(!TrajectoryFileReader::Open(path), "bad magic must be rejected");
+
+        bytes = good;
+        bytes[16] ^= 0xFFu;  // version
+        write_file(path, bytes);
+        expect_true(!TrajectoryFileReader::Open(path), "bad version must be rejected");
+
+        bytes = good;
+        bytes.pop_back();
+        write_file(path, bytes);
+        expect_true(!TrajectoryFileReader::Open(path), "truncated body must be rejected");
+
+        bytes = good;
+        bytes[12u * 8u] = 0u;  // delta_dim word (low byte of 2)
+        write_file(path, bytes);
+        expect_true(!TrajectoryFileReader::Open(path), "delta_dim = 0 must be rejected");
+
+        auto patch_double = [&](size_t word, double v) {
+            bytes = good;
+            std::memcpy(bytes.data() + word * 8u, &v, sizeof(v));
+            write_file(path, bytes);
+            return TrajectoryFileReader::Open(path).has_value();
+        };
+        expect_true(!patch_double(10, -1.0), "negative kappa_max must be rejected");
+        expect_true(!patch_double(3, std::numeric_limits<double>::quiet_NaN()), "NaN param must be rejected");
+        expect_true(!patch_double(11, 0.0), "dt = 0 must be rejected");
+        expect_true(!patch_double(11, 10.0), "unstable dt must be rejected");
+
+        bytes.assign(good.begin(), good.begin() + 40);
+        write_file(path, bytes);
+        expect_true(!TrajectoryFileReader::Open(path), "short header must be rejected");
+
+        write_file(path, good);
+        expect_true(TrajectoryFileReader::Open(path).has_value(), "restored file must open again");
+    }
+
+    // ---- A chunk torn mid-flush is ignored: only the published rows are read
+    {
+        {
+            auto w = TrajectoryFileWriter::Create(path, p, dt, 2, 7);
+            for (size_t t = 0; t < 21 && w; ++t) w->Append(ref[t]);
+        }
+        const std::vector<uint8_t> full = read_file(path);
+        const size_t chunk = (full.size() - kTrajectoryHeaderBytes) / 3u;
+
+        // What a crash during the third FlushChunk leaves: header at 14 rows
+        // (written after the second chunk), third chunk cut mid-column.
+        std::vector<uint8_t> bytes(full.begin(), full.end() - static_cast<ptrdiff_t>(chunk / 2u + 3u));
+        const uint64_t published = 14u;
+        std::memcpy(bytes.data() + 15u * 8u, &published, sizeof(published));  // row count word
+        write_file(path, bytes);
+
+        auto r = TrajectoryFileReader::Open(path);
+        expect_true(r.has_value() && r->Rows() == 14u && r->Chunks() == 2u, "torn chunk must be ignored");
+        expect_true(r && same_state(r->Row(13).current, ref[13].current) &&
+                    same_state(r->Row(0).previous, ref[0].previous), "published rows must read back");
+
+        bytes.push_back(0u);
+        write_file(path, bytes);
+        expect_true(TrajectoryFileReader::Open(path).has_value(), "trailing bytes past the rows are ignored");
+
+        bytes.assign(full.begin(), full.begin() + static_cast<ptrdiff_t>(kTrajectoryHeaderBytes + 2u * chunk - 1u));
+        std::memcpy(bytes.data() + 15u * 8u, &published, sizeof(published));
+        write_file(path, bytes);
+        expect_true(!TrajectoryFileReader::Open(path), "body shorter than the published rows must be rejected");
+    }
+
+    expect_true(!TrajectoryFileReader::Open("does_not_exist.mctraj"), "missing file must be rejected");
+    expect_true(!TrajectoryFileWriter::Create(path, p, 0.0, 2), "dt = 0 must be rejected");
+    expect_true(!TrajectoryFileWriter::Create(path, p, 10.0, 2), "unstable dt must be rejected");
+    expect_true(!TrajectoryFileWriter::Create(path, p, dt, 0), "delta_dim = 0 must be rejected");
+    expect_true(!TrajectoryFileWriter::Create(path, p, dt, 2, 0), "chunk_rows = 0 must be rejected");
+
+    std::remove(path.c_str());
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_trajectory_file\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_trajectory_file: " << g_fail << " failures\n";
+    return 2;
+}
@@ -0,0 +1,174 @@
+// ==============================
+// File: tests/test_trajectory_recorder.cpp
+// ==============================
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include "maxcore/maxcore.h"
+#include "maxcore/trajectory.h"
+
+// Global allocation counter: the recording hot path must not allocate.
+static size_t g_allocs = 0;
+
+void* operator new(std::size_t n) {
+    g_allocs += 1;
+    if (void* p = std::malloc(n == 0 ? 1 : n)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+static int g_fail = 0;
+
+static void expect_true(bool cond, const char* msg) {
+    if (!cond) {
+        std::cout << "[FAIL] " << msg << "\n";
+        g_fail += 1;
+    }
+}
+
+static bool same_bits(double a, double b) {
+    uint64_t ua = 0;
+    uint64_t ub = 0;
+    std::memcpy(&ua, &a, sizeof(double));
+    std::memcpy(&ub, &b, sizeof(double));
+    return ua == ub;
+}
+
+struct Row {
+    double phi;
+    double memory;
+    double kappa;
+    maxcore::EventFlag event;
+    uint64_t step_counter;
+};
+
+static maxcore::MaxCore make_core() {
+    using namespace maxcore;
+    const ParameterSet p{1.0, 0.1, 0.5, 0.1, 0.05, 0.25, 0.25, 10.0};
+    return MaxCore::Create(p, 2, StructuralState{0.0, 0.0, p.kappa_max}).value();
+}
+
+// Every recorded row must equal the reference rows [offset, offset + Size()).
+static bool matches(const maxcore::TrajectoryRecorder& rec, const std::vector<Row>& ref, size_t offset) {
+    const auto phi = rec.Phi();
+    const auto mem = rec.Memory();
+    const auto kap = rec.Kappa();
+    const auto ev = rec.Events();
+    const auto sc = rec.StepCounter();
+    if (phi.Size() != rec.Size() || ev.Size() != rec.Size() || sc.Size() != rec.Size()) return false;
+
+    for (size_t i = 0; i < rec.Size(); ++i) {
+        const Row& r = ref[offset + i];
+        if (!same_bits(phi[i], r.phi) || !same_bits(mem[i], r.memory) || !same_bits(kap[i], r.kappa)) return false;
+        if (ev[i] != r.event || sc[i] != r.step_counter) return false;
+    }
+    return true;
+}
+
+int main() {
+    using namespace maxcore;
+
+    std::cout << "test_trajectory_recorder\n";
+
+    const double delta[2] = {1.0, 2.0};
+    const double bad[2] = {std::numeric_limits<double>::quiet_NaN(), 0.0};
+    const double dt = 0.01;
+    const size_t steps = 100;
+
+    // Reference rows from a plain Step() loop (collapse at step 38, ERROR at 50)
+    std::vector<Row> ref;
+    {
+        MaxCore core = make_core();
+        for (size_t t = 0; t < steps; ++t) {
+            const EventFlag ev = core.Step(t == 50 ? bad : delta, 2, dt);
+            ref.push_back(Row{core.Current().phi, core.Current().memory, core.Current().kappa, ev,
+                              core.Lifecycle().step_counter});
+        }
+    }
+
+    // ---- LINEAR: keeps the first rows, drops the rest
+    {
+        auto rec = TrajectoryRecorder::Create(64);
+        expect_true(rec.has_value() && rec->Mode() == RecorderMode::LINEAR, "Create must default to LINEAR");
+        if (rec) {
+            MaxCore core = make_core();
+            for (size_t t = 0; t < 40; ++t) rec->Step(core, t == 50 ? bad : delta, 2, dt);
+            expect_true(rec->Size() == 40u && rec->Phi().second_len == 0u, "partial LINEAR is one segment");
+            expect_true(matches(*rec, ref, 0), "partial LINEAR rows must match");
+
+            for (size_t t = 40; t < steps; ++t) rec->Step(core, t == 50 ? bad : delta, 2, dt);
+            expect_true(rec->Size() == 64u && rec->Total() == steps && rec->Dropped() == steps - 64u,
+                        "full LINEAR must count dropped rows");
+            expect_true(matches(*rec, ref, 0), "full LINEAR must keep the first rows");
+            expect_true(!rec->Record(core, EventFlag::NORMAL), "Record on a full LINEAR recorder returns false");
+        }
+    }
+
+    // ---- RING: keeps the last rows in two segments
+    for (size_t cap : {1u, 7u, 64u, 100u, 150u}) {
+        auto rec = TrajectoryRecorder::Create(cap, RecorderMode::RING);
+        if (!rec) {
+            expect_true(false, "RING Create must succeed");
+            continue;
+        }
+        MaxCore core = make_core();
+        bool ok = true;
+        for (size_t t = 0; t < steps; ++t) {
+            rec->Step(core, t == 50 ? bad : delta, 2, dt);
+            const size_t held = std::min(t + 1, cap);
+            ok = ok && rec->Size() == held && matches(*rec, ref, t + 1 - held);
+        }
+        expect_true(ok, "RING must hold the newest rows oldest-first after every step");
+        expect_true(rec->Dropped() == 0u && rec->Total() == steps, "RING never drops");
+    }
+
+    // ---- Clear keeps storage, restarts counts
+    {
+        auto rec = TrajectoryRecorder::Create(16, RecorderMode::RING);
+        if (rec) {
+            MaxCore core = make_core();
+            for (size_t t = 0; t < 40; ++t) rec->Step(core, delta, 2, dt);
+            rec->Clear();
+            expect_true(rec->Size() == 0u && rec->Total() == 0u && rec->Phi().Empty(), "Clear must empty the recorder");
+            expect_true(rec->Capacity() == 16u, "Clear must keep the capacity");
+        }
+    }
+
+    // ---- No heap traffic after construction
+    {
+        auto rec = TrajectoryRecorder::Create(4096, RecorderMode::RING);
+        if (rec) {
+            MaxCore core = make_core();
+            const size_t before = g_allocs;
+            for (size_t t = 0; t < 200000; ++t) {
+                if (rec->Step(core, delta, 2, dt) == EventFlag::COLLAPSE) core.Genesis(StructuralState{0.0, 0.0, 10.0});
+            }
+            const auto view = rec->Kappa();
+            (void)view;
+            expect_true(g_allocs == before, "Step/Record/views must not allocate");
+        }
+    }
+
+    expect_true(!TrajectoryRecorder::Create(0), "capacity 0 must be rejected");
+
+    if (g_fail == 0) {
+        std::cout << "[OK] test_trajectory_recorder\n";
+        return 0;
+    }
+
+    std::cout << "[FAIL] test_trajectory_recorder: " << g_fail << " failures\n";
+    return 2;
+}